@@ -146,4 +146,64 @@ void define_adaptive_stiffness(py::module_& m)
         )ipc_Qu8mg5v7",
         py::arg("mesh"), py::arg("vertices"), py::arg("collisions"),
         py::arg("vertex_masses"), py::arg("hess"), py::arg("dmin"));
+
+    m.def(
+        "semi_implicit_stiffness",
+        static_cast<Eigen::VectorXd (*)(
+            const CollisionMesh&, Eigen::ConstRef<Eigen::MatrixXd>,
+            const NormalCollisions&, Eigen::ConstRef<Eigen::VectorXd>,
+            Eigen::ConstRef<Eigen::MatrixXd>, const double)>(
+            &semi_implicit_stiffness),
+        R"ipc_Qu8mg5v7(
+        Compute the semi-implicit stiffness's for all collisions from the diagonal blocks of the elasticity hessian.
+
+        See [Ando 2024] for details.
+
+        Note:
+            The coupling between the vertices of a stencil is ignored, so the full hessian never needs to be assembled.
+
+        Parameters:
+            mesh: Collision mesh.
+            vertices: Vertex positions.
+            collisions: Normal collisions.
+            vertex_masses: Lumped vertex masses.
+            hess_diagonal_blocks: Vertex dim×dim diagonal blocks of the hessian of the elasticity energy function stacked vertically (see Potential.hessian_block_diagonal).
+            dmin: Minimum distance between elements.
+
+        Returns:
+            The semi-implicit stiffness's.
+        )ipc_Qu8mg5v7",
+        py::arg("mesh"), py::arg("vertices"), py::arg("collisions"),
+        py::arg("vertex_masses"), py::arg("hess_diagonal_blocks"),
+        py::arg("dmin"));
+
+    m.def(
+        "semi_implicit_stiffness",
+        static_cast<Eigen::VectorXd (*)(
+            const CollisionMesh&, Eigen::ConstRef<Eigen::MatrixXd>,
+            const Candidates&, Eigen::ConstRef<Eigen::VectorXd>,
+            Eigen::ConstRef<Eigen::MatrixXd>, const double)>(
+            &semi_implicit_stiffness),
+        R"ipc_Qu8mg5v7(
+        Compute the semi-implicit stiffness's for all collisions from the diagonal blocks of the elasticity hessian.
+
+        See [Ando 2024] for details.
+
+        Note:
+            The coupling between the vertices of a stencil is ignored, so the full hessian never needs to be assembled.
+
+        Parameters:
+            mesh: Collision mesh.
+            vertices: Vertex positions.
+            collisions: Collisions candidates.
+            vertex_masses: Lumped vertex masses.
+            hess_diagonal_blocks: Vertex dim×dim diagonal blocks of the hessian of the elasticity energy function stacked vertically (see Potential.hessian_block_diagonal).
+            dmin: Minimum distance between elements.
+
+        Returns:
+            The semi-implicit stiffness's.
+        )ipc_Qu8mg5v7",
+        py::arg("mesh"), py::arg("vertices"), py::arg("collisions"),
+        py::arg("vertex_masses"), py::arg("hess_diagonal_blocks"),
+        py::arg("dmin"));
 }
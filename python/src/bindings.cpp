@@ -14,6 +14,7 @@ PYBIND11_MODULE(ipctk, m)
     define_eigen_ext(m);
     define_narrow_phase_ccd(m);
     define_tight_inclusion_ccd(m);
+    define_grid_sdf(m);
 
     // adhesion
     define_adhesion(m);
@@ -37,6 +38,7 @@ PYBIND11_MODULE(ipctk, m)
     // candidates
     define_candidates(m);
     define_collision_stencil(m);
+    define_compact_candidates(m);
     define_edge_edge_candidate(m);
     define_edge_face_candidate(m);
     define_edge_vertex_candidate(m);
@@ -47,20 +49,26 @@ PYBIND11_MODULE(ipctk, m)
     // ccd
     define_ccd_aabb(m);
     define_check_initial_distance(m);
+    define_float_ccd_prefilter(m);
     define_inexact_point_edge(m);
     define_point_static_plane(m);
+    define_point_static_sdf(m);
     define_inexact_ccd(m);
     define_additive_ccd(m);
     define_nonlinear_ccd(m);
+    define_rigid_trajectory(m);
+    define_ccd_session(m);
 
     // collisions/normal
     define_distance_type(m); // define early because it is used next
+    define_weight_gradients(m);
     define_normal_collision(m);
     define_normal_collisions(m);
     define_edge_edge_normal_collision(m);
     define_edge_vertex_normal_collision(m);
     define_face_vertex_normal_collision(m);
     define_plane_vertex_normal_collision(m);
+    define_sdf_vertex_normal_collision(m);
     define_vertex_vertex_normal_collision(m);
 
     // tangent
@@ -76,6 +84,9 @@ PYBIND11_MODULE(ipctk, m)
     define_face_vertex_tangential_collision(m);
     define_vertex_vertex_tangential_collision(m);
 
+    // collisions
+    define_contact_islands(m);
+
     // distance
     define_edge_edge_mollifier(m);
     define_edge_edge_distance(m);
@@ -91,8 +102,10 @@ PYBIND11_MODULE(ipctk, m)
 
     // implicits
     define_plane_implicit(m);
+    define_sdf_implicit(m);
 
     // potentials
+    define_potential(m);
     define_normal_potential(m); // define early because it is used next
     define_barrier_potential(m);
     define_normal_adhesion_potential(m);
@@ -102,11 +115,16 @@ PYBIND11_MODULE(ipctk, m)
 
     // utils
     define_area_gradient(m);
+    define_block_sparse_matrix(m);
+    define_gradient_scatter(m);
+    define_hessian_operator(m);
+    define_hessian_pattern(m);
     define_interval(m);
     define_intersection(m);
     define_logger(m);
     define_thread_limiter(m);
     define_vertex_to_min_edge(m);
+    define_workspace(m);
     define_world_bbox_diagonal_length(m);
 
     // root
@@ -280,5 +280,8 @@ void define_broad_phase(py::module_& m)
             py::arg("dim"))
         .def_readwrite(
             "can_vertices_collide", &BroadPhase::can_vertices_collide,
-            "Function for determining if two vertices can collide.");
+            "Function for determining if two vertices can collide.")
+        .def_readwrite(
+            "workspace", &BroadPhase::workspace,
+            "Persistent buffers reused across detections (None to allocate per detection).");
 }
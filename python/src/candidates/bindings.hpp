@@ -5,6 +5,7 @@
 // candidates
 void define_candidates(py::module_& m);
 void define_collision_stencil(py::module_& m);
+void define_compact_candidates(py::module_& m);
 void define_edge_edge_candidate(py::module_& m);
 void define_edge_face_candidate(py::module_& m);
 void define_edge_vertex_candidate(py::module_& m);
@@ -48,6 +48,30 @@ void define_candidates(py::module_& m)
             py::arg("mesh"), py::arg("vertices_t0"), py::arg("vertices_t1"),
             py::arg("inflation_radius") = 0,
             py::arg("broad_phase") = make_default_broad_phase())
+        .def(
+            "build",
+            py::overload_cast<
+                const CollisionMesh&,
+                const std::vector<const NonlinearTrajectory*>&, const double,
+                std::shared_ptr<BroadPhase>, const int>(&Candidates::build),
+            R"ipc_Qu8mg5v7(
+            Initialize the set of continuous collision detection candidates along nonlinear trajectories.
+
+            Note:
+                The swept bounds of each vertex enclose its trajectory sampled at uniform times and inflated by the distance from the linearized trajectory.
+
+            Parameters:
+                mesh: The surface of the collision mesh.
+                trajectories: Trajectory of each surface vertex.
+                inflation_radius: Amount to inflate the bounding boxes.
+                broad_phase: Broad phase to use.
+                num_samples: Number of time intervals to sample each trajectory at.
+            )ipc_Qu8mg5v7",
+            py::arg("mesh"), py::arg("trajectories"),
+            py::arg("inflation_radius") = 0,
+            py::arg("broad_phase") = make_default_broad_phase(),
+            py::arg("num_samples") =
+                Candidates::DEFAULT_NUM_TRAJECTORY_SAMPLES)
         .def("__len__", &Candidates::size)
         .def("empty", &Candidates::empty)
         .def("clear", &Candidates::clear)
@@ -100,6 +124,79 @@ void define_candidates(py::module_& m)
             py::arg("mesh"), py::arg("vertices_t0"), py::arg("vertices_t1"),
             py::arg("min_distance") = 0.0,
             py::arg("narrow_phase_ccd") = DEFAULT_NARROW_PHASE_CCD)
+        .def(
+            "compute_per_candidate_toi", &Candidates::compute_per_candidate_toi,
+            R"ipc_Qu8mg5v7(
+            Computes the time of impact of every candidate.
+
+            Note:
+                Assumes the trajectory is linear.
+
+            Note:
+                Unlike compute_collision_free_stepsize(), every candidate is tested over the full interval [0, 1] (i.e., the narrow phase is not truncated at the running earliest time of impact).
+
+            Parameters:
+                mesh: The collision mesh.
+                vertices_t0: Surface vertex starting positions (rowwise). Assumed to be intersection free.
+                vertices_t1: Surface vertex ending positions (rowwise).
+                min_distance: The minimum distance allowable between any two elements.
+                narrow_phase_ccd: The narrow phase CCD algorithm to use.
+
+            Returns:
+                The time of impact of each candidate (ordered as operator[]). A value of 1.0 if the candidate does not collide.
+            )ipc_Qu8mg5v7",
+            py::arg("mesh"), py::arg("vertices_t0"), py::arg("vertices_t1"),
+            py::arg("min_distance") = 0.0,
+            py::arg("narrow_phase_ccd") = DEFAULT_NARROW_PHASE_CCD)
+        .def(
+            "compute_per_vertex_collision_free_stepsize",
+            &Candidates::compute_per_vertex_collision_free_stepsize,
+            R"ipc_Qu8mg5v7(
+            Computes the maximum collision-free step size of each vertex.
+
+            Note:
+                Assumes the trajectory is linear.
+
+            Parameters:
+                mesh: The collision mesh.
+                vertices_t0: Surface vertex starting positions (rowwise). Assumed to be intersection free.
+                vertices_t1: Surface vertex ending positions (rowwise).
+                min_distance: The minimum distance allowable between any two elements.
+                narrow_phase_ccd: The narrow phase CCD algorithm to use.
+
+            Returns:
+                The minimum time of impact over all candidates incident on each vertex. A value of 1.0 if the vertex is not involved in any collision.
+            )ipc_Qu8mg5v7",
+            py::arg("mesh"), py::arg("vertices_t0"), py::arg("vertices_t1"),
+            py::arg("min_distance") = 0.0,
+            py::arg("narrow_phase_ccd") = DEFAULT_NARROW_PHASE_CCD)
+        .def(
+            "compute_nonlinear_collision_free_stepsize",
+            &Candidates::compute_nonlinear_collision_free_stepsize,
+            R"ipc_Qu8mg5v7(
+            Computes a maximal step size that is collision free along nonlinear trajectories.
+
+            Note:
+                The candidates must be built from bounds that enclose the nonlinear trajectories.
+
+            Parameters:
+                mesh: The collision mesh.
+                trajectories: Trajectory of each surface vertex.
+                min_distance: The minimum distance allowable between any two elements.
+                tolerance: Tolerance for the linear CCD algorithm.
+                max_iterations: Maximum number of iterations for the linear CCD algorithm.
+                conservative_rescaling: Conservative rescaling of the time of impact.
+
+            Returns:
+                A step-size :math:`\in [0, 1]` that is collision free. A value of 1.0 if a full step and 0.0 is no step.
+            )ipc_Qu8mg5v7",
+            py::arg("mesh"), py::arg("trajectories"),
+            py::arg("min_distance") = 0.0,
+            py::arg("tolerance") = TightInclusionCCD::DEFAULT_TOLERANCE,
+            py::arg("max_iterations") =
+                TightInclusionCCD::DEFAULT_MAX_ITERATIONS,
+            py::arg("conservative_rescaling") =
+                TightInclusionCCD::DEFAULT_CONSERVATIVE_RESCALING)
         .def(
             "compute_noncandidate_conservative_stepsize",
             &Candidates::compute_noncandidate_conservative_stepsize,
@@ -130,6 +227,30 @@ void define_candidates(py::module_& m)
             py::arg("dhat"), py::arg("min_distance") = 0.0,
             py::arg("broad_phase") = make_default_broad_phase(),
             py::arg("narrow_phase_ccd") = DEFAULT_NARROW_PHASE_CCD)
+        .def(
+            "compute_incremental_cfl_stepsize",
+            &Candidates::compute_incremental_cfl_stepsize,
+            R"ipc_Qu8mg5v7(
+            Computes a CFL-inspired CCD maximum step size, extending the candidates where the CFL bound is too small.
+
+            Instead of falling back to a full CCD, only pairs involving vertices that move farther than :math:`\hat{d}/2` before the candidates' step size are detected (using the given broad phase) and checked. These pairs are appended to the candidates.
+
+            Note:
+                Meshes with codimensional vertices fall back to a full CCD.
+
+            Parameters:
+                mesh: The collision mesh.
+                vertices_t0: Surface vertex starting positions (rowwise).
+                vertices_t1: Surface vertex ending positions (rowwise).
+                dhat: Barrier activation distance.
+                min_distance: Minimum distance allowable between any two elements.
+                broad_phase: The broad phase used to detect the additional candidates.
+                narrow_phase_ccd: Narrow phase CCD algorithm to use.
+            )ipc_Qu8mg5v7",
+            py::arg("mesh"), py::arg("vertices_t0"), py::arg("vertices_t1"),
+            py::arg("dhat"), py::arg("min_distance") = 0.0,
+            py::arg("broad_phase") = make_default_broad_phase(),
+            py::arg("narrow_phase_ccd") = DEFAULT_NARROW_PHASE_CCD)
         .def(
             "save_obj", &Candidates::save_obj, py::arg("filename"),
             py::arg("vertices"), py::arg("edges"), py::arg("faces"))
@@ -0,0 +1,127 @@
+#include <common.hpp>
+
+#include <ipc/candidates/compact_candidates.hpp>
+
+namespace py = pybind11;
+using namespace ipc;
+
+void define_compact_candidates(py::module_& m)
+{
+    py::class_<CompactCandidates> compact_candidates(
+        m, "CompactCandidates",
+        "Contiguous plain-old-data storage of collision candidates.");
+
+    py::enum_<CompactCandidates::Type>(
+        compact_candidates, "Type", "Type of a candidate.")
+        .value("VERTEX_VERTEX", CompactCandidates::Type::VERTEX_VERTEX)
+        .value("EDGE_VERTEX", CompactCandidates::Type::EDGE_VERTEX)
+        .value("EDGE_EDGE", CompactCandidates::Type::EDGE_EDGE)
+        .value("FACE_VERTEX", CompactCandidates::Type::FACE_VERTEX)
+        .export_values();
+
+    compact_candidates.def(py::init())
+        .def(
+            py::init<const Candidates&, const CollisionMesh&>(),
+            R"ipc_Qu8mg5v7(
+            Construct a compact copy of a set of candidates.
+
+            Parameters:
+                candidates: The candidates to copy.
+                mesh: The collision mesh.
+            )ipc_Qu8mg5v7",
+            py::arg("candidates"), py::arg("mesh"))
+        .def(
+            "build", &CompactCandidates::build,
+            R"ipc_Qu8mg5v7(
+            Build a compact copy of a set of candidates.
+
+            Parameters:
+                candidates: The candidates to copy.
+                mesh: The collision mesh.
+            )ipc_Qu8mg5v7",
+            py::arg("candidates"), py::arg("mesh"))
+        .def("__len__", &CompactCandidates::size)
+        .def("empty", &CompactCandidates::empty)
+        .def("clear", &CompactCandidates::clear)
+        .def(
+            "type", &CompactCandidates::type,
+            "Get the type of the i-th candidate.", py::arg("i"))
+        .def(
+            "vertex_ids", &CompactCandidates::vertex_ids,
+            "Get the vertex ids of the i-th candidate.", py::arg("i"))
+        .def(
+            "ccd",
+            [](const CompactCandidates& self, const size_t i,
+               Eigen::ConstRef<Eigen::MatrixXd> vertices_t0,
+               Eigen::ConstRef<Eigen::MatrixXd> vertices_t1,
+               const double min_distance, const double tmax,
+               const NarrowPhaseCCD& narrow_phase_ccd) {
+                double toi;
+                bool r = self.ccd(
+                    i, vertices_t0, vertices_t1, toi, min_distance, tmax,
+                    narrow_phase_ccd);
+                return std::make_tuple(r, toi);
+            },
+            R"ipc_Qu8mg5v7(
+            Perform narrow-phase CCD on the i-th candidate.
+
+            Parameters:
+                i: Index of the candidate.
+                vertices_t0: Surface vertex starting positions (rowwise).
+                vertices_t1: Surface vertex ending positions (rowwise).
+                min_distance: Minimum separation distance between primitives.
+                tmax: Maximum time (normalized) to look for collisions. Should be in [0, 1].
+                narrow_phase_ccd: The narrow phase CCD algorithm to use.
+
+            Returns:
+                Tuple of:
+                If the candidate had a collision over the time interval.
+                Computed time of impact (normalized).
+            )ipc_Qu8mg5v7",
+            py::arg("i"), py::arg("vertices_t0"), py::arg("vertices_t1"),
+            py::arg("min_distance") = 0.0, py::arg("tmax") = 1.0,
+            py::arg("narrow_phase_ccd") = DEFAULT_NARROW_PHASE_CCD)
+        .def(
+            "estimate_ccd_cost", &CompactCandidates::estimate_ccd_cost,
+            R"ipc_Qu8mg5v7(
+            Estimate the relative cost of the narrow-phase CCD of the i-th candidate.
+
+            The cost grows with the complexity of the candidate type and with the relative displacement of its vertices compared to their initial distance.
+
+            The distance is first bounded from below by the gap between the bounding boxes of the two primitives, and only computed exactly if this bound marks the query as expensive.
+
+            Parameters:
+                i: Index of the candidate.
+                vertices_t0: Surface vertex starting positions (rowwise).
+                vertices_t1: Surface vertex ending positions (rowwise).
+                min_distance: Minimum separation distance between primitives.
+
+            Returns:
+                The estimated cost (at least one).
+            )ipc_Qu8mg5v7",
+            py::arg("i"), py::arg("vertices_t0"), py::arg("vertices_t1"),
+            py::arg("min_distance") = 0.0)
+        .def(
+            "compute_collision_free_stepsize",
+            &CompactCandidates::compute_collision_free_stepsize,
+            R"ipc_Qu8mg5v7(
+            Computes a maximal step size that is collision free using the set of collision candidates.
+
+            Note:
+                Assumes the trajectory is linear.
+
+            Parameters:
+                vertices_t0: Surface vertex starting positions (rowwise). Assumed to be intersection free.
+                vertices_t1: Surface vertex ending positions (rowwise).
+                min_distance: The minimum distance allowable between any two elements.
+                narrow_phase_ccd: The narrow phase CCD algorithm to use.
+
+            Returns:
+                A step-size :math:`\in [0, 1]` that is collision free. A value of 1.0 if a full step and 0.0 is no step.
+            )ipc_Qu8mg5v7",
+            py::arg("vertices_t0"), py::arg("vertices_t1"),
+            py::arg("min_distance") = 0.0,
+            py::arg("narrow_phase_ccd") = DEFAULT_NARROW_PHASE_CCD)
+        .def_readonly_static(
+            "EXPENSIVE_CCD_COST", &CompactCandidates::EXPENSIVE_CCD_COST);
+}
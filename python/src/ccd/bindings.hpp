@@ -5,10 +5,14 @@ namespace py = pybind11;
 
 void define_ccd_aabb(py::module_& m);
 void define_additive_ccd(py::module_& m);
+void define_ccd_session(py::module_& m);
 void define_check_initial_distance(py::module_& m);
+void define_float_ccd_prefilter(py::module_& m);
 void define_inexact_ccd(py::module_& m);
 void define_inexact_point_edge(py::module_& m);
 void define_narrow_phase_ccd(py::module_& m);
 void define_nonlinear_ccd(py::module_& m);
 void define_point_static_plane(py::module_& m);
+void define_point_static_sdf(py::module_& m);
+void define_rigid_trajectory(py::module_& m);
 void define_tight_inclusion_ccd(py::module_& m);
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include <common.hpp>
+
+#include <ipc/ccd/ccd_session.hpp>
+
+namespace py = pybind11;
+using namespace ipc;
+
+void define_ccd_session(py::module_& m)
+{
+    py::class_<CCDSession>(
+        m, "CCDSession",
+        "Stateful CCD for line searches along a fixed step direction.")
+        .def(
+            py::init<
+                const CollisionMesh&, const double, std::shared_ptr<BroadPhase>,
+                const NarrowPhaseCCD&>(),
+            R"ipc_Qu8mg5v7(
+            Construct a CCD session.
+
+            Note:
+                The mesh and narrow phase CCD must outlive the session.
+
+            Parameters:
+                mesh: The collision mesh.
+                min_distance: The minimum distance allowable between any two elements.
+                broad_phase: The broad phase method to use.
+                narrow_phase_ccd: The narrow phase CCD algorithm to use.
+            )ipc_Qu8mg5v7",
+            py::arg("mesh"), py::arg("min_distance") = 0.0,
+            py::arg("broad_phase") = make_default_broad_phase(),
+            py::arg("narrow_phase_ccd") = DEFAULT_NARROW_PHASE_CCD,
+            py::keep_alive<1, 2>(), py::keep_alive<1, 5>())
+        .def(
+            "build", &CCDSession::build,
+            R"ipc_Qu8mg5v7(
+            Run full CCD for the step and cache the earliest time of impact.
+
+            Note:
+                Assumes the trajectory is linear.
+
+            Parameters:
+                vertices_t0: Surface vertex starting positions (rowwise). Assumed to be intersection free.
+                vertices_t1: Surface vertex ending positions (rowwise).
+            )ipc_Qu8mg5v7",
+            py::arg("vertices_t0"), py::arg("vertices_t1"))
+        .def(
+            "compute_collision_free_stepsize",
+            &CCDSession::compute_collision_free_stepsize,
+            R"ipc_Qu8mg5v7(
+            Computes a maximal step size that is collision free.
+
+            If the step is a scaled version of the cached step, the result is computed from the cache. Otherwise, the session is rebuilt.
+
+            Parameters:
+                vertices_t0: Surface vertex starting positions (rowwise). Assumed to be intersection free.
+                vertices_t1: Surface vertex ending positions (rowwise).
+
+            Returns:
+                A step-size :math:`\in [0, 1]` that is collision free. A value of 1.0 if a full step and 0.0 is no step.
+            )ipc_Qu8mg5v7",
+            py::arg("vertices_t0"), py::arg("vertices_t1"))
+        .def(
+            "is_step_collision_free",
+            py::overload_cast<
+                Eigen::ConstRef<Eigen::MatrixXd>,
+                Eigen::ConstRef<Eigen::MatrixXd>>(
+                &CCDSession::is_step_collision_free),
+            R"ipc_Qu8mg5v7(
+            Determine if the step is collision free.
+
+            If the step is a scaled version of the cached step, the result is computed from the cache. Otherwise, the session is rebuilt.
+
+            Parameters:
+                vertices_t0: Surface vertex starting positions (rowwise).
+                vertices_t1: Surface vertex ending positions (rowwise).
+
+            Returns:
+                True if no collisions occur.
+            )ipc_Qu8mg5v7",
+            py::arg("vertices_t0"), py::arg("vertices_t1"))
+        .def(
+            "is_step_collision_free",
+            py::overload_cast<const double>(
+                &CCDSession::is_step_collision_free, py::const_),
+            R"ipc_Qu8mg5v7(
+            Determine if the scaled cached step :math:`x_0 \to x_0 + \alpha (x_1 - x_0)` is collision free.
+
+            Parameters:
+                alpha: Fraction of the cached step :math:`\in [0, 1]`.
+
+            Returns:
+                True if no collisions occur.
+            )ipc_Qu8mg5v7",
+            py::arg("alpha"))
+        .def_property_readonly(
+            "collision_free_stepsize", &CCDSession::collision_free_stepsize,
+            "Collision-free step size of the cached step.")
+        .def_property_readonly(
+            "candidates", &CCDSession::candidates,
+            "Candidates of the cached step.")
+        .def_property_readonly(
+            "candidate_tois", &CCDSession::candidate_tois,
+            "Time of impact of each candidate of the cached step (computed on first use).")
+        .def_property_readonly(
+            "num_builds", &CCDSession::num_builds,
+            "Number of times full CCD has been run.")
+        .def_readwrite(
+            "direction_tolerance", &CCDSession::direction_tolerance,
+            "Relative tolerance used to decide if a step is parallel to the cached step.");
+}
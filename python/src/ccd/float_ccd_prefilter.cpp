@@ -0,0 +1,59 @@
+#include <common.hpp>
+
+#include <ipc/ccd/float_ccd_prefilter.hpp>
+
+namespace py = pybind11;
+using namespace ipc;
+
+void define_float_ccd_prefilter(py::module_& m)
+{
+    m.def(
+        "edge_edge_ccd_prefilter", &edge_edge_ccd_prefilter,
+        R"ipc_Qu8mg5v7(
+        Conservative single-precision filter for edge-edge CCD.
+
+        Bounds the inclusion function of Tight Inclusion CCD over a fixed
+        number of time slabs using float32 interval arithmetic with outward
+        rounding. The filter never rejects a query that collides.
+
+        Parameters:
+            ea0_t0: The initial position of the first endpoint of the first edge.
+            ea1_t0: The initial position of the second endpoint of the first edge.
+            eb0_t0: The initial position of the first endpoint of the second edge.
+            eb1_t0: The initial position of the second endpoint of the second edge.
+            ea0_t1: The final position of the first endpoint of the first edge.
+            ea1_t1: The final position of the second endpoint of the first edge.
+            eb0_t1: The final position of the first endpoint of the second edge.
+            eb1_t1: The final position of the second endpoint of the second edge.
+            min_distance: The minimum distance between the objects.
+
+        Returns:
+            False if the edges are provably collision free, true if they may collide.
+        )ipc_Qu8mg5v7",
+        py::arg("ea0_t0"), py::arg("ea1_t0"), py::arg("eb0_t0"),
+        py::arg("eb1_t0"), py::arg("ea0_t1"), py::arg("ea1_t1"),
+        py::arg("eb0_t1"), py::arg("eb1_t1"), py::arg("min_distance") = 0.0);
+
+    m.def(
+        "point_triangle_ccd_prefilter", &point_triangle_ccd_prefilter,
+        R"ipc_Qu8mg5v7(
+        Conservative single-precision filter for point-triangle CCD.
+
+        Parameters:
+            p_t0: The initial position of the point.
+            t0_t0: The initial position of the first vertex of the triangle.
+            t1_t0: The initial position of the second vertex of the triangle.
+            t2_t0: The initial position of the third vertex of the triangle.
+            p_t1: The final position of the point.
+            t0_t1: The final position of the first vertex of the triangle.
+            t1_t1: The final position of the second vertex of the triangle.
+            t2_t1: The final position of the third vertex of the triangle.
+            min_distance: The minimum distance between the objects.
+
+        Returns:
+            False if the point and triangle are provably collision free, true if they may collide.
+        )ipc_Qu8mg5v7",
+        py::arg("p_t0"), py::arg("t0_t0"), py::arg("t1_t0"), py::arg("t2_t0"),
+        py::arg("p_t1"), py::arg("t0_t1"), py::arg("t1_t1"), py::arg("t2_t1"),
+        py::arg("min_distance") = 0.0);
+}
@@ -0,0 +1,47 @@
+#include <common.hpp>
+
+#include <ipc/ccd/point_static_sdf.hpp>
+#include <ipc/implicits/sdf.hpp>
+
+namespace py = pybind11;
+using namespace ipc;
+
+void define_point_static_sdf(py::module_& m)
+{
+    m.def(
+        "point_static_sdf_ccd",
+        [](Eigen::ConstRef<VectorMax3d> p_t0, Eigen::ConstRef<VectorMax3d> p_t1,
+           const GridSDF& sdf, const double min_distance, const double tmax,
+           const double conservative_rescaling, const long max_iterations) {
+            double toi;
+            bool r = point_static_sdf_ccd(
+                p_t0, p_t1, sdf, toi, min_distance, tmax,
+                conservative_rescaling, max_iterations);
+            return std::make_tuple(r, toi);
+        },
+        R"ipc_Qu8mg5v7(
+        Computes the time of impact between a point and a static signed distance field using conservative advancement.
+
+        Note:
+            The SDF's Lipschitz constant bounds how fast the distance can decrease along the trajectory, so each advancement step is guaranteed to be collision free.
+
+        Parameters:
+            p_t0: The initial position of the point.
+            p_t1: The final position of the point.
+            sdf: The static signed distance field.
+            min_distance: Minimum separation distance between the point and the SDF's zero level set.
+            tmax: Maximum time (normalized) to look for collisions. Should be in [0, 1].
+            conservative_rescaling: Conservative rescaling of the distance to the SDF at the time of impact.
+            max_iterations: Maximum number of advancement steps (a negative value means unlimited). If reached, the current (collision free) time is returned as the time of impact.
+
+        Returns:
+            Tuple of:
+            True if a collision was detected, false otherwise.
+            Output time of impact
+        )ipc_Qu8mg5v7",
+        py::arg("p_t0"), py::arg("p_t1"), py::arg("sdf"),
+        py::arg("min_distance") = 0.0, py::arg("tmax") = 1.0,
+        py::arg("conservative_rescaling") =
+            TightInclusionCCD::DEFAULT_CONSERVATIVE_RESCALING,
+        py::arg("max_iterations") = TightInclusionCCD::DEFAULT_MAX_ITERATIONS);
+}
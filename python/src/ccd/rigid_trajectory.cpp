@@ -0,0 +1,150 @@
+#include <common.hpp>
+
+#include <ipc/ccd/rigid_trajectory.hpp>
+
+namespace py = pybind11;
+using namespace ipc;
+
+void define_rigid_trajectory(py::module_& m)
+{
+    py::class_<RigidBodyMotion, std::shared_ptr<RigidBodyMotion>>(
+        m, "RigidBodyMotion",
+        R"ipc_Qu8mg5v7(
+        Motion of a rigid body with constant linear and angular velocity.
+
+        The origin of the body frame is the body's center of rotation. A body
+        can be attached to a parent body by a revolute joint (at the origin of
+        its frame) to form an articulated chain.
+        )ipc_Qu8mg5v7")
+        .def(
+            py::init<
+                Eigen::ConstRef<VectorMax3d>, Eigen::ConstRef<VectorMax3d>,
+                Eigen::ConstRef<MatrixMax3d>, Eigen::ConstRef<VectorMax3d>>(),
+            R"ipc_Qu8mg5v7(
+            Construct the motion of a free rigid body.
+
+            Parameters:
+                center_t0: Position of the center of rotation at t=0.
+                center_t1: Position of the center of rotation at t=1.
+                rotation_t0: Orientation of the body at t=0.
+                angular_velocity: Angular velocity in world coordinates (size 1 in 2D and 3 in 3D).
+            )ipc_Qu8mg5v7",
+            py::arg("center_t0"), py::arg("center_t1"), py::arg("rotation_t0"),
+            py::arg("angular_velocity"))
+        .def(
+            py::init([](std::shared_ptr<RigidBodyMotion> parent,
+                        Eigen::ConstRef<VectorMax3d> joint,
+                        Eigen::ConstRef<MatrixMax3d> rotation_t0,
+                        Eigen::ConstRef<VectorMax3d> angular_velocity) {
+                return std::make_shared<RigidBodyMotion>(
+                    parent, joint, rotation_t0, angular_velocity);
+            }),
+            R"ipc_Qu8mg5v7(
+            Construct the motion of a body attached to a parent body by a revolute joint.
+
+            Parameters:
+                parent: Motion of the parent body.
+                joint: Position of the joint in the parent's body frame.
+                rotation_t0: Orientation of the body relative to the parent at t=0.
+                angular_velocity: Angular velocity relative to the parent in the parent's body frame (size 1 in 2D and 3 in 3D).
+            )ipc_Qu8mg5v7",
+            py::arg("parent"), py::arg("joint"), py::arg("rotation_t0"),
+            py::arg("angular_velocity"))
+        .def_property_readonly(
+            "dim", &RigidBodyMotion::dim, "Dimension of the body.")
+        .def(
+            "__call__", &RigidBodyMotion::operator(),
+            R"ipc_Qu8mg5v7(
+            Compute the world position of a point fixed to the body.
+
+            Parameters:
+                x: Position of the point in the body frame.
+                t: Time.
+
+            Returns:
+                The world position of the point at time t.
+            )ipc_Qu8mg5v7",
+            py::arg("x"), py::arg("t"))
+        .def(
+            "rotation", &RigidBodyMotion::rotation,
+            R"ipc_Qu8mg5v7(
+            Compute the orientation of the body relative to its parent.
+
+            Parameters:
+                t: Time.
+
+            Returns:
+                The rotation from the body frame to the parent frame (or world frame if the body has no parent).
+            )ipc_Qu8mg5v7",
+            py::arg("t"))
+        .def(
+            "max_acceleration", &RigidBodyMotion::max_acceleration,
+            R"ipc_Qu8mg5v7(
+            Compute an upper bound on the acceleration of a point fixed to the body.
+
+            Parameters:
+                x: Position of the point in the body frame.
+
+            Returns:
+                An upper bound on the acceleration for all t.
+            )ipc_Qu8mg5v7",
+            py::arg("x"))
+        .def_property_readonly(
+            "parent",
+            [](const RigidBodyMotion& self) {
+                return std::const_pointer_cast<RigidBodyMotion>(self.parent());
+            },
+            "Motion of the parent body (None if the body is free).");
+
+    py::class_<RigidTrajectory, NonlinearTrajectory>(
+        m, "RigidTrajectory",
+        R"ipc_Qu8mg5v7(
+        Trajectory of a point fixed to a rigid (or articulated) body.
+
+        The deviation from linear motion is bounded in closed form by the
+        maximum acceleration of the point times (t1 - t0)² / 8.
+        )ipc_Qu8mg5v7")
+        .def(
+            py::init([](std::shared_ptr<RigidBodyMotion> body,
+                        Eigen::ConstRef<VectorMax3d> point) {
+                return std::make_unique<RigidTrajectory>(body, point);
+            }),
+            R"ipc_Qu8mg5v7(
+            Construct the trajectory of a point fixed to a body.
+
+            Parameters:
+                body: Motion of the body.
+                point: Position of the point in the body frame.
+            )ipc_Qu8mg5v7",
+            py::arg("body"), py::arg("point"))
+        .def_property_readonly(
+            "body",
+            [](const RigidTrajectory& self) {
+                return std::const_pointer_cast<RigidBodyMotion>(self.body());
+            },
+            "Motion of the body.")
+        .def_property_readonly(
+            "point", &RigidTrajectory::point,
+            "Position of the point in the body frame.");
+
+    m.def(
+        "build_rigid_trajectories",
+        [](const std::vector<std::shared_ptr<RigidBodyMotion>>& bodies,
+           Eigen::ConstRef<Eigen::VectorXi> body_ids,
+           Eigen::ConstRef<Eigen::MatrixXd> points) {
+            return build_rigid_trajectories(
+                { bodies.begin(), bodies.end() }, body_ids, points);
+        },
+        R"ipc_Qu8mg5v7(
+        Build the trajectories of the vertices of a set of bodies.
+
+        Parameters:
+            bodies: Motion of each body.
+            body_ids: Body of each vertex.
+            points: Position of each vertex in its body's frame (rowwise).
+
+        Returns:
+            The trajectory of each vertex.
+        )ipc_Qu8mg5v7",
+        py::arg("bodies"), py::arg("body_ids"), py::arg("points"));
+}
@@ -206,5 +206,72 @@ a minimum separation.
         .def_readwrite(
             "conservative_rescaling",
             &TightInclusionCCD::conservative_rescaling,
-            "Conservative rescaling of the time of impact.");
+            "Conservative rescaling of the time of impact.")
+        .def_readwrite(
+            "initial_max_iterations",
+            &TightInclusionCCD::initial_max_iterations,
+            R"ipc_Qu8mg5v7(
+            Iteration budget of the first tier (0 disables tiering).
+
+            When 0 < initial_max_iterations < max_iterations, every query is
+            first run with this smaller budget. Queries that exhaust the budget
+            (or would need the small time-of-impact fallback) are left
+            undecided and escalated to max_iterations.
+            )ipc_Qu8mg5v7")
+        .def_readwrite(
+            "use_float_prefilter", &TightInclusionCCD::use_float_prefilter,
+            R"ipc_Qu8mg5v7(
+            Run a conservative single-precision filter before the solver.
+
+            Queries that are provably collision free in float32 with outward
+            rounding are discarded without calling Tight Inclusion.
+            )ipc_Qu8mg5v7")
+        .def_property_readonly(
+            "statistics", &TightInclusionCCD::statistics,
+            py::return_value_policy::reference_internal,
+            "Counters of the work done by the solver.")
+        .def(
+            "reset_statistics", &TightInclusionCCD::reset_statistics,
+            "Reset the counters of the work done by the solver.");
+
+    py::class_<TightInclusionCCD::Statistics>(
+        m.attr("TightInclusionCCD"), "Statistics",
+        "Counters of the work done by the solver.")
+        .def_property_readonly(
+            "num_queries",
+            [](const TightInclusionCCD::Statistics& self) -> size_t {
+                return self.num_queries;
+            },
+            "Number of queries that reached the solver.")
+        .def_property_readonly(
+            "num_first_tier_queries",
+            [](const TightInclusionCCD::Statistics& self) -> size_t {
+                return self.num_first_tier_queries;
+            },
+            "Number of queries run with the first-tier iteration budget.")
+        .def_property_readonly(
+            "num_exhausted",
+            [](const TightInclusionCCD::Statistics& self) -> size_t {
+                return self.num_exhausted;
+            },
+            "Number of solver calls that exhausted their iteration budget.")
+        .def_property_readonly(
+            "total_exhausted_budget",
+            [](const TightInclusionCCD::Statistics& self) -> size_t {
+                return self.total_exhausted_budget;
+            },
+            "Sum of the iteration budgets of the solver calls that exhausted "
+            "them.")
+        .def_property_readonly(
+            "num_fallbacks",
+            [](const TightInclusionCCD::Statistics& self) -> size_t {
+                return self.num_fallbacks;
+            },
+            "Number of small time-of-impact fallbacks.")
+        .def_property_readonly(
+            "num_prefiltered",
+            [](const TightInclusionCCD::Statistics& self) -> size_t {
+                return self.num_prefiltered;
+            },
+            "Number of solver calls skipped by the float prefilter.");
 }
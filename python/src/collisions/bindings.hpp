@@ -1,2 +1,10 @@
+#pragma once
+
 #include <collisions/normal/bindings.hpp>
-#include <collisions/tangential/bindings.hpp>
\ No newline at end of file
+#include <collisions/tangential/bindings.hpp>
+
+#include <pybind11/pybind11.h>
+namespace py = pybind11;
+
+void define_contact_islands(py::module_& m);
+void define_weight_gradients(py::module_& m);
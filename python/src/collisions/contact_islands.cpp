@@ -0,0 +1,69 @@
+#include <common.hpp>
+
+#include <ipc/candidates/candidates.hpp>
+#include <ipc/collisions/contact_islands.hpp>
+#include <ipc/collisions/normal/normal_collisions.hpp>
+#include <ipc/collisions/tangential/tangential_collisions.hpp>
+
+namespace py = pybind11;
+using namespace ipc;
+
+void define_contact_islands(py::module_& m)
+{
+    py::class_<ContactIslands>(
+        m, "ContactIslands",
+        "Decomposition of the contact graph into independent islands.")
+        .def(py::init())
+        .def(
+            "build", &ContactIslands::build<Candidates>,
+            R"ipc_Qu8mg5v7(
+            Build the islands from a set of collision stencils.
+
+            Parameters:
+                mesh: The collision mesh.
+                stencils: Collision stencils connecting the vertices.
+            )ipc_Qu8mg5v7",
+            py::arg("mesh"), py::arg("stencils"))
+        .def(
+            "build", &ContactIslands::build<NormalCollisions>,
+            R"ipc_Qu8mg5v7(
+            Build the islands from a set of collision stencils.
+
+            Parameters:
+                mesh: The collision mesh.
+                stencils: Collision stencils connecting the vertices.
+            )ipc_Qu8mg5v7",
+            py::arg("mesh"), py::arg("stencils"))
+        .def(
+            "build", &ContactIslands::build<TangentialCollisions>,
+            R"ipc_Qu8mg5v7(
+            Build the islands from a set of collision stencils.
+
+            Parameters:
+                mesh: The collision mesh.
+                stencils: Collision stencils connecting the vertices.
+            )ipc_Qu8mg5v7",
+            py::arg("mesh"), py::arg("stencils"))
+        .def("clear", &ContactIslands::clear, "Clear the islands.")
+        .def_property_readonly(
+            "num_islands", &ContactIslands::num_islands,
+            "Number of islands.")
+        .def_property_readonly(
+            "vertex_island_ids", &ContactIslands::vertex_island_ids,
+            "Island id of each vertex.")
+        .def_property_readonly(
+            "stencil_island_ids", &ContactIslands::stencil_island_ids,
+            "Island id of each stencil.")
+        .def(
+            "stencil_ids", &ContactIslands::stencil_ids,
+            R"ipc_Qu8mg5v7(
+            Get the indices of the stencils in an island.
+
+            Parameters:
+                island_id: The island id.
+
+            Returns:
+                Indices into the stencils used to build the islands.
+            )ipc_Qu8mg5v7",
+            py::arg("island_id"));
+}
@@ -9,4 +9,5 @@ void define_edge_edge_normal_collision(py::module_& m);
 void define_edge_vertex_normal_collision(py::module_& m);
 void define_face_vertex_normal_collision(py::module_& m);
 void define_plane_vertex_normal_collision(py::module_& m);
+void define_sdf_vertex_normal_collision(py::module_& m);
 void define_vertex_vertex_normal_collision(py::module_& m);
\ No newline at end of file
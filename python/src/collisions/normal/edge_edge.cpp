@@ -21,14 +21,12 @@ void define_edge_edge_normal_collision(py::module_& m)
                 const EdgeEdgeDistanceType>(),
             py::arg("candidate"), py::arg("eps_x"),
             py::arg("dtype") = EdgeEdgeDistanceType::AUTO)
-        // .def(
-        //     py::init<
-        //         const long, const long, const double, const double,
-        //         const Eigen::SparseVector<double>&,
-        //         const EdgeEdgeDistanceType>(),
-        //     py::arg("edge0_id"), py::arg("edge1_id"), py::arg("eps_x"),
-        //     py::arg("weight"), py::arg("weight_gradient"),
-        //     py::arg("dtype") = EdgeEdgeDistanceType::AUTO)
+        .def(
+            py::init<
+                const long, const long, const double, const double,
+                const EdgeEdgeDistanceType>(),
+            py::arg("edge0_id"), py::arg("edge1_id"), py::arg("eps_x"),
+            py::arg("weight"), py::arg("dtype") = EdgeEdgeDistanceType::AUTO)
         .def("__eq__", &EdgeEdgeNormalCollision::operator==, py::arg("other"))
         .def("__ne__", &EdgeEdgeNormalCollision::operator!=, py::arg("other"))
         .def("__lt__", &EdgeEdgeNormalCollision::operator<, py::arg("other"))
@@ -142,16 +142,5 @@ void define_normal_collision(py::module_& m)
             "dmin", &NormalCollision::dmin, "The minimum separation distance.")
         .def_readwrite(
             "weight", &NormalCollision::weight,
-            "The term's weight (e.g., collision area)")
-        .def_property(
-            "weight_gradient",
-            [](const NormalCollision& self) -> Eigen::SparseMatrix<double> {
-                return self.weight_gradient;
-            },
-            [](NormalCollision& self,
-               const Eigen::SparseMatrix<double>& weight_gradient) {
-                assert_is_sparse_vector(weight_gradient, "weight_gradient");
-                self.weight_gradient = weight_gradient;
-            },
-            "The gradient of the term's weight wrt the rest positions.");
+            "The term's weight (e.g., collision area)");
 }
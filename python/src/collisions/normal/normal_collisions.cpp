@@ -46,6 +46,27 @@ void define_normal_collisions(py::module_& m)
             )ipc_Qu8mg5v7",
             py::arg("candidates"), py::arg("mesh"), py::arg("vertices"),
             py::arg("dhat"), py::arg("dmin") = 0)
+        .def(
+            "update", &NormalCollisions::update,
+            R"ipc_Qu8mg5v7(
+            Update the set of collisions for new vertex positions without rebuilding it from scratch.
+
+            The candidates, activation distance, and minimum distance of the last build are reused. Candidates that provably remain inactive are skipped, and only the remaining ones are re-tested. If no candidate changed its activity or closest pair, the existing collisions are kept along with their weights. Otherwise, the collisions are rebuilt from the active candidates only.
+
+            Note:
+                Updates must be enabled (see enable_updates) before the last build.
+
+            Note:
+                Plane-vertex and SDF-vertex collisions are left unchanged.
+
+            Warning:
+                The candidates of the last build must still contain every pair closer than dhat + dmin.
+
+            Parameters:
+                mesh: The collision mesh.
+                vertices: Vertices of the collision mesh.
+            )ipc_Qu8mg5v7",
+            py::arg("mesh"), py::arg("vertices"))
         .def(
             "compute_minimum_distance",
             &NormalCollisions::compute_minimum_distance,
@@ -142,6 +163,18 @@ void define_normal_collisions(py::module_& m)
                 If the collision at i is an plane-vertex collision.
             )ipc_Qu8mg5v7",
             py::arg("i"))
+        .def(
+            "is_sdf_vertex", &NormalCollisions::is_sdf_vertex,
+            R"ipc_Qu8mg5v7(
+            Get if the collision at i is an SDF-vertex collision.
+
+            Parameters:
+                i: The index of the collision.
+
+            Returns:
+                If the collision at i is an SDF-vertex collision.
+            )ipc_Qu8mg5v7",
+            py::arg("i"))
         .def(
             "__str__", &NormalCollisions::to_string, py::arg("mesh"),
             py::arg("vertices"))
@@ -159,9 +192,25 @@ void define_normal_collisions(py::module_& m)
             &NormalCollisions::enable_shape_derivatives,
             &NormalCollisions::set_enable_shape_derivatives,
             "If the NormalCollisions are using the convergent formulation.")
+        .def_property(
+            "enable_updates", &NormalCollisions::enable_updates,
+            &NormalCollisions::set_enable_updates,
+            "If the NormalCollisions keep their candidates for update().")
+        .def_property(
+            "workspace", &NormalCollisions::workspace,
+            &NormalCollisions::set_workspace,
+            "Persistent buffers reused across builds (None to allocate per build).")
         .def_readwrite("vv_collisions", &NormalCollisions::vv_collisions)
         .def_readwrite("ev_collisions", &NormalCollisions::ev_collisions)
         .def_readwrite("ee_collisions", &NormalCollisions::ee_collisions)
         .def_readwrite("fv_collisions", &NormalCollisions::fv_collisions)
-        .def_readwrite("pv_collisions", &NormalCollisions::pv_collisions);
+        .def_readwrite("pv_collisions", &NormalCollisions::pv_collisions)
+        .def_readwrite("sv_collisions", &NormalCollisions::sv_collisions)
+        .def_readwrite(
+            "weight_gradients", &NormalCollisions::weight_gradients,
+            R"ipc_Qu8mg5v7(
+            Gradients of the collision weights w.r.t. the rest positions.
+
+            Row i corresponds to the i-th collision. It is only filled by build() if shape derivatives are enabled, and it has no rows for plane-vertex and SDF-vertex collisions.
+            )ipc_Qu8mg5v7");
 }
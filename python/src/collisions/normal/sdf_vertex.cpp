@@ -0,0 +1,28 @@
+#include <common.hpp>
+
+#include <ipc/collisions/normal/sdf_vertex.hpp>
+#include <ipc/implicits/sdf.hpp>
+
+namespace py = pybind11;
+using namespace ipc;
+
+void define_sdf_vertex_normal_collision(py::module_& m)
+{
+    py::class_<SDFVertexNormalCollision, NormalCollision>(
+        m, "SDFVertexNormalCollision")
+        .def(
+            py::init([](std::shared_ptr<GridSDF> sdf, const long vertex_id) {
+                return std::make_unique<SDFVertexNormalCollision>(
+                    sdf, vertex_id);
+            }),
+            py::arg("sdf"), py::arg("vertex_id"))
+        .def_property_readonly(
+            "sdf",
+            [](const SDFVertexNormalCollision& self) {
+                return std::const_pointer_cast<GridSDF>(self.sdf);
+            },
+            "The signed distance field.")
+        .def_readwrite(
+            "vertex_id", &SDFVertexNormalCollision::vertex_id,
+            "The vertex's id.");
+}
@@ -13,11 +13,8 @@ void define_vertex_vertex_normal_collision(py::module_& m)
         .def(
             py::init<long, long>(), "", py::arg("vertex0_id"),
             py::arg("vertex1_id"))
-        .def(py::init<const VertexVertexCandidate&>(), py::arg("vv_candidate"));
-    // .def(
-    //     py::init<
-    //         const long, const long, const double,
-    //         const Eigen::SparseVector<double>&>(),
-    //     py::arg("vertex0_id"), py::arg("vertex1_id"), py::arg("weight"),
-    //     py::arg("weight_gradient"));
+        .def(py::init<const VertexVertexCandidate&>(), py::arg("vv_candidate"))
+        .def(
+            py::init<const long, const long, const double>(),
+            py::arg("vertex0_id"), py::arg("vertex1_id"), py::arg("weight"));
 }
@@ -16,5 +16,14 @@ void define_face_vertex_tangential_collision(py::module_& m)
                 const FaceVertexNormalCollision&, Eigen::ConstRef<VectorMax12d>,
                 const NormalPotential&, const double>(),
             py::arg("collision"), py::arg("positions"),
-            py::arg("normal_potential"), py::arg("normal_stiffness"));
+            py::arg("normal_potential"), py::arg("normal_stiffness"))
+        .def_readwrite(
+            "dtype", &FaceVertexTangentialCollision::dtype,
+            R"ipc_Qu8mg5v7(
+            Cached distance type.
+
+            Copied from the normal collision so the distance is not
+            reclassified in every evaluation (AUTO if the collision was not
+            built from one).
+            )ipc_Qu8mg5v7");
 }
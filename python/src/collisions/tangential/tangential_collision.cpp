@@ -126,17 +126,6 @@ void define_tangential_collision(py::module_& m)
             "mu", &TangentialCollision::mu,
             "Ratio between normal and tangential forces (e.g., friction coefficient)")
         .def_readwrite("weight", &TangentialCollision::weight, "Weight")
-        .def_property(
-            "weight_gradient",
-            [](const TangentialCollision& self) -> Eigen::SparseMatrix<double> {
-                return self.weight_gradient;
-            },
-            [](TangentialCollision& self,
-               const Eigen::SparseMatrix<double>& weight_gradient) {
-                assert_is_sparse_vector(weight_gradient, "weight_gradient");
-                self.weight_gradient = weight_gradient;
-            },
-            "Gradient of weight with respect to all DOF")
         .def_readwrite(
             "closest_point", &TangentialCollision::closest_point,
             "Barycentric coordinates of the closest point(s)")
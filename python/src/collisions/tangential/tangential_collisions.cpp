@@ -75,5 +75,12 @@ void define_tangential_collisions(py::module_& m)
         .def_readwrite("vv_collisions", &TangentialCollisions::vv_collisions)
         .def_readwrite("ev_collisions", &TangentialCollisions::ev_collisions)
         .def_readwrite("ee_collisions", &TangentialCollisions::ee_collisions)
-        .def_readwrite("fv_collisions", &TangentialCollisions::fv_collisions);
+        .def_readwrite("fv_collisions", &TangentialCollisions::fv_collisions)
+        .def_readwrite(
+            "weight_gradients", &TangentialCollisions::weight_gradients,
+            R"ipc_Qu8mg5v7(
+            Gradients of the collision weights w.r.t. the rest positions.
+
+            Row i corresponds to the i-th collision. It is copied from the normal collisions by build() if they have weight gradients.
+            )ipc_Qu8mg5v7");
 }
@@ -0,0 +1,78 @@
+#include <common.hpp>
+
+#include <ipc/collisions/weight_gradients.hpp>
+
+namespace py = pybind11;
+using namespace ipc;
+
+void define_weight_gradients(py::module_& m)
+{
+    py::class_<WeightGradients>(
+        m, "WeightGradients",
+        R"ipc_Qu8mg5v7(
+        Gradients of collision weights w.r.t. the rest positions stored in compressed sparse row (CSR) form.
+
+        Row i is the gradient of the weight of the i-th collision of the owning collection.
+        )ipc_Qu8mg5v7")
+        .def(py::init())
+        .def(
+            "reset", &WeightGradients::reset,
+            R"ipc_Qu8mg5v7(
+            Remove all rows and set the length of the gradients.
+
+            Parameters:
+                ndof: Length of the gradients (i.e., the number of rest position degrees of freedom).
+            )ipc_Qu8mg5v7",
+            py::arg("ndof"))
+        .def(
+            "clear", &WeightGradients::clear,
+            "Remove all rows (the length of the gradients is kept).")
+        .def("__len__", &WeightGradients::size, "Get the number of rows.")
+        .def("empty", &WeightGradients::empty, "Get if there are no rows.")
+        .def("ndof", &WeightGradients::ndof, "Get the length of the gradients.")
+        .def(
+            "nonZeros", &WeightGradients::nonZeros,
+            "Get the total number of stored non-zeros.")
+        .def(
+            "push_back",
+            [](WeightGradients& self,
+               const Eigen::SparseMatrix<double>& weight_gradient) {
+                assert_is_sparse_vector(weight_gradient, "weight_gradient");
+                self.push_back(Eigen::SparseVector<double>(weight_gradient));
+            },
+            R"ipc_Qu8mg5v7(
+            Append a row.
+
+            Parameters:
+                weight_gradient: Gradient of the weight (of length ndof()).
+            )ipc_Qu8mg5v7",
+            py::arg("weight_gradient"))
+        .def(
+            "append_zeros", &WeightGradients::append_zeros,
+            R"ipc_Qu8mg5v7(
+            Append rows of zeros.
+
+            Parameters:
+                n: Number of rows to append.
+            )ipc_Qu8mg5v7",
+            py::arg("n"))
+        .def(
+            "__getitem__",
+            [](const WeightGradients& self,
+               const size_t i) -> Eigen::SparseMatrix<double> {
+                if (i >= self.size()) {
+                    throw py::index_error();
+                }
+                return self[i];
+            },
+            R"ipc_Qu8mg5v7(
+            Materialize a row as a sparse vector.
+
+            Parameters:
+                i: Index of the row.
+
+            Returns:
+                The gradient of the i-th weight.
+            )ipc_Qu8mg5v7",
+            py::arg("i"));
+}
@@ -0,0 +1,295 @@
+#include <common.hpp>
+
+#include <ipc/implicits/sdf.hpp>
+
+namespace py = pybind11;
+using namespace ipc;
+
+void define_grid_sdf(py::module_& m)
+{
+    py::class_<GridSDF, std::shared_ptr<GridSDF>>(
+        m, "GridSDF",
+        R"ipc_Qu8mg5v7(
+        A static signed distance field (SDF) sampled on a regular grid.
+
+        The field is interpolated bilinearly (2D) or trilinearly (3D) between the samples. Outside the grid, the value at the closest point of the grid is extended by the distance to the grid, so the field is defined everywhere. The grid should therefore enclose the collider with a margin of at least the barrier's activation distance.
+
+        Note:
+            The interpolated field is only C⁰ across cell boundaries, so the distance Hessian is piecewise (i.e., it is the Hessian of the cell containing the query point).
+        )ipc_Qu8mg5v7")
+        .def(
+            py::init<
+                Eigen::ConstRef<VectorMax3d>, const double,
+                Eigen::ConstRef<VectorMax3i>,
+                Eigen::ConstRef<Eigen::VectorXd>>(),
+            R"ipc_Qu8mg5v7(
+            Construct a grid SDF from its samples.
+
+            Parameters:
+                origin: Position of the first sample (i.e., the minimum corner of the grid).
+                spacing: Distance between adjacent samples along every axis.
+                resolution: Number of samples along each axis (at least two).
+                samples: Signed distances at the grid nodes ordered with the first axis varying fastest (i.e., node (i, j, k) is at i + nx * (j + ny * k)).
+            )ipc_Qu8mg5v7",
+            py::arg("origin"), py::arg("spacing"), py::arg("resolution"),
+            py::arg("samples"))
+        .def_property_readonly(
+            "dim", &GridSDF::dim, "Dimension of the grid.")
+        .def_property_readonly(
+            "origin", &GridSDF::origin, "Position of the first sample.")
+        .def_property_readonly(
+            "spacing", &GridSDF::spacing,
+            "Distance between adjacent samples.")
+        .def_property_readonly(
+            "resolution", &GridSDF::resolution,
+            "Number of samples along each axis.")
+        .def_property_readonly(
+            "samples", &GridSDF::samples,
+            "Signed distances at the grid nodes.")
+        .def_property_readonly(
+            "max_corner", &GridSDF::max_corner,
+            "Position of the last sample (i.e., the maximum corner of the "
+            "grid).")
+        .def(
+            "contains", &GridSDF::contains,
+            R"ipc_Qu8mg5v7(
+            Determine if a point is inside the grid.
+
+            Parameters:
+                point: Point to test.
+
+            Returns:
+                True if the point is inside the grid (or on its boundary).
+            )ipc_Qu8mg5v7",
+            py::arg("point"))
+        .def(
+            "lipschitz_constant", &GridSDF::lipschitz_constant,
+            R"ipc_Qu8mg5v7(
+            Get an upper bound of the gradient norm of the interpolated field inside the grid.
+
+            Note:
+                Outside the grid, the gradient norm is bounded by $\sqrt{L^2 + 1}$.
+            )ipc_Qu8mg5v7")
+        .def(
+            "value", &GridSDF::value,
+            R"ipc_Qu8mg5v7(
+            Evaluate the signed distance at a point.
+
+            Parameters:
+                point: Query point.
+
+            Returns:
+                Interpolated signed distance.
+            )ipc_Qu8mg5v7",
+            py::arg("point"))
+        .def(
+            "gradient", &GridSDF::gradient,
+            R"ipc_Qu8mg5v7(
+            Evaluate the gradient of the signed distance at a point.
+
+            Parameters:
+                point: Query point.
+
+            Returns:
+                Gradient of the interpolated signed distance.
+            )ipc_Qu8mg5v7",
+            py::arg("point"))
+        .def(
+            "hessian", &GridSDF::hessian,
+            R"ipc_Qu8mg5v7(
+            Evaluate the Hessian of the signed distance at a point.
+
+            Parameters:
+                point: Query point.
+
+            Returns:
+                Hessian of the interpolated signed distance.
+            )ipc_Qu8mg5v7",
+            py::arg("point"))
+        .def(
+            "values", &GridSDF::values,
+            R"ipc_Qu8mg5v7(
+            Evaluate the signed distance at many points in parallel.
+
+            Parameters:
+                points: Query points as rows of a matrix.
+
+            Returns:
+                Interpolated signed distance of each point.
+            )ipc_Qu8mg5v7",
+            py::arg("points"))
+        .def(
+            "gradients", &GridSDF::gradients,
+            R"ipc_Qu8mg5v7(
+            Evaluate the gradient of the signed distance at many points in parallel.
+
+            Parameters:
+                points: Query points as rows of a matrix.
+
+            Returns:
+                Gradient of the interpolated signed distance of each point (rowwise).
+            )ipc_Qu8mg5v7",
+            py::arg("points"));
+}
+
+void define_sdf_implicit(py::module_& m)
+{
+    m.def(
+        "construct_point_sdf_collisions",
+        [](Eigen::ConstRef<Eigen::MatrixXd> points,
+           std::shared_ptr<GridSDF> sdf, const double dhat,
+           const double dmin) {
+            std::vector<SDFVertexNormalCollision> sv_collisions;
+            construct_point_sdf_collisions(
+                points, sdf, dhat, sv_collisions, dmin);
+            return sv_collisions;
+        },
+        R"ipc_Qu8mg5v7(
+        Construct a set of point-SDF distance collisions used to compute the barrier potential.
+
+        Note:
+            The signed distances of all points are looked up in batch, so the cost is linear in the number of points.
+
+        Parameters:
+            points: Points as rows of a matrix.
+            sdf: The static signed distance field.
+            dhat: The activation distance of the barrier.
+            dmin: Minimum distance.
+
+        Returns:
+            The constructed set of collisions.
+        )ipc_Qu8mg5v7",
+        py::arg("points"), py::arg("sdf"), py::arg("dhat"),
+        py::arg("dmin") = 0);
+
+    m.def(
+        "construct_point_sdf_collisions",
+        [](Eigen::ConstRef<Eigen::MatrixXd> points,
+           std::shared_ptr<GridSDF> sdf, const double dhat, const double dmin,
+           const std::function<bool(size_t)>& can_collide) {
+            std::vector<SDFVertexNormalCollision> sv_collisions;
+            construct_point_sdf_collisions(
+                points, sdf, dhat, sv_collisions, dmin, can_collide);
+            return sv_collisions;
+        },
+        R"ipc_Qu8mg5v7(
+        Construct a set of point-SDF distance collisions used to compute the barrier potential.
+
+        Note:
+            The signed distances of all points are looked up in batch, so the cost is linear in the number of points.
+
+        Parameters:
+            points: Points as rows of a matrix.
+            sdf: The static signed distance field.
+            dhat: The activation distance of the barrier.
+            dmin: Minimum distance.
+            can_collide: A function that takes a vertex ID (row numbers in points) then returns true if the vertex can collide with the SDF. By default all points can collide with the SDF.
+
+        Returns:
+            The constructed set of collisions.
+        )ipc_Qu8mg5v7",
+        py::arg("points"), py::arg("sdf"), py::arg("dhat"), py::arg("dmin"),
+        py::arg("can_collide"));
+
+    m.def(
+        "is_step_point_sdf_collision_free",
+        [](Eigen::ConstRef<Eigen::MatrixXd> points_t0,
+           Eigen::ConstRef<Eigen::MatrixXd> points_t1, const GridSDF& sdf) {
+            return is_step_point_sdf_collision_free(
+                points_t0, points_t1, sdf);
+        },
+        R"ipc_Qu8mg5v7(
+        Determine if the step is collision free.
+
+        Note:
+            Assumes the trajectory is linear.
+
+        Parameters:
+            points_t0: Points at start as rows of a matrix.
+            points_t1: Points at end as rows of a matrix.
+            sdf: The static signed distance field.
+
+        Returns:
+            True if <b>any</b> collisions occur.
+        )ipc_Qu8mg5v7",
+        py::arg("points_t0"), py::arg("points_t1"), py::arg("sdf"));
+
+    m.def(
+        "is_step_point_sdf_collision_free",
+        [](Eigen::ConstRef<Eigen::MatrixXd> points_t0,
+           Eigen::ConstRef<Eigen::MatrixXd> points_t1, const GridSDF& sdf,
+           const std::function<bool(size_t)>& can_collide) {
+            return is_step_point_sdf_collision_free(
+                points_t0, points_t1, sdf, can_collide);
+        },
+        R"ipc_Qu8mg5v7(
+        Determine if the step is collision free.
+
+        Note:
+            Assumes the trajectory is linear.
+
+        Parameters:
+            points_t0: Points at start as rows of a matrix.
+            points_t1: Points at end as rows of a matrix.
+            sdf: The static signed distance field.
+            can_collide: A function that takes a vertex ID (row numbers in points) then returns true if the vertex can collide with the SDF. By default all points can collide with the SDF.
+
+        Returns:
+            True if <b>any</b> collisions occur.
+        )ipc_Qu8mg5v7",
+        py::arg("points_t0"), py::arg("points_t1"), py::arg("sdf"),
+        py::arg("can_collide"));
+
+    m.def(
+        "compute_point_sdf_collision_free_stepsize",
+        [](Eigen::ConstRef<Eigen::MatrixXd> points_t0,
+           Eigen::ConstRef<Eigen::MatrixXd> points_t1, const GridSDF& sdf) {
+            return compute_point_sdf_collision_free_stepsize(
+                points_t0, points_t1, sdf);
+        },
+        R"ipc_Qu8mg5v7(
+        Computes a maximal step size that is collision free.
+
+        Notes:
+            Assumes points_t0 is intersection free.
+            Assumes the trajectory is linear.
+            A value of 1.0 if a full step and 0.0 is no step.
+
+        Parameters:
+            points_t0: Points at start as rows of a matrix.
+            points_t1: Points at end as rows of a matrix.
+            sdf: The static signed distance field.
+
+        Returns:
+            A step-size $\in [0, 1]$ that is collision free.
+        )ipc_Qu8mg5v7",
+        py::arg("points_t0"), py::arg("points_t1"), py::arg("sdf"));
+
+    m.def(
+        "compute_point_sdf_collision_free_stepsize",
+        [](Eigen::ConstRef<Eigen::MatrixXd> points_t0,
+           Eigen::ConstRef<Eigen::MatrixXd> points_t1, const GridSDF& sdf,
+           const std::function<bool(size_t)>& can_collide) {
+            return compute_point_sdf_collision_free_stepsize(
+                points_t0, points_t1, sdf, can_collide);
+        },
+        R"ipc_Qu8mg5v7(
+        Computes a maximal step size that is collision free.
+
+        Notes:
+            Assumes points_t0 is intersection free.
+            Assumes the trajectory is linear.
+            A value of 1.0 if a full step and 0.0 is no step.
+
+        Parameters:
+            points_t0: Points at start as rows of a matrix.
+            points_t1: Points at end as rows of a matrix.
+            sdf: The static signed distance field.
+            can_collide: A function that takes a vertex ID (row numbers in points) then returns true if the vertex can collide with the SDF. By default all points can collide with the SDF.
+
+        Returns:
+            A step-size $\in [0, 1]$ that is collision free.
+        )ipc_Qu8mg5v7",
+        py::arg("points_t0"), py::arg("points_t1"), py::arg("sdf"),
+        py::arg("can_collide"));
+}
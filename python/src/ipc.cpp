@@ -37,7 +37,12 @@ void define_ipc(py::module_& m)
         py::arg("narrow_phase_ccd") = DEFAULT_NARROW_PHASE_CCD);
 
     m.def(
-        "compute_collision_free_stepsize", &compute_collision_free_stepsize,
+        "compute_collision_free_stepsize",
+        py::overload_cast<
+            const CollisionMesh&, Eigen::ConstRef<Eigen::MatrixXd>,
+            Eigen::ConstRef<Eigen::MatrixXd>, const double,
+            const std::shared_ptr<BroadPhase>, const NarrowPhaseCCD&>(
+            &compute_collision_free_stepsize),
         R"ipc_Qu8mg5v7(
         Computes a maximal step size that is collision free.
 
@@ -61,7 +66,65 @@ void define_ipc(py::module_& m)
         py::arg("narrow_phase_ccd") = DEFAULT_NARROW_PHASE_CCD);
 
     m.def(
-        "has_intersections", &has_intersections,
+        "compute_collision_free_stepsize",
+        py::overload_cast<
+            const CollisionMesh&,
+            const std::vector<const NonlinearTrajectory*>&, const double,
+            const std::shared_ptr<BroadPhase>, const double, const long,
+            const double>(&compute_collision_free_stepsize),
+        R"ipc_Qu8mg5v7(
+        Computes a maximal step size that is collision free along nonlinear trajectories.
+
+        Parameters:
+            mesh: The collision mesh.
+            trajectories: Trajectory of each vertex. Assumes the vertices at t=0 are intersection free.
+            min_distance: The minimum distance allowable between any two elements.
+            broad_phase: Broad phase to use.
+            tolerance: Tolerance for the linear CCD algorithm.
+            max_iterations: Maximum number of iterations for the linear CCD algorithm.
+            conservative_rescaling: Conservative rescaling of the time of impact.
+
+        Returns:
+            A step-size :math:`\in [0, 1]` that is collision free. A value of 1.0 if a full step and 0.0 is no step.
+        )ipc_Qu8mg5v7",
+        py::arg("mesh"), py::arg("trajectories"),
+        py::arg("min_distance") = 0.0,
+        py::arg("broad_phase") = make_default_broad_phase(),
+        py::arg("tolerance") = TightInclusionCCD::DEFAULT_TOLERANCE,
+        py::arg("max_iterations") = TightInclusionCCD::DEFAULT_MAX_ITERATIONS,
+        py::arg("conservative_rescaling") =
+            TightInclusionCCD::DEFAULT_CONSERVATIVE_RESCALING);
+
+    m.def(
+        "compute_per_vertex_collision_free_stepsize",
+        &compute_per_vertex_collision_free_stepsize,
+        R"ipc_Qu8mg5v7(
+        Computes the maximum collision-free step size of each vertex.
+
+        Note:
+            Assumes the trajectory is linear.
+
+        Parameters:
+            mesh: The collision mesh.
+            vertices_t0: Vertex vertices at start as rows of a matrix. Assumes vertices_t0 is intersection free.
+            vertices_t1: Surface vertex vertices at end as rows of a matrix.
+            min_distance: The minimum distance allowable between any two elements.
+            broad_phase: Broad phase to use.
+            narrow_phase_ccd: The narrow phase CCD algorithm to use.
+
+        Returns:
+            A step-size :math:`\in [0, 1]` per vertex that is collision free for all candidates incident on the vertex.
+        )ipc_Qu8mg5v7",
+        py::arg("mesh"), py::arg("vertices_t0"), py::arg("vertices_t1"),
+        py::arg("min_distance") = 0.0,
+        py::arg("broad_phase") = make_default_broad_phase(),
+        py::arg("narrow_phase_ccd") = DEFAULT_NARROW_PHASE_CCD);
+
+    m.def(
+        "has_intersections",
+        py::overload_cast<
+            const CollisionMesh&, Eigen::ConstRef<Eigen::MatrixXd>,
+            const std::shared_ptr<BroadPhase>>(&has_intersections),
         R"ipc_Qu8mg5v7(
         Determine if the mesh has self intersections.
 
@@ -76,6 +139,30 @@ void define_ipc(py::module_& m)
         py::arg("mesh"), py::arg("vertices"),
         py::arg("broad_phase") = make_default_broad_phase());
 
+    m.def(
+        "has_intersections",
+        py::overload_cast<
+            const CollisionMesh&, Eigen::ConstRef<Eigen::MatrixXd>,
+            Eigen::ConstRef<Eigen::MatrixXd>,
+            const std::shared_ptr<BroadPhase>>(&has_intersections),
+        R"ipc_Qu8mg5v7(
+        Determine if the mesh has self intersections, given an intersection-free state.
+
+        Note:
+            Only elements incident to vertices that moved since the verified state are checked.
+
+        Parameters:
+            mesh: The collision mesh.
+            vertices: Vertices of the collision mesh.
+            verified_vertices: Intersection-free vertices of the collision mesh (e.g., the last accepted state).
+            broad_phase: Broad phase to use.
+
+        Returns:
+            A boolean for if the mesh has intersections.
+        )ipc_Qu8mg5v7",
+        py::arg("mesh"), py::arg("vertices"), py::arg("verified_vertices"),
+        py::arg("broad_phase") = make_default_broad_phase());
+
     m.def(
         "edges",
         [](Eigen::ConstRef<Eigen::MatrixXi> F) {
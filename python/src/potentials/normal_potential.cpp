@@ -33,15 +33,34 @@ void define_normal_potential(py::module_& m)
                 The derivative of the force with respect to X, the rest vertices.
             )ipc_Qu8mg5v7",
             py::arg("collisions"), py::arg("mesh"), py::arg("vertices"))
+        .def(
+            "shape_derivative_bsr", &NormalPotential::shape_derivative_bsr,
+            R"ipc_Qu8mg5v7(
+            Compute the shape derivative of the potential in block compressed sparse row (BSR) format.
+
+            std::runtime_error If the collision collisions were not built with shape derivatives enabled.
+
+            Parameters:
+                collisions: The set of collisions.
+                mesh: The collision mesh.
+                vertices: Vertices of the collision mesh.
+
+            Returns:
+                The derivative of the force with respect to X, the rest vertices, made of dim×dim blocks.
+            )ipc_Qu8mg5v7",
+            py::arg("collisions"), py::arg("mesh"), py::arg("vertices"))
         .def(
             "shape_derivative",
             [](const NormalPotential& self, const NormalCollision& collision,
+               const Eigen::SparseMatrix<double>& weight_gradient,
                const std::array<long, 4>& vertex_ids,
                Eigen::ConstRef<VectorMax12d> rest_positions,
                Eigen::ConstRef<VectorMax12d> positions) {
+                assert_is_sparse_vector(weight_gradient, "weight_gradient");
                 std::vector<Eigen::Triplet<double>> out;
                 self.shape_derivative(
-                    collision, vertex_ids, rest_positions, positions, out);
+                    collision, weight_gradient, vertex_ids, rest_positions,
+                    positions, out);
                 return out;
             },
             R"ipc_Qu8mg5v7(
@@ -49,13 +68,15 @@ void define_normal_potential(py::module_& m)
 
             Parameters:
                 collision: The collision.
+                weight_gradient: The gradient of the collision's weight w.r.t. the rest positions (e.g., NormalCollisions.weight_gradients[i]).
                 vertex_ids: The collision stencil's vertex ids.
                 rest_positions: The collision stencil's rest positions.
                 positions: The collision stencil's positions.
                 ,out]: out Store the triplets of the shape derivative here.
             )ipc_Qu8mg5v7",
-            py::arg("collision"), py::arg("vertex_ids"),
-            py::arg("rest_positions"), py::arg("positions"))
+            py::arg("collision"), py::arg("weight_gradient"),
+            py::arg("vertex_ids"), py::arg("rest_positions"),
+            py::arg("positions"))
         .def(
             "force_magnitude", &NormalPotential::force_magnitude,
             R"ipc_Qu8mg5v7(
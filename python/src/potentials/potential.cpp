@@ -0,0 +1,40 @@
+#include <common.hpp>
+
+#include <ipc/potentials/potential.hpp>
+
+namespace py = pybind11;
+using namespace ipc;
+
+void define_potential(py::module_& m)
+{
+    // NOTE: The values are not exported to avoid clashing with
+    // PSDProjectionMethod.NONE.
+    py::enum_<EvaluationFlags>(
+        m, "EvaluationFlags",
+        "Quantities computed by Potential.evaluate (combine with |).")
+        .value("NONE", EvaluationFlags::NONE, "Compute nothing")
+        .value("ENERGY", EvaluationFlags::ENERGY, "Compute the potential")
+        .value("GRADIENT", EvaluationFlags::GRADIENT, "Compute the gradient")
+        .value("HESSIAN", EvaluationFlags::HESSIAN, "Compute the Hessian")
+        .value("ALL", EvaluationFlags::ALL, "Compute all quantities")
+        .def(
+            "__or__",
+            [](const EvaluationFlags a, const EvaluationFlags b) {
+                return a | b;
+            })
+        .def("__and__", [](const EvaluationFlags a, const EvaluationFlags b) {
+            return a & b;
+        });
+
+    py::class_<PotentialEvaluation>(m, "PotentialEvaluation")
+        .def(py::init<>())
+        .def_readwrite(
+            "energy", &PotentialEvaluation::energy,
+            "The potential (zero if not requested).")
+        .def_readwrite(
+            "gradient", &PotentialEvaluation::gradient,
+            "The gradient of the potential w.r.t. X (empty if not requested).")
+        .def_readwrite(
+            "hessian", &PotentialEvaluation::hessian,
+            "The Hessian of the potential w.r.t. X (empty if not requested).");
+}
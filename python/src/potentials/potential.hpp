@@ -51,6 +51,28 @@ void define_potential_methods(PyClass& potential)
                 The gradient of the potential w.r.t. X. This will have a size of |X|.
             )ipc_Qu8mg5v7",
             py::arg("collisions"), py::arg("mesh"), py::arg("X"))
+        .def(
+            "gradient",
+            py::overload_cast<
+                const TCollisions&, const CollisionMesh&,
+                Eigen::ConstRef<Eigen::MatrixXd>, GradientScatter&>(
+                &Potential<TCollisions>::gradient, py::const_),
+            R"ipc_Qu8mg5v7(
+            Compute the gradient of the potential without per-thread global vectors.
+
+            The local gradients are written to the scatter's per-collision buffers and gathered by vertex, so the scratch memory does not grow with the number of threads and no two threads write the same entry. The scatter is only rebuilt if the collisions' stencils changed since it was built.
+
+            Parameters:
+                collisions: The set of collisions.
+                mesh: The collision mesh.
+                X: Degrees of freedom of the collision mesh (e.g., vertices or velocities).
+                scatter: The scatter to reuse (rebuilt if needed).
+
+            Returns:
+                The gradient of the potential w.r.t. X. This will have a size of |X|.
+            )ipc_Qu8mg5v7",
+            py::arg("collisions"), py::arg("mesh"), py::arg("X"),
+            py::arg("scatter"))
         .def(
             "hessian",
             py::overload_cast<
@@ -71,6 +93,240 @@ void define_potential_methods(PyClass& potential)
             )ipc_Qu8mg5v7",
             py::arg("collisions"), py::arg("mesh"), py::arg("X"),
             py::arg("project_hessian_to_psd") = PSDProjectionMethod::NONE)
+        .def(
+            "hessian",
+            py::overload_cast<
+                const TCollisions&, const CollisionMesh&,
+                Eigen::ConstRef<Eigen::MatrixXd>, HessianPattern&,
+                const PSDProjectionMethod>(
+                &Potential<TCollisions>::hessian, py::const_),
+            R"ipc_Qu8mg5v7(
+            Compute the hessian of the potential reusing a sparsity pattern.
+
+            The local hessians are scattered directly into the pattern's values instead of being assembled from triplets. The pattern is only rebuilt if the collisions' stencils changed since it was built (e.g., when the active set changes), so across Newton iterations with the same collisions only the numeric values are refreshed.
+
+            Parameters:
+                collisions: The set of collisions.
+                mesh: The collision mesh.
+                X: Degrees of freedom of the collision mesh (e.g., vertices or velocities).
+                pattern: The sparsity pattern to reuse (rebuilt if needed).
+                project_hessian_to_psd: Make sure the hessian is positive semi-definite.
+
+            Returns:
+                The Hessian of the potential w.r.t. X. This will have a size of |X|×|X|.
+            )ipc_Qu8mg5v7",
+            py::arg("collisions"), py::arg("mesh"), py::arg("X"),
+            py::arg("pattern"),
+            py::arg("project_hessian_to_psd") = PSDProjectionMethod::NONE)
+        .def(
+            "hessian_vector_product",
+            &Potential<TCollisions>::hessian_vector_product,
+            R"ipc_Qu8mg5v7(
+            Compute the product of the hessian of the potential with a vector without assembling the hessian.
+
+            Each collision's local hessian is applied to the collision stencil's entries of p as soon as it is computed, so no global matrix is stored. The local products are then gathered by vertex, so no per-thread global vectors are needed either.
+
+            Parameters:
+                collisions: The set of collisions.
+                mesh: The collision mesh.
+                X: Degrees of freedom of the collision mesh (e.g., vertices or velocities).
+                p: The vector to multiply (of size |X|, ordered like the gradient).
+                project_hessian_to_psd: Make sure the hessian is positive semi-definite.
+
+            Returns:
+                The product of the Hessian of the potential w.r.t. X with p. This will have a size of |X|.
+            )ipc_Qu8mg5v7",
+            py::arg("collisions"), py::arg("mesh"), py::arg("X"), py::arg("p"),
+            py::arg("project_hessian_to_psd") = PSDProjectionMethod::NONE)
+        .def(
+            "hessian_operator", &Potential<TCollisions>::hessian_operator,
+            R"ipc_Qu8mg5v7(
+            Compute the local hessians of the potential as a matrix-free operator.
+
+            Note:
+                Use this instead of hessian_vector_product when multiplying the same hessian by several vectors (e.g., in a conjugate gradient solve).
+
+            Parameters:
+                collisions: The set of collisions.
+                mesh: The collision mesh.
+                X: Degrees of freedom of the collision mesh (e.g., vertices or velocities).
+                project_hessian_to_psd: Make sure the hessian is positive semi-definite.
+
+            Returns:
+                The Hessian of the potential w.r.t. X as an operator. This will have a size of |X|×|X|.
+            )ipc_Qu8mg5v7",
+            py::arg("collisions"), py::arg("mesh"), py::arg("X"),
+            py::arg("project_hessian_to_psd") = PSDProjectionMethod::NONE)
+        .def(
+            "hessian_diagonal", &Potential<TCollisions>::hessian_diagonal,
+            R"ipc_Qu8mg5v7(
+            Compute the diagonal of the hessian of the potential without assembling the hessian.
+
+            Note:
+                Useful for Jacobi preconditioners.
+
+            Parameters:
+                collisions: The set of collisions.
+                mesh: The collision mesh.
+                X: Degrees of freedom of the collision mesh (e.g., vertices or velocities).
+                project_hessian_to_psd: Make sure the hessian is positive semi-definite (applied to the local hessians before their diagonals are extracted).
+
+            Returns:
+                The diagonal of the Hessian of the potential w.r.t. X. This will have a size of |X|.
+            )ipc_Qu8mg5v7",
+            py::arg("collisions"), py::arg("mesh"), py::arg("X"),
+            py::arg("project_hessian_to_psd") = PSDProjectionMethod::NONE)
+        .def(
+            "hessian_block_diagonal",
+            &Potential<TCollisions>::hessian_block_diagonal,
+            R"ipc_Qu8mg5v7(
+            Compute the vertex diagonal blocks of the hessian of the potential without assembling the hessian.
+
+            Note:
+                Useful for block-Jacobi preconditioners.
+
+            Parameters:
+                collisions: The set of collisions.
+                mesh: The collision mesh.
+                X: Degrees of freedom of the collision mesh (e.g., vertices or velocities).
+                project_hessian_to_psd: Make sure the hessian is positive semi-definite (applied to the local hessians before their blocks are extracted).
+
+            Returns:
+                The dim×dim diagonal blocks of the Hessian of the potential w.r.t. X stacked vertically (i.e., rows [dim·i, dim·i + dim) hold the block of vertex i). This will have a size of |X|×dim.
+            )ipc_Qu8mg5v7",
+            py::arg("collisions"), py::arg("mesh"), py::arg("X"),
+            py::arg("project_hessian_to_psd") = PSDProjectionMethod::NONE)
+        .def(
+            "hessian_bsr", &Potential<TCollisions>::hessian_bsr,
+            R"ipc_Qu8mg5v7(
+            Compute the hessian of the potential in block compressed sparse row (BSR) format.
+
+            Parameters:
+                collisions: The set of collisions.
+                mesh: The collision mesh.
+                X: Degrees of freedom of the collision mesh (e.g., vertices or velocities).
+                project_hessian_to_psd: Make sure the hessian is positive semi-definite.
+
+            Returns:
+                The Hessian of the potential w.r.t. X made of dim×dim blocks. This will have a size of |X|×|X|.
+            )ipc_Qu8mg5v7",
+            py::arg("collisions"), py::arg("mesh"), py::arg("X"),
+            py::arg("project_hessian_to_psd") = PSDProjectionMethod::NONE)
+        .def(
+            "evaluate",
+            py::overload_cast<
+                const TCollisions&, const CollisionMesh&,
+                Eigen::ConstRef<Eigen::MatrixXd>, const EvaluationFlags,
+                const PSDProjectionMethod>(
+                &Potential<TCollisions>::evaluate, py::const_),
+            R"ipc_Qu8mg5v7(
+            Compute any subset of the potential, its gradient, and its hessian in a single pass.
+
+            Each collision's degrees of freedom are gathered once and the
+            intermediate quantities (e.g., distances and their derivatives) are
+            shared between the requested outputs, which is cheaper than calling
+            __call__, gradient, and hessian separately.
+
+            Parameters:
+                collisions: The set of collisions.
+                mesh: The collision mesh.
+                X: Degrees of freedom of the collision mesh (e.g., vertices or velocities).
+                flags: The quantities to compute.
+                project_hessian_to_psd: Make sure the hessian is positive semi-definite.
+
+            Returns:
+                The requested quantities.
+            )ipc_Qu8mg5v7",
+            py::arg("collisions"), py::arg("mesh"), py::arg("X"),
+            py::arg("flags") = EvaluationFlags::ALL,
+            py::arg("project_hessian_to_psd") = PSDProjectionMethod::NONE)
+        .def(
+            "__call__",
+            py::overload_cast<
+                const TCollisions&, const CollisionMesh&,
+                Eigen::ConstRef<Eigen::MatrixXd>, const std::vector<size_t>&>(
+                &Potential<TCollisions>::operator(), py::const_),
+            R"ipc_Qu8mg5v7(
+            Compute the potential for a subset of the collisions.
+
+            Parameters:
+                collisions: The set of collisions.
+                mesh: The collision mesh.
+                X: Degrees of freedom of the collision mesh (e.g., vertices or velocities).
+                collision_ids: Indices of the collisions to include (e.g., the stencils of a contact island).
+
+            Returns:
+                The potential for the subset of collisions.
+            )ipc_Qu8mg5v7",
+            py::arg("collisions"), py::arg("mesh"), py::arg("X"),
+            py::arg("collision_ids"))
+        .def(
+            "gradient",
+            py::overload_cast<
+                const TCollisions&, const CollisionMesh&,
+                Eigen::ConstRef<Eigen::MatrixXd>, const std::vector<size_t>&>(
+                &Potential<TCollisions>::gradient, py::const_),
+            R"ipc_Qu8mg5v7(
+            Compute the gradient of the potential for a subset of the collisions.
+
+            Parameters:
+                collisions: The set of collisions.
+                mesh: The collision mesh.
+                X: Degrees of freedom of the collision mesh (e.g., vertices or velocities).
+                collision_ids: Indices of the collisions to include (e.g., the stencils of a contact island).
+
+            Returns:
+                The gradient of the potential w.r.t. X. This will have a size of |X|.
+            )ipc_Qu8mg5v7",
+            py::arg("collisions"), py::arg("mesh"), py::arg("X"),
+            py::arg("collision_ids"))
+        .def(
+            "hessian",
+            py::overload_cast<
+                const TCollisions&, const CollisionMesh&,
+                Eigen::ConstRef<Eigen::MatrixXd>, const std::vector<size_t>&,
+                const PSDProjectionMethod>(
+                &Potential<TCollisions>::hessian, py::const_),
+            R"ipc_Qu8mg5v7(
+            Compute the hessian of the potential for a subset of the collisions.
+
+            Parameters:
+                collisions: The set of collisions.
+                mesh: The collision mesh.
+                X: Degrees of freedom of the collision mesh (e.g., vertices or velocities).
+                collision_ids: Indices of the collisions to include (e.g., the stencils of a contact island).
+                project_hessian_to_psd: Make sure the hessian is positive semi-definite.
+
+            Returns:
+                The Hessian of the potential w.r.t. X. This will have a size of |X|×|X|.
+            )ipc_Qu8mg5v7",
+            py::arg("collisions"), py::arg("mesh"), py::arg("X"),
+            py::arg("collision_ids"),
+            py::arg("project_hessian_to_psd") = PSDProjectionMethod::NONE)
+        .def(
+            "evaluate",
+            py::overload_cast<
+                const TCollisions&, const CollisionMesh&,
+                Eigen::ConstRef<Eigen::MatrixXd>, const std::vector<size_t>&,
+                const EvaluationFlags, const PSDProjectionMethod>(
+                &Potential<TCollisions>::evaluate, py::const_),
+            R"ipc_Qu8mg5v7(
+            Compute any subset of the potential, its gradient, and its hessian for a subset of the collisions in a single pass.
+
+            Parameters:
+                collisions: The set of collisions.
+                mesh: The collision mesh.
+                X: Degrees of freedom of the collision mesh (e.g., vertices or velocities).
+                collision_ids: Indices of the collisions to include (e.g., the stencils of a contact island).
+                flags: The quantities to compute.
+                project_hessian_to_psd: Make sure the hessian is positive semi-definite.
+
+            Returns:
+                The requested quantities.
+            )ipc_Qu8mg5v7",
+            py::arg("collisions"), py::arg("mesh"), py::arg("X"),
+            py::arg("collision_ids"), py::arg("flags") = EvaluationFlags::ALL,
+            py::arg("project_hessian_to_psd") = PSDProjectionMethod::NONE)
         .def(
             "__call__",
             py::overload_cast<const TCollision&, Eigen::ConstRef<VectorMax12d>>(
@@ -118,5 +374,9 @@ void define_potential_methods(PyClass& potential)
                 The hessian of the potential.
             )ipc_Qu8mg5v7",
             py::arg("collision"), py::arg("x"),
-            py::arg("project_hessian_to_psd") = PSDProjectionMethod::NONE);
+            py::arg("project_hessian_to_psd") = PSDProjectionMethod::NONE)
+        .def_property(
+            "workspace", &Potential<TCollisions>::workspace,
+            &Potential<TCollisions>::set_workspace,
+            "Persistent buffers reused across evaluations (None to allocate per evaluation).");
 }
@@ -57,6 +57,39 @@ void define_tangential_potential(py::module_& m)
             py::arg("lagged_displacements"), py::arg("velocities"),
             py::arg("normal_potential"), py::arg("normal_stiffness"),
             py::arg("dmin") = 0, py::arg("no_mu") = false)
+        .def(
+            "force",
+            py::overload_cast<
+                const TangentialCollisions&, const CollisionMesh&,
+                Eigen::ConstRef<Eigen::MatrixXd>,
+                Eigen::ConstRef<Eigen::MatrixXd>,
+                Eigen::ConstRef<Eigen::MatrixXd>, const NormalPotential&,
+                const double, GradientScatter&, const double, const bool>(
+                &TangentialPotential::force, py::const_),
+            R"ipc_Qu8mg5v7(
+            Compute the friction force without per-thread global vectors.
+
+            The local forces are written to the scatter's per-collision buffers and gathered by vertex (see GradientScatter). The scatter is only rebuilt if the collisions' stencils changed since it was built.
+
+            Parameters:
+                collisions: The set of collisions.
+                mesh: The collision mesh.
+                rest_positions: Rest positions of the vertices (rowwise).
+                lagged_displacements: Previous displacements of the vertices (rowwise).
+                velocities: Current displacements of the vertices (rowwise).
+                normal_potential: Normal potential (used for normal force magnitude).
+                normal_stiffness: Normal stiffness (used for normal force magnitude).
+                scatter: The scatter to reuse (rebuilt if needed).
+                dmin: Minimum distance (used for normal force magnitude).
+                no_mu: whether to not multiply by mu
+
+            Returns:
+                The friction force.
+            )ipc_Qu8mg5v7",
+            py::arg("collisions"), py::arg("mesh"), py::arg("rest_positions"),
+            py::arg("lagged_displacements"), py::arg("velocities"),
+            py::arg("normal_potential"), py::arg("normal_stiffness"),
+            py::arg("scatter"), py::arg("dmin") = 0, py::arg("no_mu") = false)
         .def(
             "force_jacobian",
             py::overload_cast<
@@ -87,6 +120,29 @@ void define_tangential_potential(py::module_& m)
             py::arg("lagged_displacements"), py::arg("velocities"),
             py::arg("normal_potential"), py::arg("normal_stiffness"),
             py::arg("wrt"), py::arg("dmin") = 0)
+        .def(
+            "force_jacobian_bsr", &TangentialPotential::force_jacobian_bsr,
+            R"ipc_Qu8mg5v7(
+            Compute the Jacobian of the friction force in block compressed sparse row (BSR) format.
+
+            Parameters:
+                collisions: The set of collisions.
+                mesh: The collision mesh.
+                rest_positions: Rest positions of the vertices (rowwise).
+                lagged_displacements: Previous displacements of the vertices (rowwise).
+                velocities: Current displacements of the vertices (rowwise).
+                normal_potential: Normal potential (used for normal force magnitude).
+                normal_stiffness: Normal stiffness (used for normal force magnitude).
+                wrt: The variable to take the derivative with respect to.
+                dmin: Minimum distance (used for normal force magnitude).
+
+            Returns:
+                The Jacobian of the friction force made of dim×dim blocks.
+            )ipc_Qu8mg5v7",
+            py::arg("collisions"), py::arg("mesh"), py::arg("rest_positions"),
+            py::arg("lagged_displacements"), py::arg("velocities"),
+            py::arg("normal_potential"), py::arg("normal_stiffness"),
+            py::arg("wrt"), py::arg("dmin") = 0)
         .def(
             "force",
             py::overload_cast<
@@ -4,10 +4,15 @@
 namespace py = pybind11;
 
 void define_area_gradient(py::module_& m);
+void define_block_sparse_matrix(py::module_& m);
 void define_eigen_ext(py::module_& m);
+void define_gradient_scatter(py::module_& m);
+void define_hessian_operator(py::module_& m);
+void define_hessian_pattern(py::module_& m);
 void define_interval(py::module_& m);
 void define_intersection(py::module_& m);
 void define_logger(py::module_& m);
 void define_thread_limiter(py::module_& m);
 void define_vertex_to_min_edge(py::module_& m);
+void define_workspace(py::module_& m);
 void define_world_bbox_diagonal_length(py::module_& m);
\ No newline at end of file
@@ -0,0 +1,86 @@
+#include <common.hpp>
+
+#include <ipc/utils/block_sparse_matrix.hpp>
+
+namespace py = pybind11;
+using namespace ipc;
+
+void define_block_sparse_matrix(py::module_& m)
+{
+    py::class_<BlockSparseMatrix>(
+        m, "BlockSparseMatrix",
+        R"ipc_Qu8mg5v7(
+        A sparse matrix of dense square blocks in block compressed sparse row (BSR) format.
+
+        Blocks are stored consecutively in row-major order, so a SciPy matrix can be built with ``scipy.sparse.bsr_matrix((numpy.reshape(A.values, (-1, b, b)), A.col_indices, A.row_offsets), shape=(A.rows, A.cols))`` where ``b = A.block_size``.
+        )ipc_Qu8mg5v7")
+        .def(py::init())
+        .def(
+            py::init<const int, const int, const int>(),
+            R"ipc_Qu8mg5v7(
+            Construct an empty (i.e., all zero) matrix.
+
+            Parameters:
+                rows: Number of rows (a multiple of block_size).
+                cols: Number of columns (a multiple of block_size).
+                block_size: Number of rows and columns of each block.
+            )ipc_Qu8mg5v7",
+            py::arg("rows"), py::arg("cols"), py::arg("block_size"))
+        .def_property_readonly(
+            "rows", &BlockSparseMatrix::rows, "Number of rows.")
+        .def_property_readonly(
+            "cols", &BlockSparseMatrix::cols, "Number of columns.")
+        .def_property_readonly(
+            "block_size", &BlockSparseMatrix::block_size,
+            "Number of rows and columns of each block.")
+        .def_property_readonly(
+            "block_rows", &BlockSparseMatrix::block_rows,
+            "Number of block rows.")
+        .def_property_readonly(
+            "block_cols", &BlockSparseMatrix::block_cols,
+            "Number of block columns.")
+        .def_property_readonly(
+            "num_blocks", &BlockSparseMatrix::num_blocks,
+            "Number of stored blocks.")
+        .def_property_readonly(
+            "row_offsets", &BlockSparseMatrix::row_offsets,
+            "Start of each block row in the blocks (followed by the number of blocks).")
+        .def_property_readonly(
+            "col_indices", &BlockSparseMatrix::col_indices,
+            "Block column of each block (sorted within each block row).")
+        .def_property_readonly(
+            "values", &BlockSparseMatrix::values,
+            "Entries of the blocks (each block is row-major).")
+        .def(
+            "block",
+            [](const BlockSparseMatrix& self, const size_t k) {
+                if (k >= self.num_blocks()) {
+                    throw py::index_error("Block index out of range!");
+                }
+                return Eigen::MatrixXd(self.block(k));
+            },
+            R"ipc_Qu8mg5v7(
+            Get a block.
+
+            Parameters:
+                k: Index of the block.
+
+            Returns:
+                A copy of the block.
+            )ipc_Qu8mg5v7",
+            py::arg("k"))
+        .def(
+            "__matmul__",
+            [](const BlockSparseMatrix& self, const Eigen::VectorXd& x) {
+                return self * x;
+            },
+            "Multiply the matrix by a vector.", py::arg("x"))
+        .def(
+            "to_csr", &BlockSparseMatrix::to_csr,
+            R"ipc_Qu8mg5v7(
+            Convert to a compressed sparse row (CSR) matrix.
+
+            Note:
+                Zeros inside stored blocks are kept as explicit entries.
+            )ipc_Qu8mg5v7");
+}
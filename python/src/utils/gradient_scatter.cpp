@@ -0,0 +1,55 @@
+#include <common.hpp>
+
+#include <ipc/utils/gradient_scatter.hpp>
+
+namespace py = pybind11;
+using namespace ipc;
+
+void define_gradient_scatter(py::module_& m)
+{
+    py::class_<GradientScatter>(
+        m, "GradientScatter",
+        R"ipc_Qu8mg5v7(
+        Reusable scatter for assembling a gradient from local stencil gradients without per-thread global vectors.
+
+        Each stencil writes its local gradient into its own slot of a flat buffer, and the slots are gathered by a segmented reduction keyed on vertex id, so no two threads write the same entry and the scratch memory does not grow with the number of threads.
+        )ipc_Qu8mg5v7")
+        .def(py::init())
+        .def(
+            "build", &GradientScatter::build,
+            R"ipc_Qu8mg5v7(
+            Build the scatter.
+
+            Parameters:
+                stencils: Vertex ids of each stencil (padded with -1).
+                dim: Dimension of the vertices.
+                ndof: Number of entries of the gradient.
+            )ipc_Qu8mg5v7",
+            py::arg("stencils"), py::arg("dim"), py::arg("ndof"))
+        .def(
+            "is_built_for", &GradientScatter::is_built_for,
+            R"ipc_Qu8mg5v7(
+            Determine if the scatter was built for the given stencils.
+
+            Parameters:
+                stencils: Vertex ids of each stencil (padded with -1).
+                dim: Dimension of the vertices.
+                ndof: Number of entries of the gradient.
+
+            Returns:
+                True if the scatter can be reused for the stencils.
+            )ipc_Qu8mg5v7",
+            py::arg("stencils"), py::arg("dim"), py::arg("ndof"))
+        .def("clear", &GradientScatter::clear, "Remove the scatter.")
+        .def_property_readonly(
+            "num_stencils", &GradientScatter::num_stencils,
+            "Number of stencils.")
+        .def_property_readonly(
+            "dim", &GradientScatter::dim, "Dimension of the vertices.")
+        .def_property_readonly(
+            "size", &GradientScatter::size,
+            "Number of entries of the gradient.")
+        .def_property_readonly(
+            "vector", &GradientScatter::vector,
+            "The global gradient (as of the last assembly).");
+}
@@ -0,0 +1,75 @@
+#include <common.hpp>
+
+#include <ipc/utils/hessian_operator.hpp>
+
+namespace py = pybind11;
+using namespace ipc;
+
+void define_hessian_operator(py::module_& m)
+{
+    py::class_<HessianOperator>(
+        m, "HessianOperator",
+        R"ipc_Qu8mg5v7(
+        Matrix-free Hessian stored as the local Hessians of the collision stencils.
+
+        Products with a vector apply each local Hessian to the stencil's entries of the vector, so the global sparse matrix is never assembled. The local Hessians are computed once for any number of products (e.g., the iterations of a conjugate gradient solve).
+        )ipc_Qu8mg5v7")
+        .def(py::init())
+        .def(
+            "build", &HessianOperator::build,
+            R"ipc_Qu8mg5v7(
+            Allocate the local Hessians of the stencils.
+
+            Parameters:
+                stencils: Vertex ids of each stencil (padded with -1).
+                dim: Dimension of the vertices.
+                ndof: Number of rows and columns of the Hessian.
+            )ipc_Qu8mg5v7",
+            py::arg("stencils"), py::arg("dim"), py::arg("ndof"))
+        .def("clear", &HessianOperator::clear, "Remove all stencils.")
+        .def_property_readonly(
+            "num_stencils", &HessianOperator::num_stencils,
+            "Number of stencils.")
+        .def_property_readonly(
+            "dim", &HessianOperator::dim, "Dimension of the vertices.")
+        .def_property_readonly(
+            "rows", &HessianOperator::rows, "Number of rows.")
+        .def_property_readonly(
+            "cols", &HessianOperator::cols, "Number of columns.")
+        .def(
+            "stencil", &HessianOperator::stencil,
+            R"ipc_Qu8mg5v7(
+            Get the vertex ids of a stencil.
+
+            Parameters:
+                i: Index of the stencil.
+
+            Returns:
+                The vertex ids of the stencil (padded with -1).
+            )ipc_Qu8mg5v7",
+            py::arg("i"))
+        .def(
+            "local_hessian",
+            [](const HessianOperator& self, const size_t i) {
+                if (i >= self.num_stencils()) {
+                    throw py::index_error("Stencil index out of range!");
+                }
+                return Eigen::MatrixXd(self.local_hessian(i));
+            },
+            R"ipc_Qu8mg5v7(
+            Get a stencil's local Hessian.
+
+            Parameters:
+                i: Index of the stencil.
+
+            Returns:
+                A copy of the stencil's local Hessian.
+            )ipc_Qu8mg5v7",
+            py::arg("i"))
+        .def(
+            "__matmul__",
+            [](const HessianOperator& self, const Eigen::VectorXd& p) {
+                return self * p;
+            },
+            "Multiply the Hessian by a vector.", py::arg("p"));
+}
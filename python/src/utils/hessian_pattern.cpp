@@ -0,0 +1,53 @@
+#include <common.hpp>
+
+#include <ipc/utils/hessian_pattern.hpp>
+
+namespace py = pybind11;
+using namespace ipc;
+
+void define_hessian_pattern(py::module_& m)
+{
+    py::class_<HessianPattern>(
+        m, "HessianPattern",
+        R"ipc_Qu8mg5v7(
+        Reusable sparsity pattern for assembling a Hessian from local stencil Hessians.
+
+        The symbolic structure is computed once per set of stencils. Refreshing the numeric values then scatters each stencil's local Hessian straight into the matrix's values in O(nnz), avoiding triplet sorting and sparse matrix additions.
+        )ipc_Qu8mg5v7")
+        .def(py::init())
+        .def(
+            "build", &HessianPattern::build,
+            R"ipc_Qu8mg5v7(
+            Build the pattern.
+
+            Parameters:
+                stencils: Vertex ids of each stencil (padded with -1).
+                dim: Dimension of the vertices.
+                ndof: Number of rows and columns of the Hessian.
+            )ipc_Qu8mg5v7",
+            py::arg("stencils"), py::arg("dim"), py::arg("ndof"))
+        .def(
+            "is_built_for", &HessianPattern::is_built_for,
+            R"ipc_Qu8mg5v7(
+            Determine if the pattern was built for the given stencils.
+
+            Parameters:
+                stencils: Vertex ids of each stencil (padded with -1).
+                dim: Dimension of the vertices.
+                ndof: Number of rows and columns of the Hessian.
+
+            Returns:
+                True if the pattern can be reused for the stencils.
+            )ipc_Qu8mg5v7",
+            py::arg("stencils"), py::arg("dim"), py::arg("ndof"))
+        .def("clear", &HessianPattern::clear, "Remove the pattern.")
+        .def_property_readonly(
+            "num_stencils", &HessianPattern::num_stencils,
+            "Number of stencils.")
+        .def_property_readonly(
+            "dim", &HessianPattern::dim, "Dimension of the vertices.")
+        .def("nonZeros", &HessianPattern::nonZeros, "Number of stored nonzeros.")
+        .def_property_readonly(
+            "matrix", &HessianPattern::matrix,
+            "The global Hessian (as of the last assembly).");
+}
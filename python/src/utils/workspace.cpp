@@ -0,0 +1,23 @@
+#include <common.hpp>
+
+#include <ipc/utils/workspace.hpp>
+
+namespace py = pybind11;
+using namespace ipc;
+
+void define_workspace(py::module_& m)
+{
+    py::class_<Workspace, std::shared_ptr<Workspace>>(
+        m, "Workspace",
+        R"ipc_Qu8mg5v7(
+        Persistent scratch buffers that are reused across calls.
+
+        Passing the same workspace to successive calls (e.g., once per time step) lets temporary and thread-local buffers keep their capacity, so the steady state does not allocate.
+
+        Note:
+            A workspace may be shared by several objects, but it must not be used by two operations running at the same time.
+        )ipc_Qu8mg5v7")
+        .def(py::init())
+        .def("__len__", &Workspace::size, "Number of persistent buffers.")
+        .def("clear", &Workspace::clear, "Release all buffers.");
+}
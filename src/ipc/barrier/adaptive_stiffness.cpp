@@ -6,6 +6,9 @@
 #include <ipc/candidates/candidates.hpp>
 #include <ipc/collisions/normal/normal_collisions.hpp>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
 #include <algorithm> // std::min/max
 #include <cassert>
 
@@ -122,6 +125,56 @@ double semi_implicit_stiffness(
     return avg_mass / distance_sqr + w.dot(local_hess * w);
 }
 
+namespace {
+    /// @brief Compute the semi-implicit stiffness's for all collisions.
+    /// @param use_full_ids Whether the elasticity hessian is for the full mesh.
+    /// @param local_hessian Gather the local elasticity hessian of a stencil from its vertex ids and number of vertices.
+    template <typename StencilsT, typename LocalHessian>
+    Eigen::VectorXd semi_implicit_stiffness_impl(
+        const CollisionMesh& mesh,
+        Eigen::ConstRef<Eigen::MatrixXd> vertices,
+        const StencilsT& collisions,
+        Eigen::ConstRef<Eigen::VectorXd> vertex_masses,
+        const bool use_full_ids,
+        LocalHessian&& local_hessian,
+        const double dmin)
+    {
+        Eigen::VectorXd stiffnesses(collisions.size());
+
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(size_t(0), collisions.size()),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t ci = r.begin(); ci < r.end(); ci++) {
+                    const CollisionStencil& collision = collisions[ci];
+                    const unsigned N = collision.num_vertices();
+
+                    const VectorMax12d positions =
+                        collision.dof(vertices, mesh.edges(), mesh.faces());
+
+                    std::array<long, 4> vertex_ids =
+                        collision.vertex_ids(mesh.edges(), mesh.faces());
+                    if (use_full_ids) {
+                        for (int i = 0; i < N; i++) {
+                            vertex_ids[i] =
+                                mesh.to_full_vertex_id(vertex_ids[i]);
+                        }
+                    }
+
+                    VectorMax4d local_mass(N);
+                    for (unsigned i = 0; i < N; i++) {
+                        local_mass[i] = vertex_masses[vertex_ids[i]];
+                    }
+
+                    stiffnesses[ci] = semi_implicit_stiffness(
+                        collision, vertex_ids, positions, local_mass,
+                        local_hessian(vertex_ids, N), dmin);
+                }
+            });
+
+        return stiffnesses;
+    }
+} // namespace
+
 template <typename StencilsT>
 Eigen::VectorXd semi_implicit_stiffness(
     const CollisionMesh& mesh,
@@ -139,46 +192,59 @@ Eigen::VectorXd semi_implicit_stiffness(
     // Hess can be either for the reduced or full mesh
     assert(hess.rows() == mesh.ndof() || hess.rows() == mesh.full_ndof());
 
-    Eigen::VectorXd stiffnesses(collisions.size());
-
-    for (size_t ci = 0; ci < collisions.size(); ci++) {
-        const CollisionStencil& collision = collisions[ci];
-        const unsigned N = collision.num_vertices();
-
-        const VectorMax12d positions =
-            collision.dof(vertices, mesh.edges(), mesh.faces());
-
-        std::array<long, 4> vertex_ids =
-            collision.vertex_ids(mesh.edges(), mesh.faces());
-        if (hess.rows() == mesh.full_ndof()) {
-            for (int i = 0; i < N; i++) {
-                vertex_ids[i] = mesh.to_full_vertex_id(vertex_ids[i]);
-            }
-        }
-
-        VectorMax4d local_mass(collision.num_vertices());
-        for (unsigned i = 0; i < collision.num_vertices(); i++) {
-            local_mass[i] = vertex_masses[vertex_ids[i]];
-        }
-
-        MatrixMax12d local_hess = MatrixMax12d::Zero(dim * N, dim * N);
-        for (unsigned i = 0; i < N; ++i) {
-            for (unsigned j = 0; j < N; ++j) {
-                for (unsigned k = 0; k < dim; ++k) {
-                    for (unsigned l = 0; l < dim; ++l) {
-                        // NOTE: Assumes DOF are flattened in row-major order
-                        local_hess(dim * i + k, dim * j + l) = hess.coeff(
-                            dim * vertex_ids[i] + k, dim * vertex_ids[j] + l);
+    return semi_implicit_stiffness_impl(
+        mesh, vertices, collisions, vertex_masses,
+        hess.rows() == mesh.full_ndof(),
+        [&](const std::array<long, 4>& vertex_ids, const unsigned N) {
+            MatrixMax12d local_hess = MatrixMax12d::Zero(dim * N, dim * N);
+            for (unsigned i = 0; i < N; ++i) {
+                for (unsigned j = 0; j < N; ++j) {
+                    for (unsigned k = 0; k < dim; ++k) {
+                        for (unsigned l = 0; l < dim; ++l) {
+                            // NOTE: Assumes DOF are flattened row-major
+                            local_hess(dim * i + k, dim * j + l) = hess.coeff(
+                                dim * vertex_ids[i] + k,
+                                dim * vertex_ids[j] + l);
+                        }
                     }
                 }
             }
-        }
-
-        stiffnesses[ci] = semi_implicit_stiffness(
-            collision, vertex_ids, positions, local_mass, local_hess, dmin);
-    }
+            return local_hess;
+        },
+        dmin);
+}
 
-    return stiffnesses;
+template <typename StencilsT>
+Eigen::VectorXd semi_implicit_stiffness(
+    const CollisionMesh& mesh,
+    Eigen::ConstRef<Eigen::MatrixXd> vertices,
+    const StencilsT& collisions,
+    Eigen::ConstRef<Eigen::VectorXd> vertex_masses,
+    Eigen::ConstRef<Eigen::MatrixXd> hess_diagonal_blocks,
+    const double dmin)
+{
+    const int dim = mesh.dim();
+    assert(vertices.cols() == dim); // Vertex positions must be 3D
+    assert(hess_diagonal_blocks.cols() == dim); // Blocks must be dim×dim
+    // Blocks and vertex_masses must have the same number of rows
+    assert(hess_diagonal_blocks.rows() == vertex_masses.size() * dim);
+    // Blocks can be either for the reduced or full mesh
+    assert(
+        hess_diagonal_blocks.rows() == mesh.ndof()
+        || hess_diagonal_blocks.rows() == mesh.full_ndof());
+
+    return semi_implicit_stiffness_impl(
+        mesh, vertices, collisions, vertex_masses,
+        hess_diagonal_blocks.rows() == mesh.full_ndof(),
+        [&](const std::array<long, 4>& vertex_ids, const unsigned N) {
+            MatrixMax12d local_hess = MatrixMax12d::Zero(dim * N, dim * N);
+            for (unsigned i = 0; i < N; ++i) {
+                local_hess.block(dim * i, dim * i, dim, dim) =
+                    hess_diagonal_blocks.middleRows(dim * vertex_ids[i], dim);
+            }
+            return local_hess;
+        },
+        dmin);
 }
 
 template Eigen::VectorXd semi_implicit_stiffness<NormalCollisions>(
@@ -197,6 +263,22 @@ template Eigen::VectorXd semi_implicit_stiffness<Candidates>(
     const Eigen::SparseMatrix<double>& hess,
     const double dmin);
 
+template Eigen::VectorXd semi_implicit_stiffness<NormalCollisions>(
+    const CollisionMesh& mesh,
+    Eigen::ConstRef<Eigen::MatrixXd> vertices,
+    const NormalCollisions& collisions,
+    Eigen::ConstRef<Eigen::VectorXd> vertex_masses,
+    Eigen::ConstRef<Eigen::MatrixXd> hess_diagonal_blocks,
+    const double dmin);
+
+template Eigen::VectorXd semi_implicit_stiffness<Candidates>(
+    const CollisionMesh& mesh,
+    Eigen::ConstRef<Eigen::MatrixXd> vertices,
+    const Candidates& collisions,
+    Eigen::ConstRef<Eigen::VectorXd> vertex_masses,
+    Eigen::ConstRef<Eigen::MatrixXd> hess_diagonal_blocks,
+    const double dmin);
+
 // -----------------------------------------------------------------------------
 
 } // namespace ipc
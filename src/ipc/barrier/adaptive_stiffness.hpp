@@ -85,4 +85,23 @@ Eigen::VectorXd semi_implicit_stiffness(
     const Eigen::SparseMatrix<double>& hess,
     const double dmin);
 
+/// @brief Compute the semi-implicit stiffness's for all collisions from the diagonal blocks of the elasticity hessian.
+/// See [Ando 2024] for details.
+/// @note The coupling between the vertices of a stencil is ignored, so the full hessian never needs to be assembled (e.g., when it is only available as diagonal blocks for a block-Jacobi preconditioner).
+/// @param mesh Collision mesh.
+/// @param vertices Vertex positions.
+/// @param collisions Normal collisions or collision candidates.
+/// @param vertex_masses Lumped vertex masses.
+/// @param hess_diagonal_blocks Vertex dim×dim diagonal blocks of the hessian of the elasticity energy function stacked vertically (see Potential::hessian_block_diagonal).
+/// @param dmin Minimum distance between elements.
+/// @return The semi-implicit stiffness's.
+template <typename StencilsT>
+Eigen::VectorXd semi_implicit_stiffness(
+    const CollisionMesh& mesh,
+    Eigen::ConstRef<Eigen::MatrixXd> vertices,
+    const StencilsT& collisions,
+    Eigen::ConstRef<Eigen::VectorXd> vertex_masses,
+    Eigen::ConstRef<Eigen::MatrixXd> hess_diagonal_blocks,
+    const double dmin);
+
 } // namespace ipc
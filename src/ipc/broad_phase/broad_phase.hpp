@@ -8,6 +8,7 @@
 #include <ipc/candidates/face_face.hpp>
 #include <ipc/candidates/face_vertex.hpp>
 #include <ipc/candidates/vertex_vertex.hpp>
+#include <ipc/utils/workspace.hpp>
 
 #include <Eigen/Core>
 
@@ -90,6 +91,11 @@ public:
     std::function<bool(size_t, size_t)> can_vertices_collide =
         default_can_vertices_collide;
 
+    /// @brief Optional persistent buffers reused across detections.
+    /// If set, the thread-local candidate storage keeps its capacity between
+    /// calls instead of being reallocated.
+    std::shared_ptr<Workspace> workspace;
+
 protected:
     virtual bool can_edge_vertex_collide(size_t ei, size_t vi) const;
     virtual bool can_edges_collide(size_t eai, size_t ebi) const;
@@ -104,4 +110,32 @@ protected:
     std::vector<AABB> face_boxes;
 };
 
+/// @brief Replace the vertex filter of a broad phase for the current scope.
+///
+/// The previous filter is restored on destruction, also when an exception is
+/// thrown, so a filter capturing local variables never outlives them.
+class ScopedVertexFilter {
+public:
+    ScopedVertexFilter(
+        BroadPhase& broad_phase,
+        std::function<bool(size_t, size_t)> can_vertices_collide)
+        : m_broad_phase(broad_phase)
+        , m_previous(std::move(broad_phase.can_vertices_collide))
+    {
+        m_broad_phase.can_vertices_collide = std::move(can_vertices_collide);
+    }
+
+    ~ScopedVertexFilter()
+    {
+        m_broad_phase.can_vertices_collide = std::move(m_previous);
+    }
+
+    ScopedVertexFilter(const ScopedVertexFilter&) = delete;
+    ScopedVertexFilter& operator=(const ScopedVertexFilter&) = delete;
+
+private:
+    BroadPhase& m_broad_phase;
+    std::function<bool(size_t, size_t)> m_previous;
+};
+
 } // namespace ipc
@@ -19,7 +19,8 @@ void BruteForce::detect_candidates(
     const std::function<bool(size_t, size_t)>& can_collide,
     std::vector<Candidate>& candidates) const
 {
-    tbb::enumerable_thread_specific<std::vector<Candidate>> storage;
+    tbb::enumerable_thread_specific<std::vector<Candidate>> local_storage;
+    auto& storage = thread_local_storage(workspace.get(), local_storage);
 
     tbb::parallel_for(
         tbb::blocked_range2d<size_t>(0ul, boxes0.size(), 0ul, boxes1.size()),
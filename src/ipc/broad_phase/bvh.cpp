@@ -60,21 +60,23 @@ void BVH::detect_candidates(
     const std::vector<AABB>& boxes,
     const SimpleBVH::BVH& bvh,
     const std::function<bool(size_t, size_t)>& can_collide,
-    std::vector<Candidate>& candidates)
+    std::vector<Candidate>& candidates) const
 {
     // O(n^2) or O(n^3) to build
     // O(klog(n)) to do a single look up
     // O(knlog(n)) to do all look ups
 
-    tbb::enumerable_thread_specific<std::vector<Candidate>> storage;
+    tbb::enumerable_thread_specific<std::vector<Candidate>> local_storage;
+    auto& storage = thread_local_storage(workspace.get(), local_storage);
 
     tbb::parallel_for(
         tbb::blocked_range<size_t>(size_t(0), boxes.size()),
         [&](const tbb::blocked_range<size_t>& r) {
             auto& local_candidates = storage.local();
 
+            std::vector<unsigned int> js; // reused across queries
             for (size_t i = r.begin(); i < r.end(); i++) {
-                std::vector<unsigned int> js;
+                js.clear();
                 bvh.intersect_box(boxes[i].min, boxes[i].max, js);
 
                 for (const unsigned int j : js) {
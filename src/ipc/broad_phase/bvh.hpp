@@ -89,11 +89,11 @@ protected:
         typename Candidate,
         bool swap_order = false,
         bool triangular = false>
-    static void detect_candidates(
+    void detect_candidates(
         const std::vector<AABB>& boxes,
         const SimpleBVH::BVH& bvh,
         const std::function<bool(size_t, size_t)>& can_collide,
-        std::vector<Candidate>& candidates);
+        std::vector<Candidate>& candidates) const;
 
     /// @brief BVH containing the vertices.
     SimpleBVH::BVH vertex_bvh;
@@ -92,7 +92,8 @@ void HashGrid::insert_boxes()
 void HashGrid::insert_boxes(
     const std::vector<AABB>& boxes, std::vector<HashItem>& items) const
 {
-    tbb::enumerable_thread_specific<std::vector<HashItem>> storage;
+    tbb::enumerable_thread_specific<std::vector<HashItem>> local_storage;
+    auto& storage = thread_local_storage(workspace.get(), local_storage);
 
     tbb::parallel_for(
         tbb::blocked_range<long>(0l, long(boxes.size())),
@@ -152,7 +153,11 @@ void HashGrid::detect_candidates(
 
     // 1. Soft merge of items (assuming items are sorted)
     size_t num_items = items0.size() + items1.size();
-    std::vector<long> merged_item_indices;
+    std::vector<long> local_merged_item_indices;
+    std::vector<long>& merged_item_indices = workspace
+        ? workspace->get<std::vector<long>>()
+        : local_merged_item_indices;
+    merged_item_indices.clear();
     merged_item_indices.reserve(num_items);
     {
         long i = 0, j = 0;
@@ -178,10 +183,11 @@ void HashGrid::detect_candidates(
 
     // 2. Enumerate hash collisions
 #ifdef IPC_TOOLKIT_HASH_GRID_USE_SORT_UNIQUE
-    tbb::enumerable_thread_specific<std::vector<Candidate>> storage;
+    tbb::enumerable_thread_specific<std::vector<Candidate>> local_storage;
 #else
-    tbb::enumerable_thread_specific<unordered_set<Candidate>> storage;
+    tbb::enumerable_thread_specific<unordered_set<Candidate>> local_storage;
 #endif
+    auto& storage = thread_local_storage(workspace.get(), local_storage);
 
     tbb::parallel_for(
         tbb::blocked_range2d<long>(0l, num_items - 1, 0l, num_items),
@@ -235,7 +241,11 @@ void HashGrid::detect_candidates(
     auto new_end = std::unique(candidates.begin(), candidates.end());
     candidates.erase(new_end, candidates.end());
 #else
-    unordered_set<Candidate> candidates_set;
+    unordered_set<Candidate> local_candidates_set;
+    unordered_set<Candidate>& candidates_set = workspace
+        ? workspace->get<unordered_set<Candidate>>()
+        : local_candidates_set;
+    candidates_set.clear();
     merge_thread_local_unordered_sets(storage, candidates_set);
 
     candidates.reserve(candidates_set.size());
@@ -257,10 +267,11 @@ void HashGrid::detect_candidates(
     // (key,value) pairs creating Candidate entries for pairs with the same key
 
 #ifdef IPC_TOOLKIT_HASH_GRID_USE_SORT_UNIQUE
-    tbb::enumerable_thread_specific<std::vector<Candidate>> storage;
+    tbb::enumerable_thread_specific<std::vector<Candidate>> local_storage;
 #else
-    tbb::enumerable_thread_specific<unordered_set<Candidate>> storage;
+    tbb::enumerable_thread_specific<unordered_set<Candidate>> local_storage;
 #endif
+    auto& storage = thread_local_storage(workspace.get(), local_storage);
 
     tbb::parallel_for(
         tbb::blocked_range2d<long>(0l, items.size() - 1, 0l, items.size()),
@@ -307,7 +318,11 @@ void HashGrid::detect_candidates(
     auto new_end = std::unique(candidates.begin(), candidates.end());
     candidates.erase(new_end, candidates.end());
 #else
-    unordered_set<Candidate> candidates_set;
+    unordered_set<Candidate> local_candidates_set;
+    unordered_set<Candidate>& candidates_set = workspace
+        ? workspace->get<unordered_set<Candidate>>()
+        : local_candidates_set;
+    candidates_set.clear();
     merge_thread_local_unordered_sets(storage, candidates_set);
 
     candidates.reserve(candidates_set.size());
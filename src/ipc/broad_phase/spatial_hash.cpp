@@ -274,15 +274,16 @@ void SpatialHash::detect_candidates(
     const std::function<bool(int, int)>& can_collide,
     std::vector<Candidate>& candidates) const
 {
-    tbb::enumerable_thread_specific<std::vector<Candidate>> storage;
+    tbb::enumerable_thread_specific<std::vector<Candidate>> local_storage;
+    auto& storage = thread_local_storage(workspace.get(), local_storage);
 
     tbb::parallel_for(
         tbb::blocked_range<size_t>(size_t(0), boxesA.size()),
         [&](const tbb::blocked_range<size_t>& range) {
             auto& local_candidates = storage.local();
 
+            unordered_set<int> js; // reused across queries (cleared by query)
             for (size_t i = range.begin(); i != range.end(); i++) {
-                unordered_set<int> js;
                 query_A_for_Bs(i, js);
 
                 for (const int j : js) {
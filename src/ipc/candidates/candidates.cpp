@@ -3,13 +3,17 @@
 #include <ipc/config.hpp>
 #include <ipc/ipc.hpp>
 #include <ipc/broad_phase/default_broad_phase.hpp>
+#include <ipc/candidates/compact_candidates.hpp>
 #include <ipc/utils/eigen_ext.hpp>
 #include <ipc/utils/save_obj.hpp>
+#include <ipc/utils/unordered_map_and_set.hpp>
 
 #include <igl/remove_unreferenced.h>
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
 
+#include <algorithm>
 #include <fstream>
 #include <shared_mutex>
 
@@ -30,6 +34,60 @@ namespace {
     {
         return E_padded.leftCols(2);
     }
+
+    /// @brief Remove the new candidates already in candidates and append the rest.
+    template <typename Candidate>
+    void append_new_candidates(
+        std::vector<Candidate>& candidates,
+        std::vector<Candidate>& new_candidates)
+    {
+        if (candidates.empty() || new_candidates.empty()) {
+            candidates.insert(
+                candidates.end(), new_candidates.begin(),
+                new_candidates.end());
+            return;
+        }
+
+        const unordered_set<Candidate> existing(
+            candidates.begin(), candidates.end());
+        new_candidates.erase(
+            std::remove_if(
+                new_candidates.begin(), new_candidates.end(),
+                [&](const Candidate& c) { return existing.count(c) > 0; }),
+            new_candidates.end());
+        candidates.insert(
+            candidates.end(), new_candidates.begin(), new_candidates.end());
+    }
+
+    /// Remove the candidates whose primitives cannot collide, using the same
+    /// check as the broad phase: the primitives can collide if any vertex of
+    /// the first can collide with any vertex of the second.
+    /// @param num_first_vertices Number of vertices of the first primitive.
+    template <typename Candidate>
+    void remove_candidates_that_cannot_collide(
+        const CollisionMesh& mesh,
+        const int num_first_vertices,
+        std::vector<Candidate>& candidates)
+    {
+        const Eigen::MatrixXi& E = mesh.edges();
+        const Eigen::MatrixXi& F = mesh.faces();
+        candidates.erase(
+            std::remove_if(
+                candidates.begin(), candidates.end(),
+                [&](const Candidate& c) {
+                    const std::array<long, 4> vids = c.vertex_ids(E, F);
+                    for (int i = 0; i < num_first_vertices; i++) {
+                        for (int j = num_first_vertices; j < 4 && vids[j] >= 0;
+                             j++) {
+                            if (mesh.can_collide(vids[i], vids[j])) {
+                                return false;
+                            }
+                        }
+                    }
+                    return true;
+                }),
+            candidates.end());
+    }
 } // namespace
 
 void Candidates::build(
@@ -225,6 +283,30 @@ double Candidates::compute_collision_free_stepsize(
         return 1; // No possible collisions, so can take full step.
     }
 
+    // Dispatch on the index ranges instead of virtual calls, reading the
+    // candidates in place.
+    return CompactCandidates::compute_collision_free_stepsize(
+        *this, mesh, vertices_t0, vertices_t1, min_distance, narrow_phase_ccd);
+}
+
+double Candidates::compute_nonlinear_collision_free_stepsize(
+    const CollisionMesh& mesh,
+    const std::vector<const NonlinearTrajectory*>& trajectories,
+    const double min_distance,
+    const double tolerance,
+    const long max_iterations,
+    const double conservative_rescaling) const
+{
+    assert(trajectories.size() == mesh.num_vertices());
+
+    if (empty()) {
+        return 1; // No possible collisions, so can take full step.
+    }
+
+    const size_t num_vv = vv_candidates.size();
+    const size_t num_ev = ev_candidates.size();
+    const size_t num_ee = ee_candidates.size();
+
     double earliest_toi = 1;
     std::shared_mutex earliest_toi_mutex;
 
@@ -240,13 +322,36 @@ double Candidates::compute_collision_free_stepsize(
                     tmax = earliest_toi;
                 }
 
-                const CollisionStencil& candidate = (*this)[i];
+                const std::array<long, 4> vids =
+                    (*this)[i].vertex_ids(mesh.edges(), mesh.faces());
+                const auto trajectory = [&](int j) -> const auto& {
+                    assert(trajectories[vids[j]] != nullptr);
+                    return *trajectories[vids[j]];
+                };
 
+                // Dispatch on the candidate type (see operator[])
                 double toi = std::numeric_limits<double>::infinity(); // output
-                const bool are_colliding = candidate.ccd(
-                    candidate.dof(vertices_t0, mesh.edges(), mesh.faces()),
-                    candidate.dof(vertices_t1, mesh.edges(), mesh.faces()), //
-                    toi, min_distance, tmax, narrow_phase_ccd);
+                bool are_colliding;
+                if (i < num_vv) {
+                    are_colliding = point_point_nonlinear_ccd(
+                        trajectory(0), trajectory(1), toi, tmax, min_distance,
+                        tolerance, max_iterations, conservative_rescaling);
+                } else if (i < num_vv + num_ev) {
+                    are_colliding = point_edge_nonlinear_ccd(
+                        trajectory(0), trajectory(1), trajectory(2), toi, tmax,
+                        min_distance, tolerance, max_iterations,
+                        conservative_rescaling);
+                } else if (i < num_vv + num_ev + num_ee) {
+                    are_colliding = edge_edge_nonlinear_ccd(
+                        trajectory(0), trajectory(1), trajectory(2),
+                        trajectory(3), toi, tmax, min_distance, tolerance,
+                        max_iterations, conservative_rescaling);
+                } else {
+                    are_colliding = point_triangle_nonlinear_ccd(
+                        trajectory(0), trajectory(1), trajectory(2),
+                        trajectory(3), toi, tmax, min_distance, tolerance,
+                        max_iterations, conservative_rescaling);
+                }
 
                 if (are_colliding) {
                     std::unique_lock lock(earliest_toi_mutex);
@@ -261,39 +366,98 @@ double Candidates::compute_collision_free_stepsize(
     return earliest_toi;
 }
 
-double Candidates::compute_noncandidate_conservative_stepsize(
+Eigen::VectorXd Candidates::compute_per_candidate_toi(
     const CollisionMesh& mesh,
-    Eigen::ConstRef<Eigen::MatrixXd> displacements,
-    const double dhat) const
+    Eigen::ConstRef<Eigen::MatrixXd> vertices_t0,
+    Eigen::ConstRef<Eigen::MatrixXd> vertices_t1,
+    const double min_distance,
+    const NarrowPhaseCCD& narrow_phase_ccd) const
 {
-    assert(displacements.rows() == mesh.num_vertices());
+    assert(vertices_t0.rows() == mesh.num_vertices());
+    assert(vertices_t1.rows() == mesh.num_vertices());
 
-    if (empty()) {
-        return 1; // No possible collisions, so can take full step.
-    }
+    Eigen::VectorXd tois(size());
+
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, size()),
+        [&](tbb::blocked_range<size_t> r) {
+            for (size_t i = r.begin(); i < r.end(); i++) {
+                const CollisionStencil& candidate = (*this)[i];
+
+                double toi = std::numeric_limits<double>::infinity(); // output
+                const bool are_colliding = candidate.ccd(
+                    candidate.dof(vertices_t0, mesh.edges(), mesh.faces()),
+                    candidate.dof(vertices_t1, mesh.edges(), mesh.faces()), //
+                    toi, min_distance, /*tmax=*/1.0, narrow_phase_ccd);
+
+                tois[i] = are_colliding ? std::min(toi, 1.0) : 1.0;
+            }
+        });
+
+    return tois;
+}
+
+Eigen::VectorXd Candidates::compute_per_vertex_collision_free_stepsize(
+    const CollisionMesh& mesh,
+    Eigen::ConstRef<Eigen::MatrixXd> vertices_t0,
+    Eigen::ConstRef<Eigen::MatrixXd> vertices_t1,
+    const double min_distance,
+    const NarrowPhaseCCD& narrow_phase_ccd) const
+{
+    const Eigen::VectorXd tois = compute_per_candidate_toi(
+        mesh, vertices_t0, vertices_t1, min_distance, narrow_phase_ccd);
 
     const Eigen::MatrixXi& E = mesh.edges();
     const Eigen::MatrixXi& F = mesh.faces();
 
-    std::vector<bool> is_vertex_a_candidates(mesh.num_vertices(), false);
+    Eigen::VectorXd vertex_stepsizes =
+        Eigen::VectorXd::Ones(mesh.num_vertices());
     for (size_t i = 0; i < size(); i++) {
+        if (tois[i] >= 1.0) {
+            continue; // Skip the vertex ids lookup for non-colliding candidates
+        }
         for (const long vid : (*this)[i].vertex_ids(E, F)) {
             if (vid < 0) {
                 break;
             }
-            is_vertex_a_candidates[vid] = true;
+            vertex_stepsizes[vid] = std::min(vertex_stepsizes[vid], tois[i]);
         }
     }
 
-    double max_displacement = 0;
-    for (size_t i = 0; i < displacements.rows(); i++) {
-        if (!is_vertex_a_candidates[i]) {
-            continue;
-        }
-        max_displacement =
-            std::max(max_displacement, displacements.row(i).norm());
+    return vertex_stepsizes;
+}
+
+double Candidates::compute_noncandidate_conservative_stepsize(
+    const CollisionMesh& mesh,
+    Eigen::ConstRef<Eigen::MatrixXd> displacements,
+    const double dhat) const
+{
+    assert(displacements.rows() == mesh.num_vertices());
+
+    if (empty()) {
+        return 1; // No possible collisions, so can take full step.
     }
 
+    const Eigen::MatrixXi& E = mesh.edges();
+    const Eigen::MatrixXi& F = mesh.faces();
+
+    // Maximum displacement of the vertices of any candidate
+    const double max_displacement = std::sqrt(tbb::parallel_reduce(
+        tbb::blocked_range<size_t>(0, size()), 0.0,
+        [&](const tbb::blocked_range<size_t>& r, double max_sqr_d) {
+            for (size_t i = r.begin(); i < r.end(); i++) {
+                for (const long vid : (*this)[i].vertex_ids(E, F)) {
+                    if (vid < 0) {
+                        break;
+                    }
+                    max_sqr_d = std::max(
+                        max_sqr_d, displacements.row(vid).squaredNorm());
+                }
+            }
+            return max_sqr_d;
+        },
+        [](double a, double b) { return std::max(a, b); }));
+
     return 0.5 * dhat / max_displacement;
 }
 
@@ -324,6 +488,224 @@ double Candidates::compute_cfl_stepsize(
     return std::min(alpha_C, alpha_F);
 }
 
+double Candidates::compute_incremental_cfl_stepsize(
+    const CollisionMesh& mesh,
+    Eigen::ConstRef<Eigen::MatrixXd> vertices_t0,
+    Eigen::ConstRef<Eigen::MatrixXd> vertices_t1,
+    const double dhat,
+    const double min_distance,
+    const std::shared_ptr<BroadPhase> broad_phase,
+    const NarrowPhaseCCD& narrow_phase_ccd)
+{
+    assert(broad_phase != nullptr);
+    assert(vertices_t0.rows() == mesh.num_vertices());
+    assert(vertices_t1.rows() == mesh.num_vertices());
+
+    const double alpha_C = this->compute_collision_free_stepsize(
+        mesh, vertices_t0, vertices_t1, min_distance, narrow_phase_ccd);
+
+    // Pairs not in the candidates are at least dhat apart, so they cannot
+    // collide before alpha_C if both move less than dhat / 2 by then.
+    const double max_slow_displacement = 0.5 * dhat / alpha_C;
+    std::vector<uint8_t> is_fast(mesh.num_vertices());
+    const size_t num_fast = tbb::parallel_reduce(
+        tbb::blocked_range<size_t>(0, mesh.num_vertices()), size_t(0),
+        [&](const tbb::blocked_range<size_t>& r, size_t count) {
+            for (size_t vi = r.begin(); vi < r.end(); vi++) {
+                is_fast[vi] =
+                    (vertices_t1.row(vi) - vertices_t0.row(vi)).norm()
+                    > max_slow_displacement;
+                count += is_fast[vi];
+            }
+            return count;
+        },
+        std::plus<size_t>());
+
+    if (num_fast == 0) {
+        return alpha_C;
+    }
+
+    if (mesh.num_codim_vertices()) {
+        // The codimensional candidates are built from separate broad phases,
+        // so do full CCD.
+        return ipc::compute_collision_free_stepsize(
+            mesh, vertices_t0, vertices_t1, min_distance, broad_phase,
+            narrow_phase_ccd);
+    }
+
+    // Only primitives overlapping the region swept by the fast primitives can
+    // form a new candidate, so the broad phase is built on those alone.
+    const double inflation_radius = 0.5 * min_distance;
+    const Eigen::MatrixXi& E = mesh.edges();
+    const Eigen::MatrixXi& F = mesh.faces();
+    std::vector<AABB> vertex_boxes, edge_boxes, face_boxes;
+    build_vertex_boxes(
+        vertices_t0, vertices_t1, vertex_boxes, inflation_radius);
+    build_edge_boxes(vertex_boxes, E, edge_boxes);
+    build_face_boxes(vertex_boxes, F, face_boxes);
+
+    const auto is_fast_primitive = [&](const auto& ids) {
+        return std::any_of(ids.begin(), ids.end(), [&](long vi) {
+            return vi >= 0 && is_fast[vi];
+        });
+    };
+
+    AABB fast_region = vertex_boxes[std::distance(
+        is_fast.begin(), std::find(is_fast.begin(), is_fast.end(), 1))];
+    for (const std::vector<AABB>* boxes :
+         { &vertex_boxes, &edge_boxes, &face_boxes }) {
+        for (const AABB& box : *boxes) {
+            if (is_fast_primitive(box.vertex_ids)) {
+                fast_region = AABB(fast_region, box);
+            }
+        }
+    }
+
+    // Map between the vertices/edges/faces of the mesh and of the region.
+    std::vector<long> local_vertex_ids(mesh.num_vertices(), -1);
+    std::vector<long> vertex_ids, edge_ids, face_ids;
+    const auto add_vertex = [&](long vi) {
+        if (local_vertex_ids[vi] < 0) {
+            local_vertex_ids[vi] = vertex_ids.size();
+            vertex_ids.push_back(vi);
+        }
+    };
+    for (size_t vi = 0; vi < vertex_boxes.size(); vi++) {
+        if (vertex_boxes[vi].intersects(fast_region)) {
+            add_vertex(vi);
+        }
+    }
+    for (size_t ei = 0; ei < edge_boxes.size(); ei++) {
+        if (edge_boxes[ei].intersects(fast_region)) {
+            edge_ids.push_back(ei);
+            add_vertex(E(ei, 0));
+            add_vertex(E(ei, 1));
+        }
+    }
+    for (size_t fi = 0; fi < face_boxes.size(); fi++) {
+        if (face_boxes[fi].intersects(fast_region)) {
+            face_ids.push_back(fi);
+            add_vertex(F(fi, 0));
+            add_vertex(F(fi, 1));
+            add_vertex(F(fi, 2));
+        }
+    }
+
+    Eigen::MatrixXi local_E(edge_ids.size(), E.cols());
+    for (size_t i = 0; i < edge_ids.size(); i++) {
+        for (int j = 0; j < E.cols(); j++) {
+            local_E(i, j) = local_vertex_ids[E(edge_ids[i], j)];
+        }
+    }
+    Eigen::MatrixXi local_F(face_ids.size(), F.cols());
+    for (size_t i = 0; i < face_ids.size(); i++) {
+        for (int j = 0; j < F.cols(); j++) {
+            local_F(i, j) = local_vertex_ids[F(face_ids[i], j)];
+        }
+    }
+
+    // Broad phase restricted to pairs involving a fast vertex. The broad phase
+    // combines the vertex pairs of two primitives with OR, so the mesh's
+    // can_collide cannot be folded into this filter without dropping pairs
+    // that can collide through their slow vertices. Apply it afterwards.
+    Candidates new_candidates;
+    {
+        const ScopedVertexFilter filter(
+            *broad_phase, [&](size_t vi, size_t vj) {
+                return is_fast[vertex_ids[vi]] || is_fast[vertex_ids[vj]];
+            });
+        broad_phase->build(
+            vertices_t0(vertex_ids, Eigen::all),
+            vertices_t1(vertex_ids, Eigen::all), local_E, local_F,
+            inflation_radius);
+        broad_phase->detect_collision_candidates(
+            vertices_t0.cols(), new_candidates);
+        broad_phase->clear();
+    }
+
+    for (auto& [ei, vi] : new_candidates.ev_candidates) {
+        ei = edge_ids[ei];
+        vi = vertex_ids[vi];
+    }
+    for (auto& [eai, ebi] : new_candidates.ee_candidates) {
+        eai = edge_ids[eai];
+        ebi = edge_ids[ebi];
+    }
+    for (auto& [fi, vi] : new_candidates.fv_candidates) {
+        fi = face_ids[fi];
+        vi = vertex_ids[vi];
+    }
+
+    remove_candidates_that_cannot_collide(
+        mesh, 1, new_candidates.ev_candidates);
+    remove_candidates_that_cannot_collide(
+        mesh, 2, new_candidates.ee_candidates);
+    remove_candidates_that_cannot_collide(
+        mesh, 1, new_candidates.fv_candidates);
+
+    // Skip the candidates already checked
+    append_new_candidates(ev_candidates, new_candidates.ev_candidates);
+    append_new_candidates(ee_candidates, new_candidates.ee_candidates);
+    append_new_candidates(fv_candidates, new_candidates.fv_candidates);
+
+    const double alpha_new = new_candidates.compute_collision_free_stepsize(
+        mesh, vertices_t0, vertices_t1, min_distance, narrow_phase_ccd);
+
+    return std::min(alpha_C, alpha_new);
+}
+
+void Candidates::build(
+    const CollisionMesh& mesh,
+    const std::vector<const NonlinearTrajectory*>& trajectories,
+    const double inflation_radius,
+    const std::shared_ptr<BroadPhase> broad_phase,
+    const int num_samples)
+{
+    assert(trajectories.size() == mesh.num_vertices());
+    assert(num_samples >= 1);
+
+    if (trajectories.empty()) {
+        clear();
+        return;
+    }
+
+    const int dim = (*trajectories[0])(0).size();
+
+    // Each piece of the trajectory between two samples is within
+    // max_distance_from_linear of the segment connecting the samples, which
+    // in turn lies in the box of the samples. The box of a point moving from
+    // the lower to the upper corner is the box itself, so the linear broad
+    // phase can be reused as is.
+    Eigen::MatrixXd lower(trajectories.size(), dim);
+    Eigen::MatrixXd upper(trajectories.size(), dim);
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, trajectories.size()),
+        [&](const tbb::blocked_range<size_t>& r) {
+            for (size_t vi = r.begin(); vi < r.end(); vi++) {
+                assert(trajectories[vi] != nullptr);
+                const NonlinearTrajectory& trajectory = *trajectories[vi];
+
+                ArrayMax3d min = trajectory(0).array(), max = min;
+                double max_deviation = 0;
+                for (int i = 1; i <= num_samples; i++) {
+                    const double t0 = (i - 1) / double(num_samples);
+                    const double t1 = i / double(num_samples);
+                    const ArrayMax3d p = trajectory(t1).array();
+                    min = min.min(p);
+                    max = max.max(p);
+                    max_deviation = std::max(
+                        max_deviation,
+                        trajectory.max_distance_from_linear(t0, t1));
+                }
+
+                lower.row(vi) = (min - max_deviation).matrix().transpose();
+                upper.row(vi) = (max + max_deviation).matrix().transpose();
+            }
+        });
+
+    build(mesh, lower, upper, inflation_radius, broad_phase);
+}
+
 size_t Candidates::size() const
 {
     return vv_candidates.size() + ev_candidates.size() + ee_candidates.size()
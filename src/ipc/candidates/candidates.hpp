@@ -5,6 +5,7 @@
 #include <ipc/candidates/edge_vertex.hpp>
 #include <ipc/candidates/face_vertex.hpp>
 #include <ipc/candidates/vertex_vertex.hpp>
+#include <ipc/ccd/nonlinear_ccd.hpp>
 
 #include <Eigen/Core>
 
@@ -43,6 +44,24 @@ public:
         const std::shared_ptr<BroadPhase> broad_phase =
             make_default_broad_phase());
 
+    /// @brief Initialize the set of continuous collision detection candidates along nonlinear trajectories.
+    /// @note The swept bounds of each vertex enclose its trajectory sampled at uniform times and inflated by the distance from the linearized trajectory.
+    /// @param mesh The surface of the collision mesh.
+    /// @param trajectories Trajectory of each surface vertex.
+    /// @param inflation_radius Amount to inflate the bounding boxes.
+    /// @param broad_phase_method Broad phase method to use.
+    /// @param num_samples Number of time intervals to sample each trajectory at.
+    void build(
+        const CollisionMesh& mesh,
+        const std::vector<const NonlinearTrajectory*>& trajectories,
+        const double inflation_radius = 0,
+        const std::shared_ptr<BroadPhase> broad_phase =
+            make_default_broad_phase(),
+        const int num_samples = DEFAULT_NUM_TRAJECTORY_SAMPLES);
+
+    /// @brief Default number of time intervals to sample nonlinear trajectories at.
+    static constexpr int DEFAULT_NUM_TRAJECTORY_SAMPLES = 8;
+
     size_t size() const;
 
     bool empty() const;
@@ -70,6 +89,7 @@ public:
 
     /// @brief Computes a maximal step size that is collision free using the set of collision candidates.
     /// @note Assumes the trajectory is linear.
+    /// @note If the narrow phase provides a first tier (see NarrowPhaseCCD::first_tier()), every candidate is first tested with it and only the candidates it cannot decide are rerun with the full method.
     /// @param mesh The collision mesh.
     /// @param vertices_t0 Surface vertex starting positions (rowwise). Assumed to be intersection free.
     /// @param vertices_t1 Surface vertex ending positions (rowwise).
@@ -84,6 +104,57 @@ public:
         const NarrowPhaseCCD& narrow_phase_ccd =
             DEFAULT_NARROW_PHASE_CCD) const;
 
+    /// @brief Computes the time of impact of every candidate.
+    /// @note Assumes the trajectory is linear.
+    /// @note Unlike compute_collision_free_stepsize(), every candidate is tested over the full interval [0, 1] (i.e., the narrow phase is not truncated at the running earliest time of impact).
+    /// @param mesh The collision mesh.
+    /// @param vertices_t0 Surface vertex starting positions (rowwise). Assumed to be intersection free.
+    /// @param vertices_t1 Surface vertex ending positions (rowwise).
+    /// @param min_distance The minimum distance allowable between any two elements.
+    /// @param narrow_phase_ccd The narrow phase CCD algorithm to use.
+    /// @returns The time of impact of each candidate (ordered as operator[]). A value of 1.0 if the candidate does not collide.
+    Eigen::VectorXd compute_per_candidate_toi(
+        const CollisionMesh& mesh,
+        Eigen::ConstRef<Eigen::MatrixXd> vertices_t0,
+        Eigen::ConstRef<Eigen::MatrixXd> vertices_t1,
+        const double min_distance = 0.0,
+        const NarrowPhaseCCD& narrow_phase_ccd =
+            DEFAULT_NARROW_PHASE_CCD) const;
+
+    /// @brief Computes the maximum collision-free step size of each vertex.
+    /// @note Assumes the trajectory is linear.
+    /// @param mesh The collision mesh.
+    /// @param vertices_t0 Surface vertex starting positions (rowwise). Assumed to be intersection free.
+    /// @param vertices_t1 Surface vertex ending positions (rowwise).
+    /// @param min_distance The minimum distance allowable between any two elements.
+    /// @param narrow_phase_ccd The narrow phase CCD algorithm to use.
+    /// @returns The minimum time of impact over all candidates incident on each vertex. A value of 1.0 if the vertex is not involved in any collision.
+    Eigen::VectorXd compute_per_vertex_collision_free_stepsize(
+        const CollisionMesh& mesh,
+        Eigen::ConstRef<Eigen::MatrixXd> vertices_t0,
+        Eigen::ConstRef<Eigen::MatrixXd> vertices_t1,
+        const double min_distance = 0.0,
+        const NarrowPhaseCCD& narrow_phase_ccd =
+            DEFAULT_NARROW_PHASE_CCD) const;
+
+    /// @brief Computes a maximal step size that is collision free along nonlinear trajectories.
+    /// @note The candidates must be built from bounds that enclose the nonlinear trajectories.
+    /// @param mesh The collision mesh.
+    /// @param trajectories Trajectory of each surface vertex.
+    /// @param min_distance The minimum distance allowable between any two elements.
+    /// @param tolerance Tolerance for the linear CCD algorithm.
+    /// @param max_iterations Maximum number of iterations for the linear CCD algorithm.
+    /// @param conservative_rescaling Conservative rescaling of the time of impact.
+    /// @returns A step-size \f$\in [0, 1]\f$ that is collision free. A value of 1.0 if a full step and 0.0 is no step.
+    double compute_nonlinear_collision_free_stepsize(
+        const CollisionMesh& mesh,
+        const std::vector<const NonlinearTrajectory*>& trajectories,
+        const double min_distance = 0.0,
+        const double tolerance = TightInclusionCCD::DEFAULT_TOLERANCE,
+        const long max_iterations = TightInclusionCCD::DEFAULT_MAX_ITERATIONS,
+        const double conservative_rescaling =
+            TightInclusionCCD::DEFAULT_CONSERVATIVE_RESCALING) const;
+
     /// @brief Computes a conservative bound on the largest-feasible step size for surface primitives not in collision.
     /// @param mesh The collision mesh.
     /// @param displacements Surface vertex displacements (rowwise).
@@ -111,6 +182,31 @@ public:
         const NarrowPhaseCCD& narrow_phase_ccd =
             DEFAULT_NARROW_PHASE_CCD) const;
 
+    /// @brief Computes a CFL-inspired CCD maximum step size, extending the candidates where the CFL bound is too small.
+    ///
+    /// Instead of falling back to a full CCD, only pairs involving vertices
+    /// that move farther than \f$\hat{d}/2\f$ before the candidates' step
+    /// size are detected (using the given broad phase) and checked. These
+    /// pairs are appended to the candidates.
+    ///
+    /// @note Meshes with codimensional vertices fall back to a full CCD.
+    /// @param mesh The collision mesh.
+    /// @param vertices_t0 Surface vertex starting positions (rowwise).
+    /// @param vertices_t1 Surface vertex ending positions (rowwise).
+    /// @param dhat Barrier activation distance.
+    /// @param min_distance The minimum distance allowable between any two elements.
+    /// @param broad_phase The broad phase used to detect the additional candidates.
+    /// @param narrow_phase_ccd The narrow phase CCD algorithm to use.
+    double compute_incremental_cfl_stepsize(
+        const CollisionMesh& mesh,
+        Eigen::ConstRef<Eigen::MatrixXd> vertices_t0,
+        Eigen::ConstRef<Eigen::MatrixXd> vertices_t1,
+        const double dhat,
+        const double min_distance = 0.0,
+        const std::shared_ptr<BroadPhase> broad_phase =
+            make_default_broad_phase(),
+        const NarrowPhaseCCD& narrow_phase_ccd = DEFAULT_NARROW_PHASE_CCD);
+
     bool save_obj(
         const std::string& filename,
         Eigen::ConstRef<Eigen::MatrixXd> vertices,
@@ -0,0 +1,421 @@
+#include "compact_candidates.hpp"
+
+#include <ipc/distance/edge_edge.hpp>
+#include <ipc/distance/point_edge.hpp>
+#include <ipc/distance/point_point.hpp>
+#include <ipc/distance/point_triangle.hpp>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <numeric>
+#include <shared_mutex>
+
+namespace ipc {
+
+namespace {
+    using Type = CompactCandidates::Type;
+    using VertexIds = CompactCandidates::VertexIds;
+
+    /// Positions of the (up to four) vertices of a candidate.
+    using StencilPositions =
+        Eigen::Matrix<double, 4, Eigen::Dynamic, Eigen::RowMajor, 4, 3>;
+
+    /// View of a Candidates object with the same interface as
+    /// CompactCandidates, so the narrow phase can read it in place.
+    class CandidatesView {
+    public:
+        CandidatesView(const Candidates& candidates, const CollisionMesh& mesh)
+            : m_candidates(candidates)
+            , m_edges(mesh.edges())
+            , m_faces(mesh.faces())
+            , m_ev_offset(candidates.vv_candidates.size())
+            , m_ee_offset(m_ev_offset + candidates.ev_candidates.size())
+            , m_fv_offset(m_ee_offset + candidates.ee_candidates.size())
+        {
+        }
+
+        size_t size() const { return m_candidates.size(); }
+
+        Type type(const size_t i) const
+        {
+            assert(i < size());
+            if (i < m_ev_offset) {
+                return Type::VERTEX_VERTEX;
+            } else if (i < m_ee_offset) {
+                return Type::EDGE_VERTEX;
+            } else if (i < m_fv_offset) {
+                return Type::EDGE_EDGE;
+            }
+            return Type::FACE_VERTEX;
+        }
+
+        VertexIds vertex_ids(const size_t i) const
+        {
+            const Eigen::MatrixXi& E = m_edges;
+            const Eigen::MatrixXi& F = m_faces;
+            switch (type(i)) {
+            case Type::VERTEX_VERTEX: {
+                const auto& [v0i, v1i] = m_candidates.vv_candidates[i];
+                return { { int32_t(v0i), int32_t(v1i), -1, -1 } };
+            }
+            case Type::EDGE_VERTEX: {
+                const auto& [ei, vi] =
+                    m_candidates.ev_candidates[i - m_ev_offset];
+                return { { int32_t(vi), E(ei, 0), E(ei, 1), -1 } };
+            }
+            case Type::EDGE_EDGE: {
+                const auto& [eai, ebi] =
+                    m_candidates.ee_candidates[i - m_ee_offset];
+                return { { E(eai, 0), E(eai, 1), E(ebi, 0), E(ebi, 1) } };
+            }
+            case Type::FACE_VERTEX:
+            default: {
+                const auto& [fi, vi] =
+                    m_candidates.fv_candidates[i - m_fv_offset];
+                return { { int32_t(vi), F(fi, 0), F(fi, 1), F(fi, 2) } };
+            }
+            }
+        }
+
+    private:
+        const Candidates& m_candidates;
+        const Eigen::MatrixXi& m_edges;
+        const Eigen::MatrixXi& m_faces;
+        const size_t m_ev_offset;
+        const size_t m_ee_offset;
+        const size_t m_fv_offset;
+    };
+
+    /// Gather the positions of the vertices of a candidate.
+    StencilPositions
+    positions(const VertexIds& vids, Eigen::ConstRef<Eigen::MatrixXd> vertices)
+    {
+        StencilPositions x = StencilPositions::Zero(4, vertices.cols());
+        for (int j = 0; j < 4 && vids[j] >= 0; j++) {
+            x.row(j) = vertices.row(vids[j]);
+        }
+        return x;
+    }
+
+    /// Perform narrow-phase CCD on a candidate given its vertex positions.
+    bool stencil_ccd(
+        const Type type,
+        const StencilPositions& x0,
+        const StencilPositions& x1,
+        double& toi,
+        const double min_distance,
+        const double tmax,
+        const NarrowPhaseCCD& narrow_phase_ccd)
+    {
+        switch (type) {
+        case Type::VERTEX_VERTEX:
+            return narrow_phase_ccd.point_point_ccd(
+                x0.row(0), x0.row(1), x1.row(0), x1.row(1), toi, min_distance,
+                tmax);
+
+        case Type::EDGE_VERTEX:
+            return narrow_phase_ccd.point_edge_ccd(
+                x0.row(0), x0.row(1), x0.row(2), x1.row(0), x1.row(1),
+                x1.row(2), toi, min_distance, tmax);
+
+        case Type::EDGE_EDGE:
+            assert(x0.cols() == 3);
+            return narrow_phase_ccd.edge_edge_ccd(
+                x0.row(0), x0.row(1), x0.row(2), x0.row(3), x1.row(0),
+                x1.row(1), x1.row(2), x1.row(3), toi, min_distance, tmax);
+
+        case Type::FACE_VERTEX:
+        default:
+            assert(x0.cols() == 3);
+            return narrow_phase_ccd.point_triangle_ccd(
+                x0.row(0), x0.row(1), x0.row(2), x0.row(3), x1.row(0),
+                x1.row(1), x1.row(2), x1.row(3), toi, min_distance, tmax);
+        }
+    }
+
+    template <typename CandidateTable>
+    bool table_ccd(
+        const CandidateTable& table,
+        const size_t i,
+        Eigen::ConstRef<Eigen::MatrixXd> vertices_t0,
+        Eigen::ConstRef<Eigen::MatrixXd> vertices_t1,
+        double& toi,
+        const double min_distance,
+        const double tmax,
+        const NarrowPhaseCCD& narrow_phase_ccd)
+    {
+        const VertexIds vids = table.vertex_ids(i);
+        return stencil_ccd(
+            table.type(i), positions(vids, vertices_t0),
+            positions(vids, vertices_t1), toi, min_distance, tmax,
+            narrow_phase_ccd);
+    }
+
+    /// Lower bound on the distance between the two primitives of a candidate
+    /// given by the gap between their bounding boxes.
+    double bounding_box_gap(
+        const Type type, const VertexIds& vids, const StencilPositions& x)
+    {
+        const int num_first_vertices = type == Type::EDGE_EDGE ? 2 : 1;
+        int num_vertices = 0;
+        while (num_vertices < 4 && vids[num_vertices] >= 0) {
+            num_vertices++;
+        }
+
+        const auto first = x.topRows(num_first_vertices);
+        const auto second =
+            x.middleRows(num_first_vertices, num_vertices - num_first_vertices);
+        return (second.colwise().minCoeff() - first.colwise().maxCoeff())
+            .cwiseMax(first.colwise().minCoeff() - second.colwise().maxCoeff())
+            .cwiseMax(0.0)
+            .norm();
+    }
+
+    template <typename CandidateTable>
+    double table_estimate_ccd_cost(
+        const CandidateTable& table,
+        const size_t i,
+        Eigen::ConstRef<Eigen::MatrixXd> vertices_t0,
+        Eigen::ConstRef<Eigen::MatrixXd> vertices_t1,
+        const double min_distance)
+    {
+        // Relative cost of a single query of each type (complexity of the
+        // root-finding problem).
+        static constexpr std::array<double, 4> TYPE_COST = { { 1, 2, 8, 4 } };
+
+        const Type t = table.type(i);
+        const VertexIds vids = table.vertex_ids(i);
+        const StencilPositions x0 = positions(vids, vertices_t0);
+        const StencilPositions dx = positions(vids, vertices_t1) - x0;
+
+        // Largest displacement relative to the first vertex
+        double relative_displacement = 0;
+        for (int j = 1; j < 4 && vids[j] >= 0; j++) {
+            relative_displacement = std::max(
+                relative_displacement, (dx.row(j) - dx.row(0)).norm());
+        }
+
+        // Queries that move far compared to their gap need the most
+        // refinement.
+        const auto cost = [&](const double distance) {
+            const double gap = std::max(
+                distance - min_distance,
+                std::numeric_limits<double>::epsilon());
+            return TYPE_COST[static_cast<size_t>(t)]
+                * (1 + relative_displacement / gap);
+        };
+
+        // The bounding box gap underestimates the distance, so its cost is an
+        // overestimate. Only compute the exact distance if it matters.
+        const double box_cost = cost(bounding_box_gap(t, vids, x0));
+        if (box_cost < CompactCandidates::EXPENSIVE_CCD_COST) {
+            return box_cost;
+        }
+
+        double distance_sqr;
+        switch (t) {
+        case Type::VERTEX_VERTEX:
+            distance_sqr = point_point_distance(x0.row(0), x0.row(1));
+            break;
+        case Type::EDGE_VERTEX:
+            distance_sqr = point_edge_distance(x0.row(0), x0.row(1), x0.row(2));
+            break;
+        case Type::EDGE_EDGE:
+            distance_sqr =
+                edge_edge_distance(x0.row(0), x0.row(1), x0.row(2), x0.row(3));
+            break;
+        case Type::FACE_VERTEX:
+        default:
+            distance_sqr = point_triangle_distance(
+                x0.row(0), x0.row(1), x0.row(2), x0.row(3));
+            break;
+        }
+        return cost(std::sqrt(distance_sqr));
+    }
+
+    template <typename CandidateTable>
+    double table_compute_collision_free_stepsize(
+        const CandidateTable& table,
+        Eigen::ConstRef<Eigen::MatrixXd> vertices_t0,
+        Eigen::ConstRef<Eigen::MatrixXd> vertices_t1,
+        const double min_distance,
+        const NarrowPhaseCCD& narrow_phase_ccd)
+    {
+        assert(vertices_t0.rows() == vertices_t1.rows());
+
+        const size_t n = table.size();
+        if (n == 0) {
+            return 1; // No possible collisions, so can take full step.
+        }
+
+        const std::shared_ptr<const NarrowPhaseCCD> first_tier =
+            narrow_phase_ccd.first_tier();
+
+        // Schedule the queries by decreasing estimated cost (longest
+        // processing time first), so expensive queries are not serialized at
+        // the end of a chunk and the cheap ones fill the gaps.
+        std::vector<double> costs(n);
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(0, n),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t i = r.begin(); i < r.end(); i++) {
+                    costs[i] = table_estimate_ccd_cost(
+                        table, i, vertices_t0, vertices_t1, min_distance);
+                }
+            });
+        std::vector<size_t> schedule(n);
+        std::iota(schedule.begin(), schedule.end(), size_t(0));
+        tbb::parallel_sort(
+            schedule.begin(), schedule.end(),
+            [&](size_t a, size_t b) { return costs[a] > costs[b]; });
+
+        double earliest_toi = 1;
+        std::shared_mutex earliest_toi_mutex;
+
+        // Candidates the first tier could not decide
+        std::vector<char> is_undecided;
+        if (first_tier) {
+            is_undecided.resize(n, false);
+        }
+
+        // Run the queries of the given candidates (in order) with a method,
+        // bounded by the running earliest time of impact.
+        const auto run_pass = [&](const std::vector<size_t>& candidate_ids,
+                                  const NarrowPhaseCCD& method) {
+            tbb::parallel_for(
+                tbb::blocked_range<size_t>(0, candidate_ids.size()),
+                [&](tbb::blocked_range<size_t> r) {
+                    for (size_t ci = r.begin(); ci < r.end(); ci++) {
+                        const size_t i = candidate_ids[ci];
+
+                        // Use the mutex to read as well in case writing double
+                        // takes more than one clock cycle.
+                        double tmax;
+                        {
+                            std::shared_lock lock(earliest_toi_mutex);
+                            tmax = earliest_toi;
+                        }
+
+                        if (tmax == 0) {
+                            continue; // Cannot lower the earliest toi
+                        }
+
+                        double toi = std::numeric_limits<double>::infinity();
+                        const bool are_colliding = table_ccd(
+                            table, i, vertices_t0, vertices_t1, toi,
+                            min_distance, tmax, method);
+
+                        if (are_colliding
+                            && toi == NarrowPhaseCCD::UNDECIDED_TOI) {
+                            assert(first_tier && &method == first_tier.get());
+                            is_undecided[i] = true;
+                        } else if (are_colliding) {
+                            std::unique_lock lock(earliest_toi_mutex);
+                            if (toi < earliest_toi) {
+                                earliest_toi = toi;
+                            }
+                        }
+                    }
+                });
+        };
+
+        run_pass(schedule, first_tier ? *first_tier : narrow_phase_ccd);
+
+        if (first_tier) {
+            // Rerun the undecided candidates with the full method (in
+            // schedule order). Every other result of the first tier is final.
+            std::vector<size_t> undecided;
+            for (const size_t i : schedule) {
+                if (is_undecided[i]) {
+                    undecided.push_back(i);
+                }
+            }
+            run_pass(undecided, narrow_phase_ccd);
+        }
+
+        assert(earliest_toi >= 0 && earliest_toi <= 1.0);
+        return earliest_toi;
+    }
+} // namespace
+
+void CompactCandidates::build(
+    const Candidates& candidates, const CollisionMesh& mesh)
+{
+    assert(
+        mesh.num_vertices() <= size_t(std::numeric_limits<int32_t>::max()));
+
+    const CandidatesView view(candidates, mesh);
+
+    m_ev_offset = candidates.vv_candidates.size();
+    m_ee_offset = m_ev_offset + candidates.ev_candidates.size();
+    m_fv_offset = m_ee_offset + candidates.ee_candidates.size();
+
+    m_vertex_ids.resize(view.size());
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, size()),
+        [&](const tbb::blocked_range<size_t>& r) {
+            for (size_t i = r.begin(); i < r.end(); i++) {
+                m_vertex_ids[i] = view.vertex_ids(i);
+            }
+        });
+}
+
+void CompactCandidates::clear()
+{
+    m_vertex_ids.clear();
+    m_ev_offset = m_ee_offset = m_fv_offset = 0;
+}
+
+bool CompactCandidates::ccd(
+    const size_t i,
+    Eigen::ConstRef<Eigen::MatrixXd> vertices_t0,
+    Eigen::ConstRef<Eigen::MatrixXd> vertices_t1,
+    double& toi,
+    const double min_distance,
+    const double tmax,
+    const NarrowPhaseCCD& narrow_phase_ccd) const
+{
+    return table_ccd(
+        *this, i, vertices_t0, vertices_t1, toi, min_distance, tmax,
+        narrow_phase_ccd);
+}
+
+double CompactCandidates::estimate_ccd_cost(
+    const size_t i,
+    Eigen::ConstRef<Eigen::MatrixXd> vertices_t0,
+    Eigen::ConstRef<Eigen::MatrixXd> vertices_t1,
+    const double min_distance) const
+{
+    return table_estimate_ccd_cost(
+        *this, i, vertices_t0, vertices_t1, min_distance);
+}
+
+double CompactCandidates::compute_collision_free_stepsize(
+    Eigen::ConstRef<Eigen::MatrixXd> vertices_t0,
+    Eigen::ConstRef<Eigen::MatrixXd> vertices_t1,
+    const double min_distance,
+    const NarrowPhaseCCD& narrow_phase_ccd) const
+{
+    return table_compute_collision_free_stepsize(
+        *this, vertices_t0, vertices_t1, min_distance, narrow_phase_ccd);
+}
+
+double CompactCandidates::compute_collision_free_stepsize(
+    const Candidates& candidates,
+    const CollisionMesh& mesh,
+    Eigen::ConstRef<Eigen::MatrixXd> vertices_t0,
+    Eigen::ConstRef<Eigen::MatrixXd> vertices_t1,
+    const double min_distance,
+    const NarrowPhaseCCD& narrow_phase_ccd)
+{
+    return table_compute_collision_free_stepsize(
+        CandidatesView(candidates, mesh), vertices_t0, vertices_t1,
+        min_distance, narrow_phase_ccd);
+}
+
+} // namespace ipc
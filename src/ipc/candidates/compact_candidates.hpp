@@ -0,0 +1,156 @@
+#pragma once
+
+#include <ipc/candidates/candidates.hpp>
+
+#include <Eigen/Core>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace ipc {
+
+/// @brief Contiguous plain-old-data storage of collision candidates.
+///
+/// Candidates are stored as a table of the (up to four) 32-bit vertex ids of
+/// each candidate. Candidates are indexed in the same order as
+/// Candidates::operator[] (i.e., vertex-vertex, edge-vertex, edge-edge, and
+/// then face-vertex), and the narrow phase dispatches on the index range
+/// instead of virtual calls.
+class CompactCandidates {
+public:
+    /// @brief Estimated cost above which the cost of a narrow-phase query is refined with the exact distance.
+    static constexpr double EXPENSIVE_CCD_COST = 1024;
+
+    /// @brief Vertex ids of a candidate (unused entries are -1).
+    using VertexIds = std::array<int32_t, 4>;
+
+    /// @brief Type of a candidate.
+    enum class Type : uint8_t {
+        VERTEX_VERTEX,
+        EDGE_VERTEX,
+        EDGE_EDGE,
+        FACE_VERTEX,
+    };
+
+    CompactCandidates() = default;
+
+    /// @brief Construct a compact copy of a set of candidates.
+    /// @param candidates The candidates to copy.
+    /// @param mesh The collision mesh.
+    CompactCandidates(const Candidates& candidates, const CollisionMesh& mesh)
+    {
+        build(candidates, mesh);
+    }
+
+    /// @brief Build a compact copy of a set of candidates.
+    /// @param candidates The candidates to copy.
+    /// @param mesh The collision mesh.
+    void build(const Candidates& candidates, const CollisionMesh& mesh);
+
+    size_t size() const { return m_vertex_ids.size(); }
+
+    bool empty() const { return m_vertex_ids.empty(); }
+
+    void clear();
+
+    /// @brief Get the type of the i-th candidate.
+    Type type(const size_t i) const
+    {
+        assert(i < size());
+        if (i < m_ev_offset) {
+            return Type::VERTEX_VERTEX;
+        } else if (i < m_ee_offset) {
+            return Type::EDGE_VERTEX;
+        } else if (i < m_fv_offset) {
+            return Type::EDGE_EDGE;
+        }
+        return Type::FACE_VERTEX;
+    }
+
+    /// @brief Get the vertex ids of the i-th candidate.
+    /// @note The order matches CollisionStencil::vertex_ids().
+    const VertexIds& vertex_ids(const size_t i) const
+    {
+        assert(i < size());
+        return m_vertex_ids[i];
+    }
+
+    /// @brief Perform narrow-phase CCD on the i-th candidate.
+    /// @param i Index of the candidate.
+    /// @param vertices_t0 Surface vertex starting positions (rowwise).
+    /// @param vertices_t1 Surface vertex ending positions (rowwise).
+    /// @param[out] toi Computed time of impact (normalized).
+    /// @param min_distance Minimum separation distance between primitives.
+    /// @param tmax Maximum time (normalized) to look for collisions. Should be in [0, 1].
+    /// @param narrow_phase_ccd The narrow phase CCD algorithm to use.
+    /// @return If the candidate had a collision over the time interval.
+    bool
+    ccd(const size_t i,
+        Eigen::ConstRef<Eigen::MatrixXd> vertices_t0,
+        Eigen::ConstRef<Eigen::MatrixXd> vertices_t1,
+        double& toi,
+        const double min_distance = 0.0,
+        const double tmax = 1.0,
+        const NarrowPhaseCCD& narrow_phase_ccd =
+            DEFAULT_NARROW_PHASE_CCD) const;
+
+    /// @brief Estimate the relative cost of the narrow-phase CCD of the i-th candidate.
+    /// The cost grows with the complexity of the candidate type and with the relative displacement of its vertices compared to their initial distance.
+    /// The distance is first bounded from below by the gap between the bounding boxes of the two primitives, and only computed exactly if this bound marks the query as expensive.
+    /// @param i Index of the candidate.
+    /// @param vertices_t0 Surface vertex starting positions (rowwise).
+    /// @param vertices_t1 Surface vertex ending positions (rowwise).
+    /// @param min_distance Minimum separation distance between primitives.
+    /// @return The estimated cost (at least one).
+    double estimate_ccd_cost(
+        const size_t i,
+        Eigen::ConstRef<Eigen::MatrixXd> vertices_t0,
+        Eigen::ConstRef<Eigen::MatrixXd> vertices_t1,
+        const double min_distance = 0.0) const;
+
+    /// @brief Computes a maximal step size that is collision free using the set of collision candidates.
+    /// @note Assumes the trajectory is linear.
+    /// @note See Candidates::compute_collision_free_stepsize() for the handling of tiered narrow phases.
+    /// @note Queries are scheduled by decreasing estimated cost, so the expensive ones start first and the cheap ones fill the gaps.
+    /// @param vertices_t0 Surface vertex starting positions (rowwise). Assumed to be intersection free.
+    /// @param vertices_t1 Surface vertex ending positions (rowwise).
+    /// @param min_distance The minimum distance allowable between any two elements.
+    /// @param narrow_phase_ccd The narrow phase CCD algorithm to use.
+    /// @returns A step-size \f$\in [0, 1]\f$ that is collision free. A value of 1.0 if a full step and 0.0 is no step.
+    double compute_collision_free_stepsize(
+        Eigen::ConstRef<Eigen::MatrixXd> vertices_t0,
+        Eigen::ConstRef<Eigen::MatrixXd> vertices_t1,
+        const double min_distance = 0.0,
+        const NarrowPhaseCCD& narrow_phase_ccd =
+            DEFAULT_NARROW_PHASE_CCD) const;
+
+    /// @brief Computes a maximal step size that is collision free using a set of candidates without building a compact copy.
+    /// The candidates are read in place with the same scheduling as the member function.
+    /// @param candidates The collision candidates.
+    /// @param mesh The collision mesh.
+    /// @param vertices_t0 Surface vertex starting positions (rowwise). Assumed to be intersection free.
+    /// @param vertices_t1 Surface vertex ending positions (rowwise).
+    /// @param min_distance The minimum distance allowable between any two elements.
+    /// @param narrow_phase_ccd The narrow phase CCD algorithm to use.
+    /// @returns A step-size \f$\in [0, 1]\f$ that is collision free. A value of 1.0 if a full step and 0.0 is no step.
+    static double compute_collision_free_stepsize(
+        const Candidates& candidates,
+        const CollisionMesh& mesh,
+        Eigen::ConstRef<Eigen::MatrixXd> vertices_t0,
+        Eigen::ConstRef<Eigen::MatrixXd> vertices_t1,
+        const double min_distance = 0.0,
+        const NarrowPhaseCCD& narrow_phase_ccd = DEFAULT_NARROW_PHASE_CCD);
+
+private:
+    /// @brief Vertex ids of every candidate.
+    std::vector<VertexIds> m_vertex_ids;
+    /// @brief Index of the first edge-vertex candidate.
+    size_t m_ev_offset = 0;
+    /// @brief Index of the first edge-edge candidate.
+    size_t m_ee_offset = 0;
+    /// @brief Index of the first face-vertex candidate.
+    size_t m_fv_offset = 0;
+};
+
+} // namespace ipc
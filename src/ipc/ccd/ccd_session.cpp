@@ -0,0 +1,124 @@
+#include "ccd_session.hpp"
+
+#include <algorithm>
+
+namespace ipc {
+
+CCDSession::CCDSession(
+    const CollisionMesh& mesh,
+    const double min_distance,
+    const std::shared_ptr<BroadPhase> broad_phase,
+    const NarrowPhaseCCD& narrow_phase_ccd)
+    : m_mesh(mesh)
+    , m_min_distance(min_distance)
+    , m_broad_phase(broad_phase)
+    , m_narrow_phase_ccd(narrow_phase_ccd)
+{
+    assert(broad_phase != nullptr);
+}
+
+void CCDSession::build(
+    Eigen::ConstRef<Eigen::MatrixXd> vertices_t0,
+    Eigen::ConstRef<Eigen::MatrixXd> vertices_t1)
+{
+    assert(size_t(vertices_t0.rows()) == m_mesh.num_vertices());
+    assert(size_t(vertices_t1.rows()) == m_mesh.num_vertices());
+
+    m_vertices_t0 = vertices_t0;
+    m_displacements = vertices_t1 - vertices_t0;
+
+    // Broad phase
+    m_candidates.build(
+        m_mesh, vertices_t0, vertices_t1,
+        /*inflation_radius=*/0.5 * m_min_distance, m_broad_phase);
+
+    // Narrow phase (the earliest time of impact shrinks the remaining queries)
+    m_earliest_toi = m_candidates.compute_collision_free_stepsize(
+        m_mesh, vertices_t0, vertices_t1, m_min_distance, m_narrow_phase_ccd);
+    m_candidate_tois.resize(0);
+
+    m_num_builds++;
+}
+
+const Eigen::VectorXd& CCDSession::candidate_tois()
+{
+    if (size_t(m_candidate_tois.size()) != m_candidates.size()) {
+        m_candidate_tois = m_candidates.compute_per_candidate_toi(
+            m_mesh, m_vertices_t0, m_vertices_t0 + m_displacements,
+            m_min_distance, m_narrow_phase_ccd);
+    }
+    return m_candidate_tois;
+}
+
+double CCDSession::compute_collision_free_stepsize(
+    Eigen::ConstRef<Eigen::MatrixXd> vertices_t0,
+    Eigen::ConstRef<Eigen::MatrixXd> vertices_t1)
+{
+    const double alpha = step_scale(vertices_t0, vertices_t1);
+    if (alpha < 0) {
+        build(vertices_t0, vertices_t1);
+        return m_earliest_toi;
+    }
+
+    // The step is the prefix [0, α] of the cached step, so a collision at
+    // time t of the cached step happens at time t / α of this step.
+    if (m_earliest_toi >= 1.0 || alpha <= m_earliest_toi) {
+        return 1.0;
+    }
+    return m_earliest_toi / alpha;
+}
+
+bool CCDSession::is_step_collision_free(
+    Eigen::ConstRef<Eigen::MatrixXd> vertices_t0,
+    Eigen::ConstRef<Eigen::MatrixXd> vertices_t1)
+{
+    const double alpha = step_scale(vertices_t0, vertices_t1);
+    if (alpha < 0) {
+        build(vertices_t0, vertices_t1);
+        return is_step_collision_free(1.0);
+    }
+    return is_step_collision_free(alpha);
+}
+
+bool CCDSession::is_step_collision_free(const double alpha) const
+{
+    assert(alpha >= 0 && alpha <= 1);
+    return m_earliest_toi >= 1.0 || alpha < m_earliest_toi;
+}
+
+double CCDSession::step_scale(
+    Eigen::ConstRef<Eigen::MatrixXd> vertices_t0,
+    Eigen::ConstRef<Eigen::MatrixXd> vertices_t1) const
+{
+    if (m_num_builds == 0 || vertices_t0.rows() != m_vertices_t0.rows()
+        || vertices_t0.cols() != m_vertices_t0.cols()
+        || vertices_t0 != m_vertices_t0) {
+        return -1;
+    }
+
+    const Eigen::MatrixXd displacements = vertices_t1 - vertices_t0;
+
+    const double norm_sq = m_displacements.squaredNorm();
+    if (norm_sq == 0) {
+        return displacements.squaredNorm() == 0 ? 0 : -1;
+    }
+
+    // Least-squares scale of the cached displacements
+    const double alpha =
+        (displacements.array() * m_displacements.array()).sum() / norm_sq;
+
+    if (alpha < 0 || alpha > 1 + direction_tolerance) {
+        return -1; // Extrapolating beyond the cached step requires new CCD
+    }
+
+    const double tol =
+        direction_tolerance * m_displacements.lpNorm<Eigen::Infinity>();
+    if ((displacements - alpha * m_displacements).lpNorm<Eigen::Infinity>()
+        > tol) {
+        return -1; // The direction changed
+    }
+
+    return std::min(alpha, 1.0);
+}
+
+} // namespace ipc
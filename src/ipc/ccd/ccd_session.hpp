@@ -0,0 +1,109 @@
+#pragma once
+
+#include <ipc/collision_mesh.hpp>
+#include <ipc/broad_phase/default_broad_phase.hpp>
+#include <ipc/candidates/candidates.hpp>
+#include <ipc/ccd/default_narrow_phase_ccd.hpp>
+
+#include <Eigen/Core>
+
+namespace ipc {
+
+/// @brief Stateful CCD for line searches along a fixed step direction.
+///
+/// The session runs the broad and narrow phase once for the full step
+/// \f$x_0 \to x_1\f$ and caches the earliest time of impact. Any scaled step
+/// \f$x_0 \to x_0 + \alpha (x_1 - x_0)\f$ with \f$\alpha \in [0, 1]\f$
+/// follows a prefix of the cached trajectories, so its collision-free step
+/// size follows from the cached time of impact without rerunning CCD. Full
+/// CCD is only rerun when the start positions or the step direction change.
+///
+/// @note The mesh and narrow phase CCD must outlive the session.
+class CCDSession {
+public:
+    /// @brief Construct a CCD session.
+    /// @param mesh The collision mesh.
+    /// @param min_distance The minimum distance allowable between any two elements.
+    /// @param broad_phase The broad phase method to use.
+    /// @param narrow_phase_ccd The narrow phase CCD algorithm to use.
+    CCDSession(
+        const CollisionMesh& mesh,
+        const double min_distance = 0.0,
+        const std::shared_ptr<BroadPhase> broad_phase =
+            make_default_broad_phase(),
+        const NarrowPhaseCCD& narrow_phase_ccd = DEFAULT_NARROW_PHASE_CCD);
+
+    /// @brief Run full CCD for the step and cache the earliest time of impact.
+    /// @note Assumes the trajectory is linear.
+    /// @param vertices_t0 Surface vertex starting positions (rowwise). Assumed to be intersection free.
+    /// @param vertices_t1 Surface vertex ending positions (rowwise).
+    void build(
+        Eigen::ConstRef<Eigen::MatrixXd> vertices_t0,
+        Eigen::ConstRef<Eigen::MatrixXd> vertices_t1);
+
+    /// @brief Computes a maximal step size that is collision free.
+    /// If the step is a scaled version of the cached step, the result is
+    /// computed from the cache. Otherwise, the session is rebuilt.
+    /// @param vertices_t0 Surface vertex starting positions (rowwise). Assumed to be intersection free.
+    /// @param vertices_t1 Surface vertex ending positions (rowwise).
+    /// @returns A step-size \f$\in [0, 1]\f$ that is collision free. A value of 1.0 if a full step and 0.0 is no step.
+    double compute_collision_free_stepsize(
+        Eigen::ConstRef<Eigen::MatrixXd> vertices_t0,
+        Eigen::ConstRef<Eigen::MatrixXd> vertices_t1);
+
+    /// @brief Determine if the step is collision free.
+    /// If the step is a scaled version of the cached step, the result is
+    /// computed from the cache. Otherwise, the session is rebuilt.
+    /// @param vertices_t0 Surface vertex starting positions (rowwise).
+    /// @param vertices_t1 Surface vertex ending positions (rowwise).
+    /// @returns True if <b>no</b> collisions occur.
+    bool is_step_collision_free(
+        Eigen::ConstRef<Eigen::MatrixXd> vertices_t0,
+        Eigen::ConstRef<Eigen::MatrixXd> vertices_t1);
+
+    /// @brief Determine if the scaled cached step \f$x_0 \to x_0 + \alpha (x_1 - x_0)\f$ is collision free.
+    /// @param alpha Fraction of the cached step \f$\in [0, 1]\f$.
+    /// @returns True if <b>no</b> collisions occur.
+    bool is_step_collision_free(const double alpha) const;
+
+    /// @brief Get the collision-free step size of the cached step.
+    double collision_free_stepsize() const { return m_earliest_toi; }
+
+    /// @brief Get the candidates of the cached step.
+    const Candidates& candidates() const { return m_candidates; }
+
+    /// @brief Get the time of impact of each candidate of the cached step.
+    /// @note These are computed on first use, because the step sizes only need the earliest time of impact.
+    const Eigen::VectorXd& candidate_tois();
+
+    /// @brief Get the number of times full CCD has been run.
+    size_t num_builds() const { return m_num_builds; }
+
+    /// @brief Relative tolerance used to decide if a step is parallel to the cached step.
+    double direction_tolerance = 1e-10;
+
+private:
+    /// @brief Compute the scale of a step relative to the cached step.
+    /// @return The scale \f$\alpha\f$ or a negative value if the step is not a scaled version of the cached step.
+    double step_scale(
+        Eigen::ConstRef<Eigen::MatrixXd> vertices_t0,
+        Eigen::ConstRef<Eigen::MatrixXd> vertices_t1) const;
+
+    const CollisionMesh& m_mesh;
+    double m_min_distance;
+    std::shared_ptr<BroadPhase> m_broad_phase;
+    const NarrowPhaseCCD& m_narrow_phase_ccd;
+
+    /// @brief Starting positions of the cached step.
+    Eigen::MatrixXd m_vertices_t0;
+    /// @brief Displacements of the cached step.
+    Eigen::MatrixXd m_displacements;
+
+    Candidates m_candidates;
+    /// @brief Time of impact of each candidate (empty until requested).
+    Eigen::VectorXd m_candidate_tois;
+    double m_earliest_toi = 1.0;
+    size_t m_num_builds = 0;
+};
+
+} // namespace ipc
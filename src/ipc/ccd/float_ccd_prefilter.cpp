@@ -0,0 +1,183 @@
+#include "float_ccd_prefilter.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace ipc {
+
+namespace {
+    /// Number of slabs the time interval [0, 1] is split into (power of two
+    /// so the sample times are exact in single precision).
+    constexpr int NUM_TIME_SLABS = 4;
+
+    /// Coordinates larger than this skip the filter so that no intermediate
+    /// value can overflow.
+    constexpr double MAX_COORDINATE = 1e30;
+
+    constexpr float INF = std::numeric_limits<float>::infinity();
+
+    // Round-to-nearest results are within half an ulp of the exact value, so
+    // stepping one ulp outward gives a rigorous bound.
+    inline float round_down(const float x) { return std::nextafter(x, -INF); }
+    inline float round_up(const float x) { return std::nextafter(x, INF); }
+
+    /// @brief Single-precision interval [lo, hi].
+    struct FloatInterval {
+        float lo, hi;
+    };
+
+    FloatInterval to_float(const double x)
+    {
+        const float f = static_cast<float>(x);
+        return {
+            double(f) > x ? round_down(f) : f,
+            double(f) < x ? round_up(f) : f,
+        };
+    }
+
+    /// @brief Per-axis bounds of a set of linearly moving points at the sample times.
+    struct SampledBounds {
+        SampledBounds()
+        {
+            for (auto& l : lo) {
+                l.fill(INF);
+            }
+            for (auto& h : hi) {
+                h.fill(-INF);
+            }
+        }
+
+        /// @brief Enclose the coordinates of x(t) = (1-t) x0 + t x1.
+        void add(
+            Eigen::ConstRef<Eigen::Vector3d> x_t0,
+            Eigen::ConstRef<Eigen::Vector3d> x_t1)
+        {
+            for (int k = 0; k < 3; k++) {
+                const FloatInterval x0 = to_float(x_t0[k]);
+                const FloatInterval x1 = to_float(x_t1[k]);
+                const FloatInterval dx = {
+                    round_down(x1.lo - x0.hi),
+                    round_up(x1.hi - x0.lo),
+                };
+
+                include(k, 0, x0);
+                for (int s = 1; s < NUM_TIME_SLABS; s++) {
+                    const float t = float(s) / NUM_TIME_SLABS; // exact
+                    include(
+                        k, s,
+                        { round_down(x0.lo + round_down(t * dx.lo)),
+                          round_up(x0.hi + round_up(t * dx.hi)) });
+                }
+                include(k, NUM_TIME_SLABS, x1);
+            }
+        }
+
+        void include(const int k, const int s, const FloatInterval& x)
+        {
+            lo[k][s] = std::min(lo[k][s], x.lo);
+            hi[k][s] = std::max(hi[k][s], x.hi);
+        }
+
+        std::array<std::array<float, NUM_TIME_SLABS + 1>, 3> lo, hi;
+    };
+
+    /// @brief Check if a is above b by more than ms along axis k at sample s.
+    inline bool is_above(
+        const SampledBounds& a,
+        const SampledBounds& b,
+        const int k,
+        const int s,
+        const float ms)
+    {
+        return round_down(a.lo[k][s] - b.hi[k][s]) > ms;
+    }
+
+    /// @brief Conservative test of two sets of linearly moving points.
+    ///
+    /// The inclusion function of both edge-edge and point-triangle CCD is
+    /// affine in time and in each barycentric parameter, so over a time slab
+    /// it is bounded by the differences a_i(t) - b_j(t) at the slab's ends.
+    /// A slab is collision free if every such difference is farther than
+    /// min_distance from zero along one axis.
+    template <int NA, int NB>
+    bool may_collide(
+        const std::array<Eigen::Vector3d, NA>& a_t0,
+        const std::array<Eigen::Vector3d, NA>& a_t1,
+        const std::array<Eigen::Vector3d, NB>& b_t0,
+        const std::array<Eigen::Vector3d, NB>& b_t1,
+        const double min_distance)
+    {
+        const auto in_range = [](const Eigen::Vector3d& x) {
+            return (x.array().abs() <= MAX_COORDINATE).all(); // false if NaN
+        };
+
+        SampledBounds a, b;
+        for (int i = 0; i < NA; i++) {
+            if (!in_range(a_t0[i]) || !in_range(a_t1[i])) {
+                return true;
+            }
+            a.add(a_t0[i], a_t1[i]);
+        }
+        for (int i = 0; i < NB; i++) {
+            if (!in_range(b_t0[i]) || !in_range(b_t1[i])) {
+                return true;
+            }
+            b.add(b_t0[i], b_t1[i]);
+        }
+
+        if (!(min_distance <= MAX_COORDINATE)) {
+            return true;
+        }
+        const float ms = to_float(min_distance).hi;
+
+        for (int s = 0; s < NUM_TIME_SLABS; s++) {
+            bool is_separated = false;
+            for (int k = 0; k < 3 && !is_separated; k++) {
+                is_separated =
+                    (is_above(a, b, k, s, ms) && is_above(a, b, k, s + 1, ms))
+                    || (is_above(b, a, k, s, ms)
+                        && is_above(b, a, k, s + 1, ms));
+            }
+            if (!is_separated) {
+                return true;
+            }
+        }
+        return false;
+    }
+} // namespace
+
+bool edge_edge_ccd_prefilter(
+    Eigen::ConstRef<Eigen::Vector3d> ea0_t0,
+    Eigen::ConstRef<Eigen::Vector3d> ea1_t0,
+    Eigen::ConstRef<Eigen::Vector3d> eb0_t0,
+    Eigen::ConstRef<Eigen::Vector3d> eb1_t0,
+    Eigen::ConstRef<Eigen::Vector3d> ea0_t1,
+    Eigen::ConstRef<Eigen::Vector3d> ea1_t1,
+    Eigen::ConstRef<Eigen::Vector3d> eb0_t1,
+    Eigen::ConstRef<Eigen::Vector3d> eb1_t1,
+    const double min_distance)
+{
+    return may_collide<2, 2>(
+        { { ea0_t0, ea1_t0 } }, { { ea0_t1, ea1_t1 } }, { { eb0_t0, eb1_t0 } },
+        { { eb0_t1, eb1_t1 } }, min_distance);
+}
+
+bool point_triangle_ccd_prefilter(
+    Eigen::ConstRef<Eigen::Vector3d> p_t0,
+    Eigen::ConstRef<Eigen::Vector3d> t0_t0,
+    Eigen::ConstRef<Eigen::Vector3d> t1_t0,
+    Eigen::ConstRef<Eigen::Vector3d> t2_t0,
+    Eigen::ConstRef<Eigen::Vector3d> p_t1,
+    Eigen::ConstRef<Eigen::Vector3d> t0_t1,
+    Eigen::ConstRef<Eigen::Vector3d> t1_t1,
+    Eigen::ConstRef<Eigen::Vector3d> t2_t1,
+    const double min_distance)
+{
+    return may_collide<1, 3>(
+        { { p_t0 } }, { { p_t1 } }, { { t0_t0, t1_t0, t2_t0 } },
+        { { t0_t1, t1_t1, t2_t1 } }, min_distance);
+}
+
+} // namespace ipc
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <ipc/utils/eigen_ext.hpp>
+
+namespace ipc {
+
+/// @brief Conservative single-precision filter for edge-edge CCD.
+///
+/// Bounds the inclusion function of Tight Inclusion CCD over a fixed number
+/// of time slabs using float32 interval arithmetic with outward rounding. A
+/// slab is discarded if the two edges are separated by more than the minimum
+/// distance along a coordinate axis.
+///
+/// @note The filter never rejects a query that collides (no false negatives),
+///       but it may accept queries that do not collide.
+/// @param[in] ea0_t0 The initial position of the first endpoint of the first edge.
+/// @param[in] ea1_t0 The initial position of the second endpoint of the first edge.
+/// @param[in] eb0_t0 The initial position of the first endpoint of the second edge.
+/// @param[in] eb1_t0 The initial position of the second endpoint of the second edge.
+/// @param[in] ea0_t1 The final position of the first endpoint of the first edge.
+/// @param[in] ea1_t1 The final position of the second endpoint of the first edge.
+/// @param[in] eb0_t1 The final position of the first endpoint of the second edge.
+/// @param[in] eb1_t1 The final position of the second endpoint of the second edge.
+/// @param[in] min_distance The minimum distance between the objects.
+/// @return False if the edges are provably collision free, true if they may collide.
+bool edge_edge_ccd_prefilter(
+    Eigen::ConstRef<Eigen::Vector3d> ea0_t0,
+    Eigen::ConstRef<Eigen::Vector3d> ea1_t0,
+    Eigen::ConstRef<Eigen::Vector3d> eb0_t0,
+    Eigen::ConstRef<Eigen::Vector3d> eb1_t0,
+    Eigen::ConstRef<Eigen::Vector3d> ea0_t1,
+    Eigen::ConstRef<Eigen::Vector3d> ea1_t1,
+    Eigen::ConstRef<Eigen::Vector3d> eb0_t1,
+    Eigen::ConstRef<Eigen::Vector3d> eb1_t1,
+    const double min_distance = 0.0);
+
+/// @brief Conservative single-precision filter for point-triangle CCD.
+/// @see edge_edge_ccd_prefilter
+/// @param[in] p_t0 The initial position of the point.
+/// @param[in] t0_t0 The initial position of the first vertex of the triangle.
+/// @param[in] t1_t0 The initial position of the second vertex of the triangle.
+/// @param[in] t2_t0 The initial position of the third vertex of the triangle.
+/// @param[in] p_t1 The final position of the point.
+/// @param[in] t0_t1 The final position of the first vertex of the triangle.
+/// @param[in] t1_t1 The final position of the second vertex of the triangle.
+/// @param[in] t2_t1 The final position of the third vertex of the triangle.
+/// @param[in] min_distance The minimum distance between the objects.
+/// @return False if the point and triangle are provably collision free, true if they may collide.
+bool point_triangle_ccd_prefilter(
+    Eigen::ConstRef<Eigen::Vector3d> p_t0,
+    Eigen::ConstRef<Eigen::Vector3d> t0_t0,
+    Eigen::ConstRef<Eigen::Vector3d> t1_t0,
+    Eigen::ConstRef<Eigen::Vector3d> t2_t0,
+    Eigen::ConstRef<Eigen::Vector3d> p_t1,
+    Eigen::ConstRef<Eigen::Vector3d> t0_t1,
+    Eigen::ConstRef<Eigen::Vector3d> t1_t1,
+    Eigen::ConstRef<Eigen::Vector3d> t2_t1,
+    const double min_distance = 0.0);
+
+} // namespace ipc
@@ -2,6 +2,8 @@
 
 #include <ipc/utils/eigen_ext.hpp>
 
+#include <memory>
+
 namespace ipc {
 
 class NarrowPhaseCCD {
@@ -10,6 +12,19 @@ public:
 
     virtual ~NarrowPhaseCCD() = default;
 
+    /// Time of impact reported by a first tier for a query it cannot decide.
+    static constexpr double UNDECIDED_TOI = -1;
+
+    /// @brief Get a cheaper version of this method to run as a first tier.
+    /// The first tier reports the queries it cannot decide as colliding at
+    /// UNDECIDED_TOI. All its other results are final. Undecided queries are
+    /// rerun with this method.
+    /// @return The first tier or nullptr if this method is not tiered.
+    virtual std::shared_ptr<const NarrowPhaseCCD> first_tier() const
+    {
+        return nullptr;
+    }
+
     virtual bool point_point_ccd(
         Eigen::ConstRef<VectorMax3d> p0_t0,
         Eigen::ConstRef<VectorMax3d> p1_t0,
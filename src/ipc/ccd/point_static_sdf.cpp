@@ -0,0 +1,75 @@
+#include "point_static_sdf.hpp"
+
+#include <ipc/implicits/sdf.hpp>
+#include <ipc/utils/logger.hpp>
+
+#include <cmath>
+
+namespace ipc {
+
+bool point_static_sdf_ccd(
+    Eigen::ConstRef<VectorMax3d> p_t0,
+    Eigen::ConstRef<VectorMax3d> p_t1,
+    const GridSDF& sdf,
+    double& toi,
+    const double min_distance,
+    const double tmax,
+    const double conservative_rescaling,
+    const long max_iterations)
+{
+    assert(p_t1.size() == p_t0.size());
+    assert(sdf.dim() == p_t0.size());
+    assert(0 <= tmax && tmax <= 1);
+
+    const double initial_distance = std::abs(sdf.value(p_t0));
+    if (initial_distance <= min_distance) {
+        logger().warn(
+            "Initial point-SDF distance {:g} is less than the minimum "
+            "distance {:g}, returning toi=0!",
+            initial_distance, min_distance);
+        toi = 0;
+        return true;
+    }
+
+    // The interpolated field is L-Lipschitz inside the grid and
+    // √(L² + 1)-Lipschitz outside of it. The grid is convex, so the whole
+    // trajectory is inside if both end points are.
+    const double lipschitz_constant = sdf.contains(p_t0) && sdf.contains(p_t1)
+        ? sdf.lipschitz_constant()
+        : std::hypot(sdf.lipschitz_constant(), 1.0);
+    // Maximum rate of change of the distance w.r.t. normalized time
+    const double max_rate = lipschitz_constant * (p_t1 - p_t0).norm();
+    if (max_rate == 0) {
+        return false;
+    }
+
+    // Stop once within this gap of the minimum distance. Steps advance towards
+    // half of the gap, so each step is at least gap / (2 * max_rate) long.
+    const double gap =
+        (1.0 - conservative_rescaling) * (initial_distance - min_distance);
+
+    double t = 0, distance = initial_distance;
+    for (long i = 0; max_iterations < 0 || i < max_iterations; i++) {
+        if (distance <= min_distance + gap) {
+            toi = t;
+            return true;
+        }
+
+        // The distance cannot drop below min_distance + gap / 2 before t.
+        t += (distance - min_distance - 0.5 * gap) / max_rate;
+        if (t >= tmax) {
+            return false;
+        }
+
+        distance = std::abs(sdf.value((1 - t) * p_t0 + t * p_t1));
+    }
+
+    logger().warn(
+        "Point-SDF CCD reached the maximum number of iterations ({:d}), "
+        "returning toi={:g}!",
+        max_iterations, t);
+    toi = t;
+    return true;
+}
+
+} // namespace ipc
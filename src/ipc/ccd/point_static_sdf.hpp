@@ -0,0 +1,31 @@
+#pragma once
+
+#include <ipc/ccd/tight_inclusion_ccd.hpp>
+
+namespace ipc {
+
+class GridSDF;
+
+/// @brief Computes the time of impact between a point and a static signed distance field using conservative advancement.
+/// @note The SDF's Lipschitz constant bounds how fast the distance can decrease along the trajectory, so each advancement step is guaranteed to be collision free.
+/// @param[in] p_t0 The initial position of the point.
+/// @param[in] p_t1 The final position of the point.
+/// @param[in] sdf The static signed distance field.
+/// @param[out] toi Output time of impact.
+/// @param[in] min_distance Minimum separation distance between the point and the SDF's zero level set.
+/// @param[in] tmax Maximum time (normalized) to look for collisions. Should be in [0, 1].
+/// @param[in] conservative_rescaling Conservative rescaling of the distance to the SDF at the time of impact.
+/// @param[in] max_iterations Maximum number of advancement steps (a negative value means unlimited). If reached, the current (collision free) time is returned as the time of impact.
+/// @return True if a collision was detected, false otherwise.
+bool point_static_sdf_ccd(
+    Eigen::ConstRef<VectorMax3d> p_t0,
+    Eigen::ConstRef<VectorMax3d> p_t1,
+    const GridSDF& sdf,
+    double& toi,
+    const double min_distance = 0.0,
+    const double tmax = 1.0,
+    const double conservative_rescaling =
+        TightInclusionCCD::DEFAULT_CONSERVATIVE_RESCALING,
+    const long max_iterations = TightInclusionCCD::DEFAULT_MAX_ITERATIONS);
+
+} // namespace ipc
@@ -0,0 +1,127 @@
+#include "rigid_trajectory.hpp"
+
+#include <Eigen/Geometry>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace ipc {
+
+RigidBodyMotion::RigidBodyMotion(
+    Eigen::ConstRef<VectorMax3d> center_t0,
+    Eigen::ConstRef<VectorMax3d> center_t1,
+    Eigen::ConstRef<MatrixMax3d> rotation_t0,
+    Eigen::ConstRef<VectorMax3d> angular_velocity)
+    : m_origin_t0(center_t0)
+    , m_origin_t1(center_t1)
+    , m_rotation_t0(rotation_t0)
+    , m_angular_velocity(angular_velocity)
+{
+    assert(center_t0.size() == 2 || center_t0.size() == 3);
+    assert(center_t1.size() == center_t0.size());
+    assert(rotation_t0.rows() == dim() && rotation_t0.cols() == dim());
+    assert(angular_velocity.size() == (dim() == 2 ? 1 : 3));
+}
+
+RigidBodyMotion::RigidBodyMotion(
+    std::shared_ptr<const RigidBodyMotion> parent,
+    Eigen::ConstRef<VectorMax3d> joint,
+    Eigen::ConstRef<MatrixMax3d> rotation_t0,
+    Eigen::ConstRef<VectorMax3d> angular_velocity)
+    : RigidBodyMotion(joint, joint, rotation_t0, angular_velocity)
+{
+    if (parent == nullptr) {
+        throw std::invalid_argument("Articulated body requires a parent!");
+    }
+    assert(parent->dim() == dim());
+    m_parent = std::move(parent);
+}
+
+MatrixMax3d RigidBodyMotion::rotation(const double t) const
+{
+    if (dim() == 2) {
+        return Eigen::Rotation2Dd(t * m_angular_velocity[0]).toRotationMatrix()
+            * m_rotation_t0;
+    }
+
+    const double speed = m_angular_velocity.norm();
+    if (speed == 0) {
+        return m_rotation_t0;
+    }
+    return Eigen::AngleAxisd(t * speed, m_angular_velocity / speed)
+               .toRotationMatrix()
+        * m_rotation_t0;
+}
+
+VectorMax3d RigidBodyMotion::operator()(
+    Eigen::ConstRef<VectorMax3d> x, const double t) const
+{
+    assert(x.size() == dim());
+    const VectorMax3d y =
+        rotation(t) * x + (1 - t) * m_origin_t0 + t * m_origin_t1;
+    return m_parent ? (*m_parent)(y, t) : y;
+}
+
+double RigidBodyMotion::max_acceleration(Eigen::ConstRef<VectorMax3d> x) const
+{
+    // The translation of a free body is linear, so only rotations accelerate
+    // the point. For a chain of rotations R₁(t)⋯Rₖ(t), the product rule
+    // gives terms Rᵢ'⋯Rⱼ' acting on an arm of length at most rⱼ, for a total
+    // of at most (∑ᵢ ‖ωᵢ‖)² maxⱼ rⱼ.
+    double arm = x.norm();
+    double max_arm = 0;
+    double total_speed = 0;
+    for (const RigidBodyMotion* b = this; b != nullptr; b = b->m_parent.get()) {
+        max_arm = std::max(max_arm, arm);
+        total_speed += b->m_angular_velocity.norm();
+        if (b->m_parent) {
+            arm += b->m_origin_t0.norm(); // Triangle inequality
+        }
+    }
+    return total_speed * total_speed * max_arm;
+}
+
+// ============================================================================
+
+RigidTrajectory::RigidTrajectory(
+    std::shared_ptr<const RigidBodyMotion> body,
+    Eigen::ConstRef<VectorMax3d> point)
+    : m_body(std::move(body))
+    , m_point(point)
+{
+    assert(m_body != nullptr);
+    m_max_acceleration = m_body->max_acceleration(m_point);
+}
+
+VectorMax3d RigidTrajectory::operator()(const double t) const
+{
+    return (*m_body)(m_point, t);
+}
+
+double RigidTrajectory::max_distance_from_linear(
+    const double t0, const double t1) const
+{
+    const double dt = t1 - t0;
+    return m_max_acceleration * dt * dt / 8;
+}
+
+std::vector<RigidTrajectory> build_rigid_trajectories(
+    const std::vector<std::shared_ptr<const RigidBodyMotion>>& bodies,
+    Eigen::ConstRef<Eigen::VectorXi> body_ids,
+    Eigen::ConstRef<Eigen::MatrixXd> points)
+{
+    assert(body_ids.size() == points.rows());
+
+    std::vector<RigidTrajectory> trajectories;
+    trajectories.reserve(points.rows());
+    for (int i = 0; i < points.rows(); i++) {
+        if (body_ids[i] < 0 || size_t(body_ids[i]) >= bodies.size()) {
+            throw std::out_of_range("Body index is out of range!");
+        }
+        trajectories.emplace_back(
+            bodies[body_ids[i]], points.row(i).transpose());
+    }
+    return trajectories;
+}
+
+} // namespace ipc
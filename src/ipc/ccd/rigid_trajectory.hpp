@@ -0,0 +1,130 @@
+#pragma once
+
+#include <ipc/ccd/nonlinear_ccd.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace ipc {
+
+/// @brief Motion of a rigid body with constant linear and angular velocity.
+///
+/// The origin of the body frame is the body's center of rotation. A body can
+/// be attached to a parent body by a revolute joint (at the origin of its
+/// frame) to form an articulated chain.
+class RigidBodyMotion {
+public:
+    /// @brief Construct the motion of a free rigid body.
+    /// @param center_t0 Position of the center of rotation at t=0.
+    /// @param center_t1 Position of the center of rotation at t=1.
+    /// @param rotation_t0 Orientation of the body at t=0.
+    /// @param angular_velocity Angular velocity in world coordinates (size 1 in 2D and 3 in 3D).
+    RigidBodyMotion(
+        Eigen::ConstRef<VectorMax3d> center_t0,
+        Eigen::ConstRef<VectorMax3d> center_t1,
+        Eigen::ConstRef<MatrixMax3d> rotation_t0,
+        Eigen::ConstRef<VectorMax3d> angular_velocity);
+
+    /// @brief Construct the motion of a body attached to a parent body by a revolute joint.
+    /// @param parent Motion of the parent body.
+    /// @param joint Position of the joint in the parent's body frame.
+    /// @param rotation_t0 Orientation of the body relative to the parent at t=0.
+    /// @param angular_velocity Angular velocity relative to the parent in the parent's body frame (size 1 in 2D and 3 in 3D).
+    RigidBodyMotion(
+        std::shared_ptr<const RigidBodyMotion> parent,
+        Eigen::ConstRef<VectorMax3d> joint,
+        Eigen::ConstRef<MatrixMax3d> rotation_t0,
+        Eigen::ConstRef<VectorMax3d> angular_velocity);
+
+    /// @brief Get the dimension of the body.
+    int dim() const { return m_origin_t0.size(); }
+
+    /// @brief Compute the world position of a point fixed to the body.
+    /// @param x Position of the point in the body frame.
+    /// @param t Time.
+    /// @return The world position of the point at time t.
+    VectorMax3d
+    operator()(Eigen::ConstRef<VectorMax3d> x, const double t) const;
+
+    /// @brief Compute the orientation of the body relative to its parent.
+    /// @param t Time.
+    /// @return The rotation from the body frame to the parent frame (or world frame if the body has no parent).
+    MatrixMax3d rotation(const double t) const;
+
+    /// @brief Compute an upper bound on the acceleration of a point fixed to the body.
+    /// @param x Position of the point in the body frame.
+    /// @return An upper bound on \f$\|\ddot{x}(t)\|\f$ for all t.
+    double max_acceleration(Eigen::ConstRef<VectorMax3d> x) const;
+
+    /// @brief Get the motion of the parent body (nullptr if the body is free).
+    const std::shared_ptr<const RigidBodyMotion>& parent() const
+    {
+        return m_parent;
+    }
+
+private:
+    /// @brief Motion of the parent body.
+    std::shared_ptr<const RigidBodyMotion> m_parent;
+    /// @brief Position of the origin at t=0 in the parent (or world) frame.
+    VectorMax3d m_origin_t0;
+    /// @brief Position of the origin at t=1 in the parent (or world) frame.
+    VectorMax3d m_origin_t1;
+    /// @brief Orientation relative to the parent at t=0.
+    MatrixMax3d m_rotation_t0;
+    /// @brief Angular velocity relative to the parent.
+    VectorMax3d m_angular_velocity;
+};
+
+/// @brief Trajectory of a point fixed to a rigid (or articulated) body.
+///
+/// The deviation from linear motion has a closed-form bound: the error of
+/// linear interpolation over \f$[t_0, t_1]\f$ is at most
+/// \f$\frac{(t_1 - t_0)^2}{8} \max \|\ddot{x}\|\f$, and the acceleration of a
+/// point on a chain of rotating bodies is at most
+/// \f$(\sum_i \|\omega_i\|)^2 \max_i r_i\f$ where \f$r_i\f$ bounds the arm
+/// length from the i-th center of rotation.
+class RigidTrajectory : virtual public NonlinearTrajectory {
+public:
+    /// @brief Construct the trajectory of a point fixed to a body.
+    /// @param body Motion of the body.
+    /// @param point Position of the point in the body frame.
+    RigidTrajectory(
+        std::shared_ptr<const RigidBodyMotion> body,
+        Eigen::ConstRef<VectorMax3d> point);
+
+    /// @brief Compute the point's position at time t
+    VectorMax3d operator()(const double t) const override;
+
+    /// @brief Compute the maximum distance from the nonlinear trajectory to a linearized trajectory
+    /// @param[in] t0 Start time of the trajectory
+    /// @param[in] t1 End time of the trajectory
+    double
+    max_distance_from_linear(const double t0, const double t1) const override;
+
+    /// @brief Get the motion of the body.
+    const std::shared_ptr<const RigidBodyMotion>& body() const
+    {
+        return m_body;
+    }
+
+    /// @brief Get the position of the point in the body frame.
+    const VectorMax3d& point() const { return m_point; }
+
+private:
+    std::shared_ptr<const RigidBodyMotion> m_body;
+    VectorMax3d m_point;
+    /// @brief Cached bound on the acceleration of the point.
+    double m_max_acceleration;
+};
+
+/// @brief Build the trajectories of the vertices of a set of bodies.
+/// @param bodies Motion of each body.
+/// @param body_ids Body of each vertex.
+/// @param points Position of each vertex in its body's frame (rowwise).
+/// @return The trajectory of each vertex.
+std::vector<RigidTrajectory> build_rigid_trajectories(
+    const std::vector<std::shared_ptr<const RigidBodyMotion>>& bodies,
+    Eigen::ConstRef<Eigen::VectorXi> body_ids,
+    Eigen::ConstRef<Eigen::MatrixXd> points);
+
+} // namespace ipc
@@ -1,6 +1,7 @@
 #include "tight_inclusion_ccd.hpp"
 
 #include <ipc/ccd/check_initial_distance.hpp>
+#include <ipc/ccd/float_ccd_prefilter.hpp>
 #include <ipc/distance/edge_edge.hpp>
 #include <ipc/distance/point_edge.hpp>
 #include <ipc/distance/point_point.hpp>
@@ -30,18 +31,79 @@ TightInclusionCCD::TightInclusionCCD(
 {
 }
 
+std::shared_ptr<const NarrowPhaseCCD> TightInclusionCCD::first_tier() const
+{
+    if (initial_max_iterations <= 0
+        || (max_iterations != TIGHT_INCLUSION_UNLIMITED_ITERATIONS
+            && initial_max_iterations >= max_iterations)) {
+        return nullptr; // Tiering would not save any iterations
+    }
+
+    auto tier = std::make_shared<TightInclusionCCD>(*this);
+    tier->max_iterations = initial_max_iterations;
+    tier->initial_max_iterations = 0;
+    tier->m_is_first_tier = true;
+    // Unlike a plain copy, the tier records into the counters of this object.
+    tier->m_statistics.share(m_statistics);
+    return tier;
+}
+
+void TightInclusionCCD::reset_statistics()
+{
+    m_statistics->num_queries = 0;
+    m_statistics->num_first_tier_queries = 0;
+    m_statistics->num_exhausted = 0;
+    m_statistics->total_exhausted_budget = 0;
+    m_statistics->num_fallbacks = 0;
+    m_statistics->num_prefiltered = 0;
+}
+
+bool TightInclusionCCD::is_prefiltered(
+    const bool may_collide, double& toi) const
+{
+    if (may_collide) {
+        return false;
+    }
+    m_statistics->num_prefiltered.fetch_add(1, std::memory_order_relaxed);
+    toi = std::numeric_limits<double>::infinity();
+    return true;
+}
+
+bool TightInclusionCCD::record_solver_call(
+    const long _max_iterations,
+    const double input_tolerance,
+    const double output_tolerance) const
+{
+    // Tight Inclusion only stops short of the requested tolerance when it
+    // runs out of iterations.
+    if (_max_iterations == TIGHT_INCLUSION_UNLIMITED_ITERATIONS
+        || input_tolerance >= output_tolerance) {
+        return false;
+    }
+    m_statistics->num_exhausted.fetch_add(1, std::memory_order_relaxed);
+    m_statistics->total_exhausted_budget.fetch_add(
+        _max_iterations, std::memory_order_relaxed);
+    return true;
+}
+
 bool TightInclusionCCD::ccd_strategy(
     const std::function<bool(
         double /*min_distance*/, bool /*no_zero_toi*/, double& /*toi*/)>& ccd,
     const double min_distance,
     const double initial_distance,
     const double conservative_rescaling,
-    double& toi)
+    double& toi) const
 {
     if (check_initial_distance(initial_distance, min_distance, toi)) {
         return true;
     }
 
+    m_statistics->num_queries.fetch_add(1, std::memory_order_relaxed);
+    if (m_is_first_tier) {
+        m_statistics->num_first_tier_queries.fetch_add(
+            1, std::memory_order_relaxed);
+    }
+
     double min_effective_distance =
         (1.0 - conservative_rescaling) * (initial_distance - min_distance);
     // Tight Inclusion performs better when the minimum separation is small
@@ -62,6 +124,14 @@ bool TightInclusionCCD::ccd_strategy(
     // }
 
     if (is_impacting && toi < SMALL_TOI) {
+        if (m_is_first_tier) {
+            // Leave the query to the full method instead of running the
+            // unlimited fallback here.
+            toi = UNDECIDED_TOI;
+            return true;
+        }
+
+        m_statistics->num_fallbacks.fetch_add(1, std::memory_order_relaxed);
         is_impacting =
             ccd(/*min_distance=*/min_distance, /*no_zero_toi=*/true, toi);
 
@@ -98,6 +168,14 @@ bool TightInclusionCCD::point_point_ccd_3D(
                          double& _toi) -> bool {
         const long _max_iterations =
             no_zero_toi ? TIGHT_INCLUSION_UNLIMITED_ITERATIONS : max_iterations;
+        if (use_float_prefilter
+            && is_prefiltered(
+                edge_edge_ccd_prefilter(
+                    p0_t0, p0_t0, p1_t0, p1_t0, p0_t1, p0_t1, p1_t1, p1_t1,
+                    _min_distance),
+                _toi)) {
+            return false;
+        }
 
         double output_tolerance;
         // NOTE: Use degenerate edge-edge
@@ -112,6 +190,9 @@ bool TightInclusionCCD::point_point_ccd_3D(
             output_tolerance,             // delta_actual
             no_zero_toi);
 
+        const bool is_exhausted = record_solver_call(
+            _max_iterations, adjusted_tolerance, output_tolerance);
+
         if (adjusted_tolerance < output_tolerance && toi < SMALL_TOI) {
             logger().trace(
                 "ticcd::edgeEdgeCCD exceeded iteration limit (min_dist={:g} "
@@ -120,6 +201,10 @@ bool TightInclusionCCD::point_point_ccd_3D(
                 output_tolerance, toi);
         }
 
+        if (is_impacting && is_exhausted && m_is_first_tier) {
+            _toi = UNDECIDED_TOI; // The conservative result is not final
+        }
+
         return is_impacting;
     };
 
@@ -171,6 +256,14 @@ bool TightInclusionCCD::point_edge_ccd_3D(
                          double& _toi) -> bool {
         const long _max_iterations =
             no_zero_toi ? TIGHT_INCLUSION_UNLIMITED_ITERATIONS : max_iterations;
+        if (use_float_prefilter
+            && is_prefiltered(
+                edge_edge_ccd_prefilter(
+                    p_t0, p_t0, e0_t0, e1_t0, p_t1, p_t1, e0_t1, e1_t1,
+                    _min_distance),
+                _toi)) {
+            return false;
+        }
 
         double output_tolerance = tolerance;
         // NOTE: Use degenerate edge-edge
@@ -185,6 +278,9 @@ bool TightInclusionCCD::point_edge_ccd_3D(
             output_tolerance,             // delta_actual
             no_zero_toi);
 
+        const bool is_exhausted = record_solver_call(
+            _max_iterations, adjusted_tolerance, output_tolerance);
+
         if (adjusted_tolerance < output_tolerance && toi < SMALL_TOI) {
             logger().trace(
                 "ticcd::edgeEdgeCCD exceeded iteration limit (min_dist={:g} "
@@ -193,6 +289,10 @@ bool TightInclusionCCD::point_edge_ccd_3D(
                 output_tolerance, toi);
         }
 
+        if (is_impacting && is_exhausted && m_is_first_tier) {
+            _toi = UNDECIDED_TOI; // The conservative result is not final
+        }
+
         return is_impacting;
     };
 
@@ -249,6 +349,14 @@ bool TightInclusionCCD::edge_edge_ccd(
                          double& _toi) -> bool {
         const long _max_iterations =
             no_zero_toi ? TIGHT_INCLUSION_UNLIMITED_ITERATIONS : max_iterations;
+        if (use_float_prefilter
+            && is_prefiltered(
+                edge_edge_ccd_prefilter(
+                    ea0_t0, ea1_t0, eb0_t0, eb1_t0, ea0_t1, ea1_t1, eb0_t1,
+                    eb1_t1, _min_distance),
+                _toi)) {
+            return false;
+        }
 
         double output_tolerance;
         bool is_impacting = ticcd::edgeEdgeCCD(
@@ -262,6 +370,9 @@ bool TightInclusionCCD::edge_edge_ccd(
             output_tolerance,             // delta_actual
             no_zero_toi);
 
+        const bool is_exhausted = record_solver_call(
+            _max_iterations, adjusted_tolerance, output_tolerance);
+
         if (adjusted_tolerance < output_tolerance && toi < SMALL_TOI) {
             logger().trace(
                 "ticcd::edgeEdgeCCD exceeded iteration limit (min_dist={:g} "
@@ -270,6 +381,10 @@ bool TightInclusionCCD::edge_edge_ccd(
                 output_tolerance, toi);
         }
 
+        if (is_impacting && is_exhausted && m_is_first_tier) {
+            _toi = UNDECIDED_TOI; // The conservative result is not final
+        }
+
         return is_impacting;
     };
 
@@ -307,6 +422,14 @@ bool TightInclusionCCD::point_triangle_ccd(
                          double& _toi) -> bool {
         const long _max_iterations =
             no_zero_toi ? TIGHT_INCLUSION_UNLIMITED_ITERATIONS : max_iterations;
+        if (use_float_prefilter
+            && is_prefiltered(
+                point_triangle_ccd_prefilter(
+                    p_t0, t0_t0, t1_t0, t2_t0, p_t1, t0_t1, t1_t1, t2_t1,
+                    _min_distance),
+                _toi)) {
+            return false;
+        }
 
         double output_tolerance;
         bool is_impacting = ticcd::vertexFaceCCD(
@@ -320,6 +443,9 @@ bool TightInclusionCCD::point_triangle_ccd(
             output_tolerance,             // delta_actual
             no_zero_toi);
 
+        const bool is_exhausted = record_solver_call(
+            _max_iterations, adjusted_tolerance, output_tolerance);
+
         if (adjusted_tolerance < output_tolerance && toi < SMALL_TOI) {
             logger().trace(
                 "ticcd::vertexFaceCCD exceeded iteration limit (min_dist={:g} "
@@ -328,6 +454,10 @@ bool TightInclusionCCD::point_triangle_ccd(
                 output_tolerance, toi);
         }
 
+        if (is_impacting && is_exhausted && m_is_first_tier) {
+            _toi = UNDECIDED_TOI; // The conservative result is not final
+        }
+
         return is_impacting;
     };
 
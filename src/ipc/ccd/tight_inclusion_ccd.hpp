@@ -2,6 +2,10 @@
 
 #include <ipc/ccd/narrow_phase_ccd.hpp>
 
+#include <atomic>
+#include <functional>
+#include <memory>
+
 namespace ipc {
 
 class TightInclusionCCD : public NarrowPhaseCCD {
@@ -24,6 +28,26 @@ public:
         const long max_iterations = DEFAULT_MAX_ITERATIONS,
         const double conservative_rescaling = DEFAULT_CONSERVATIVE_RESCALING);
 
+    /// @brief Counters of the work done by the solver.
+    /// @note Each object has its own counters, except the first tier which
+    /// records into the counters of the object it was created from.
+    struct Statistics {
+        /// @brief Number of queries that reached the solver.
+        std::atomic<size_t> num_queries { 0 };
+        /// @brief Number of queries run with the first-tier iteration budget.
+        std::atomic<size_t> num_first_tier_queries { 0 };
+        /// @brief Number of solver calls that exhausted their iteration budget.
+        std::atomic<size_t> num_exhausted { 0 };
+        /// @brief Sum of the iteration budgets of the solver calls that
+        /// exhausted them.
+        std::atomic<size_t> total_exhausted_budget { 0 };
+        /// @brief Number of small time-of-impact fallbacks (reruns without the
+        /// effective minimum separation and unlimited iterations).
+        std::atomic<size_t> num_fallbacks { 0 };
+        /// @brief Number of solver calls skipped by the float prefilter.
+        std::atomic<size_t> num_prefiltered { 0 };
+    };
+
     /// @brief Computes the time of impact between two points using continuous collision detection.
     /// @param[in] p0_t0 The initial position of the first point.
     /// @param[in] p1_t0 The initial position of the second point.
@@ -125,6 +149,33 @@ public:
     /// @brief Conservative rescaling of the time of impact.
     double conservative_rescaling;
 
+    /// @brief Iteration budget of the first tier (0 disables tiering).
+    ///
+    /// When \f$0 < \f$ initial_max_iterations \f$<\f$ max_iterations,
+    /// first_tier() runs every query with this smaller budget. Queries that
+    /// exhaust the budget (or would need the small time-of-impact fallback)
+    /// are left undecided and escalated to max_iterations.
+    long initial_max_iterations = 0;
+
+    /// @brief Run a conservative single-precision filter before the solver.
+    ///
+    /// Queries that are provably collision free in float32 with outward
+    /// rounding are discarded without calling Tight Inclusion.
+    /// @see edge_edge_ccd_prefilter, point_triangle_ccd_prefilter
+    bool use_float_prefilter = false;
+
+    /// @brief Get a copy of this method limited to initial_max_iterations.
+    /// @return The first tier or nullptr if tiering is disabled.
+    std::shared_ptr<const NarrowPhaseCCD> first_tier() const override;
+
+    /// @brief Get the counters of the work done by the solver.
+    /// @note The counters accumulate until reset_statistics() is called, so
+    /// reset them before a call to get the work done by that call.
+    const Statistics& statistics() const { return *m_statistics; }
+
+    /// @brief Reset the counters of the work done by the solver.
+    void reset_statistics();
+
 private:
     /// @brief Computes the time of impact between two points in 3D using continuous collision detection.
     /// @param[in] p0_t0 The initial position of the first point.
@@ -173,14 +224,53 @@ private:
     /// @param[in] conservative_rescaling The conservative rescaling of the time of impact.
     /// @param[out] toi Output time of impact.
     /// @return True if a collision was detected, false otherwise.
-    static bool ccd_strategy(
+    bool ccd_strategy(
         const std::function<bool(
             double /*min_distance*/, bool /*no_zero_toi*/, double& /*toi*/)>&
             ccd,
         const double min_distance,
         const double initial_distance,
         const double conservative_rescaling,
-        double& toi);
+        double& toi) const;
+
+    /// @brief Record a call to the Tight Inclusion solver.
+    /// @param[in] max_iterations The iteration budget of the call.
+    /// @param[in] input_tolerance The requested solver tolerance.
+    /// @param[in] output_tolerance The tolerance reached by the solver.
+    /// @return True if the call exhausted its iteration budget.
+    bool record_solver_call(
+        const long max_iterations,
+        const double input_tolerance,
+        const double output_tolerance) const;
+
+    /// @brief Record the result of the float prefilter.
+    /// @param[in] may_collide The result of the prefilter.
+    /// @param[out] toi Set to infinity if the query is discarded.
+    /// @return True if the query is discarded.
+    bool is_prefiltered(const bool may_collide, double& toi) const;
+
+    /// @brief Whether this is the first tier of another TightInclusionCCD.
+    bool m_is_first_tier = false;
+
+    /// @brief Pointer to counters that is not shared by copies.
+    class StatisticsPointer {
+    public:
+        StatisticsPointer() = default;
+        StatisticsPointer(const StatisticsPointer&) { }
+        StatisticsPointer& operator=(const StatisticsPointer&) { return *this; }
+
+        Statistics& operator*() const { return *m_ptr; }
+        Statistics* operator->() const { return m_ptr.get(); }
+
+        /// @brief Record into the counters of another object.
+        void share(const StatisticsPointer& other) { m_ptr = other.m_ptr; }
+
+    private:
+        std::shared_ptr<Statistics> m_ptr = std::make_shared<Statistics>();
+    };
+
+    /// @brief Counters of the work done by the solver.
+    StatisticsPointer m_statistics;
 };
 
 } // namespace ipc
\ No newline at end of file
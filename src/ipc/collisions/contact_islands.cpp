@@ -0,0 +1,173 @@
+#include "contact_islands.hpp"
+
+#include <ipc/candidates/candidates.hpp>
+#include <ipc/collisions/normal/normal_collisions.hpp>
+#include <ipc/collisions/tangential/tangential_collisions.hpp>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <atomic>
+
+namespace ipc {
+
+namespace {
+    /// @brief Lock-free disjoint-set forest.
+    /// Roots are always linked below the root with the smaller index, so the
+    /// representative of each set is its smallest element.
+    class ConcurrentUnionFind {
+    public:
+        explicit ConcurrentUnionFind(const size_t n) : parent(n)
+        {
+            tbb::parallel_for(size_t(0), n, [&](size_t i) {
+                parent[i].store(int(i), std::memory_order_relaxed);
+            });
+        }
+
+        int find(int x)
+        {
+            while (true) {
+                int p = parent[x].load();
+                const int gp = parent[p].load();
+                if (p == gp) {
+                    return p;
+                }
+                // Path halving: parents only ever move closer to the root.
+                parent[x].compare_exchange_weak(p, gp);
+                x = gp;
+            }
+        }
+
+        void unite(int a, int b)
+        {
+            while (true) {
+                a = find(a);
+                b = find(b);
+                if (a == b) {
+                    return;
+                }
+                if (a < b) {
+                    std::swap(a, b);
+                }
+                // Link the larger root below the smaller one. This fails if
+                // another thread linked a in the meantime, in which case we
+                // retry from the new roots.
+                int expected = a;
+                if (parent[a].compare_exchange_strong(expected, b)) {
+                    return;
+                }
+            }
+        }
+
+    private:
+        std::vector<std::atomic<int>> parent;
+    };
+} // namespace
+
+template <typename StencilsT>
+void ContactIslands::build(const CollisionMesh& mesh, const StencilsT& stencils)
+{
+    const Eigen::MatrixXi& edges = mesh.edges();
+    const Eigen::MatrixXi& faces = mesh.faces();
+    const size_t num_vertices = mesh.num_vertices();
+
+    ConcurrentUnionFind union_find(num_vertices);
+
+    // Mesh connectivity (faces are connected through their edges)
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(size_t(0), size_t(edges.rows())),
+        [&](const tbb::blocked_range<size_t>& r) {
+            for (size_t i = r.begin(); i < r.end(); i++) {
+                union_find.unite(edges(i, 0), edges(i, 1));
+            }
+        });
+
+    // Contact connectivity
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(size_t(0), stencils.size()),
+        [&](const tbb::blocked_range<size_t>& r) {
+            for (size_t i = r.begin(); i < r.end(); i++) {
+                const std::array<long, 4> vids =
+                    stencils[i].vertex_ids(edges, faces);
+                for (size_t j = 1; j < vids.size() && vids[j] >= 0; j++) {
+                    union_find.unite(vids[0], vids[j]);
+                }
+            }
+        });
+
+    // Label the islands in order of their smallest vertex
+    std::vector<int> roots(num_vertices);
+    tbb::parallel_for(size_t(0), num_vertices, [&](size_t i) {
+        roots[i] = union_find.find(i);
+    });
+
+    std::vector<int> root_to_island(num_vertices, -1);
+    int num_islands = 0;
+    for (size_t i = 0; i < num_vertices; i++) {
+        if (size_t(roots[i]) == i) {
+            root_to_island[i] = num_islands++;
+        }
+    }
+
+    m_vertex_island_ids.resize(num_vertices);
+    tbb::parallel_for(size_t(0), num_vertices, [&](size_t i) {
+        m_vertex_island_ids[i] = root_to_island[roots[i]];
+    });
+
+    m_stencil_island_ids.resize(stencils.size());
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(size_t(0), stencils.size()),
+        [&](const tbb::blocked_range<size_t>& r) {
+            for (size_t i = r.begin(); i < r.end(); i++) {
+                const long vi = stencils[i].vertex_ids(edges, faces)[0];
+                m_stencil_island_ids[i] = m_vertex_island_ids[vi];
+            }
+        });
+
+    // Group the stencils by island (counting sort)
+    m_island_offsets.assign(num_islands + 1, 0);
+    for (size_t i = 0; i < stencils.size(); i++) {
+        m_island_offsets[m_stencil_island_ids[i] + 1]++;
+    }
+    for (int i = 0; i < num_islands; i++) {
+        m_island_offsets[i + 1] += m_island_offsets[i];
+    }
+
+    m_island_stencils.resize(stencils.size());
+    std::vector<size_t> fill(
+        m_island_offsets.begin(), m_island_offsets.end() - 1);
+    for (size_t i = 0; i < stencils.size(); i++) {
+        m_island_stencils[fill[m_stencil_island_ids[i]]++] = i;
+    }
+}
+
+void ContactIslands::clear()
+{
+    m_vertex_island_ids.resize(0);
+    m_stencil_island_ids.resize(0);
+    m_island_stencils.clear();
+    m_island_offsets.assign(1, 0);
+}
+
+std::vector<size_t> ContactIslands::stencil_ids(const int island_id) const
+{
+    if (island_id < 0 || size_t(island_id) >= num_islands()) {
+        throw std::out_of_range("Island index is out of range!");
+    }
+    return std::vector<size_t>(
+        m_island_stencils.begin() + m_island_offsets[island_id],
+        m_island_stencils.begin() + m_island_offsets[island_id + 1]);
+}
+
+// -----------------------------------------------------------------------------
+
+template void ContactIslands::build<Candidates>(
+    const CollisionMesh& mesh, const Candidates& stencils);
+
+template void ContactIslands::build<NormalCollisions>(
+    const CollisionMesh& mesh, const NormalCollisions& stencils);
+
+template void ContactIslands::build<TangentialCollisions>(
+    const CollisionMesh& mesh, const TangentialCollisions& stencils);
+
+} // namespace ipc
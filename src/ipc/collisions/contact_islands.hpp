@@ -0,0 +1,64 @@
+#pragma once
+
+#include <ipc/collision_mesh.hpp>
+
+#include <Eigen/Core>
+
+#include <vector>
+
+namespace ipc {
+
+/// @brief Decomposition of the contact graph into independent islands.
+///
+/// Two vertices belong to the same island if they are connected through the
+/// mesh connectivity (edges) or through a collision stencil. Islands can be
+/// assembled and solved independently of each other.
+class ContactIslands {
+public:
+    ContactIslands() = default;
+
+    /// @brief Build the islands from a set of collision stencils.
+    /// @tparam StencilsT Type of the stencils (e.g., Candidates or NormalCollisions).
+    /// @param mesh The collision mesh.
+    /// @param stencils Collision stencils connecting the vertices.
+    template <typename StencilsT>
+    void build(const CollisionMesh& mesh, const StencilsT& stencils);
+
+    /// @brief Clear the islands.
+    void clear();
+
+    /// @brief Get the number of islands.
+    size_t num_islands() const { return m_island_offsets.size() - 1; }
+
+    /// @brief Get the island id of each vertex.
+    const Eigen::VectorXi& vertex_island_ids() const
+    {
+        return m_vertex_island_ids;
+    }
+
+    /// @brief Get the island id of each stencil.
+    const Eigen::VectorXi& stencil_island_ids() const
+    {
+        return m_stencil_island_ids;
+    }
+
+    /// @brief Get the indices of the stencils in an island.
+    /// @param island_id The island id.
+    /// @return Indices into the stencils used to build the islands.
+    std::vector<size_t> stencil_ids(const int island_id) const;
+
+private:
+    /// @brief Island id of each vertex.
+    Eigen::VectorXi m_vertex_island_ids;
+
+    /// @brief Island id of each stencil.
+    Eigen::VectorXi m_stencil_island_ids;
+
+    /// @brief Stencil indices grouped by island.
+    std::vector<size_t> m_island_stencils;
+
+    /// @brief Offsets of each island into m_island_stencils.
+    std::vector<size_t> m_island_offsets = { { 0 } };
+};
+
+} // namespace ipc
@@ -32,10 +32,9 @@ EdgeEdgeNormalCollision::EdgeEdgeNormalCollision(
     const long _edge1_id,
     const double _eps_x,
     const double _weight,
-    const Eigen::SparseVector<double>& _weight_gradient,
     const EdgeEdgeDistanceType _dtype)
     : EdgeEdgeCandidate(_edge0_id, _edge1_id)
-    , NormalCollision(_weight, _weight_gradient)
+    , NormalCollision(_weight)
     , eps_x(_eps_x)
     , dtype(_dtype)
 {
@@ -25,7 +25,6 @@ public:
         const long edge1_id,
         const double eps_x,
         const double weight,
-        const Eigen::SparseVector<double>& weight_gradient,
         const EdgeEdgeDistanceType dtype = EdgeEdgeDistanceType::AUTO);
 
     /// @brief Does the distance potentially have to be mollified?
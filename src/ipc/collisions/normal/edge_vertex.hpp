@@ -18,10 +18,9 @@ public:
     EdgeVertexNormalCollision(
         const long _edge_id,
         const long _vertex_id,
-        const double _weight,
-        const Eigen::SparseVector<double>& _weight_gradient)
+        const double _weight)
         : EdgeVertexCandidate(_edge_id, _vertex_id)
-        , NormalCollision(_weight, _weight_gradient)
+        , NormalCollision(_weight)
     {
     }
 
@@ -18,10 +18,9 @@ public:
     FaceVertexNormalCollision(
         const long _face_id,
         const long _vertex_id,
-        const double _weight,
-        const Eigen::SparseVector<double>& _weight_gradient)
+        const double _weight)
         : FaceVertexCandidate(_face_id, _vertex_id)
-        , NormalCollision(_weight, _weight_gradient)
+        , NormalCollision(_weight)
     {
     }
 
@@ -2,12 +2,7 @@
 
 namespace ipc {
 
-NormalCollision::NormalCollision(
-    const double _weight, const Eigen::SparseVector<double>& _weight_gradient)
-    : weight(_weight)
-    , weight_gradient(_weight_gradient)
-{
-}
+NormalCollision::NormalCollision(const double _weight) : weight(_weight) { }
 
 double NormalCollision::mollifier(Eigen::ConstRef<VectorMax12d> positions) const
 {
@@ -13,9 +13,7 @@ class NormalCollision : virtual public CollisionStencil {
 public:
     NormalCollision() = default;
 
-    NormalCollision(
-        const double weight,
-        const Eigen::SparseVector<double>& weight_gradient);
+    NormalCollision(const double weight);
 
     virtual ~NormalCollision() = default;
 
@@ -94,9 +92,6 @@ public:
 
     /// @brief The term's weight (e.g., collision area)
     double weight = 1;
-
-    /// @brief The gradient of the term's weight wrt the rest positions.
-    Eigen::SparseVector<double> weight_gradient;
 };
 
 } // namespace ipc
@@ -2,10 +2,12 @@
 
 #include <ipc/collisions/normal/normal_collisions_builder.hpp>
 #include <ipc/distance/edge_edge.hpp>
+#include <ipc/distance/edge_edge_mollifier.hpp>
 #include <ipc/distance/point_edge.hpp>
 #include <ipc/distance/point_line.hpp>
 #include <ipc/distance/point_plane.hpp>
 #include <ipc/distance/point_point.hpp>
+#include <ipc/distance/point_triangle.hpp>
 #include <ipc/utils/local_to_global.hpp>
 
 #include <tbb/blocked_range.h>
@@ -14,7 +16,9 @@
 #include <tbb/parallel_reduce.h>
 #include <tbb/parallel_sort.h>
 
-#include <stdexcept> // std::out_of_range
+#include <algorithm>
+#include <atomic>
+#include <stdexcept> // std::out_of_range, std::logic_error, std::runtime_error
 
 namespace ipc {
 
@@ -151,7 +155,11 @@ void NormalCollisions::build(
 
     const double inflation_radius = 0.5 * (dhat + dmin);
 
-    Candidates candidates;
+    // Build the candidates in place if they are kept for update().
+    Candidates local_candidates;
+    Candidates& candidates = enable_updates()
+        ? m_candidates
+        : (m_workspace ? m_workspace->get<Candidates>() : local_candidates);
     candidates.build(mesh, vertices, inflation_radius, broad_phase);
 
     this->build(candidates, mesh, vertices, dhat, dmin);
@@ -168,14 +176,294 @@ void NormalCollisions::build(
 
     clear();
 
+    m_dhat = dhat;
+    m_dmin = dmin;
+    if (enable_updates()) {
+        // Keep the candidates and their distances for update().
+        if (&candidates != &m_candidates) {
+            m_candidates = candidates;
+        }
+        update_candidate_states(mesh, vertices, /*is_reference=*/true);
+    } else {
+        m_candidates.clear();
+        m_reference_vertices.resize(0, 0);
+        m_candidate_distances.clear();
+        m_candidate_states.clear();
+    }
+
+    build_collisions(candidates, mesh, vertices, dhat, dmin);
+}
+
+void NormalCollisions::update(
+    const CollisionMesh& mesh, Eigen::ConstRef<Eigen::MatrixXd> vertices)
+{
+    assert(vertices.rows() == mesh.num_vertices());
+
+    if (!enable_updates()) {
+        throw std::logic_error(
+            "Updates must be enabled before building the collisions!");
+    }
+    if (m_reference_vertices.rows() != vertices.rows()
+        || m_reference_vertices.cols() != vertices.cols()) {
+        // Updates were enabled after the last build (or the mesh changed).
+        throw std::runtime_error(
+            "No build with updates enabled to update the collisions from!");
+    }
+
+    const bool is_changed =
+        update_candidate_states(mesh, vertices, /*is_reference=*/false);
+
+    if (!is_changed && !use_improved_max_approximator()) {
+        // The same collisions are active, so keep them and only update the
+        // closest pairs of the edge-edge collisions (used by their distance).
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(size_t(0), ee_collisions.size()),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t i = r.begin(); i < r.end(); i++) {
+                    EdgeEdgeNormalCollision& ee = ee_collisions[i];
+                    const Eigen::Vector3d ea0 =
+                        vertices.row(mesh.edges()(ee.edge0_id, 0));
+                    const Eigen::Vector3d ea1 =
+                        vertices.row(mesh.edges()(ee.edge0_id, 1));
+                    const Eigen::Vector3d eb0 =
+                        vertices.row(mesh.edges()(ee.edge1_id, 0));
+                    const Eigen::Vector3d eb1 =
+                        vertices.row(mesh.edges()(ee.edge1_id, 1));
+                    ee.dtype = edge_edge_distance_type(ea0, ea1, eb0, eb1);
+                }
+            });
+        return;
+    }
+
+    // Rebuild the collisions from the active candidates only.
+    const size_t ev_offset = m_candidates.vv_candidates.size();
+    const size_t ee_offset = ev_offset + m_candidates.ev_candidates.size();
+    const size_t fv_offset = ee_offset + m_candidates.ee_candidates.size();
+
+    Candidates local_active_candidates;
+    Candidates& active_candidates = m_workspace
+        ? m_workspace->get<Candidates>()
+        : local_active_candidates;
+    active_candidates.clear();
+    for (size_t i = 0; i < m_candidates.vv_candidates.size(); i++) {
+        if (m_candidate_states[i]) {
+            active_candidates.vv_candidates.push_back(
+                m_candidates.vv_candidates[i]);
+        }
+    }
+    for (size_t i = 0; i < m_candidates.ev_candidates.size(); i++) {
+        if (m_candidate_states[ev_offset + i]) {
+            active_candidates.ev_candidates.push_back(
+                m_candidates.ev_candidates[i]);
+        }
+    }
+    for (size_t i = 0; i < m_candidates.ee_candidates.size(); i++) {
+        if (m_candidate_states[ee_offset + i]) {
+            active_candidates.ee_candidates.push_back(
+                m_candidates.ee_candidates[i]);
+        }
+    }
+    for (size_t i = 0; i < m_candidates.fv_candidates.size(); i++) {
+        if (m_candidate_states[fv_offset + i]) {
+            active_candidates.fv_candidates.push_back(
+                m_candidates.fv_candidates[i]);
+        }
+    }
+
+    build_collisions(active_candidates, mesh, vertices, m_dhat, m_dmin);
+}
+
+bool NormalCollisions::update_candidate_states(
+    const CollisionMesh& mesh,
+    Eigen::ConstRef<Eigen::MatrixXd> vertices,
+    const bool is_reference)
+{
+    const std::vector<VertexVertexCandidate>& vv_candidates =
+        m_candidates.vv_candidates;
+    const std::vector<EdgeVertexCandidate>& ev_candidates =
+        m_candidates.ev_candidates;
+    const std::vector<EdgeEdgeCandidate>& ee_candidates =
+        m_candidates.ee_candidates;
+    const std::vector<FaceVertexCandidate>& fv_candidates =
+        m_candidates.fv_candidates;
+    const size_t ev_offset = vv_candidates.size();
+    const size_t ee_offset = ev_offset + ev_candidates.size();
+    const size_t fv_offset = ee_offset + ee_candidates.size();
+
+    // The reference positions are those of the build, where every candidate
+    // is measured.
+    if (is_reference) {
+        m_reference_vertices = vertices;
+        m_candidate_distances.resize(m_candidates.size());
+        m_candidate_states.assign(m_candidates.size(), 0);
+    }
+
+    // How far each vertex moved since the distances were measured
+    const Eigen::VectorXd displacements =
+        (vertices - m_reference_vertices).rowwise().norm();
+
+    const double offset = m_dhat + m_dmin;
+    const double offset_sqr = sqr(offset);
+    std::atomic<bool> is_changed(false);
+
+    // Update the state of the i-th candidate. The distance between two
+    // primitives changes by at most the sum of the largest displacements of
+    // their vertices, so the candidate can be skipped if it stays inactive.
+    const auto update_state = [&](const size_t i, const double max_displacement,
+                                  const auto& measure) {
+        uint8_t state = 0;
+        if (is_reference
+            || std::sqrt(m_candidate_distances[i]) - max_displacement
+                <= offset) {
+            double distance_sqr;
+            state = measure(distance_sqr);
+            if (is_reference) {
+                m_candidate_distances[i] = distance_sqr;
+            }
+        }
+        if (state != m_candidate_states[i]) {
+            m_candidate_states[i] = state;
+            is_changed = true;
+        }
+    };
+
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(size_t(0), vv_candidates.size()),
+        [&](const tbb::blocked_range<size_t>& r) {
+            for (size_t i = r.begin(); i < r.end(); i++) {
+                const long vi = vv_candidates[i].vertex0_id;
+                const long vj = vv_candidates[i].vertex1_id;
+                update_state(
+                    i, displacements[vi] + displacements[vj],
+                    [&](double& distance_sqr) -> uint8_t {
+                        distance_sqr = point_point_distance(
+                            vertices.row(vi), vertices.row(vj));
+                        return distance_sqr < offset_sqr;
+                    });
+            }
+        });
+
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(size_t(0), ev_candidates.size()),
+        [&](const tbb::blocked_range<size_t>& r) {
+            for (size_t i = r.begin(); i < r.end(); i++) {
+                const long vi = ev_candidates[i].vertex_id;
+                const long e0i = mesh.edges()(ev_candidates[i].edge_id, 0),
+                           e1i = mesh.edges()(ev_candidates[i].edge_id, 1);
+                update_state(
+                    ev_offset + i,
+                    displacements[vi]
+                        + std::max(displacements[e0i], displacements[e1i]),
+                    [&](double& distance_sqr) -> uint8_t {
+                        const VectorMax3d v = vertices.row(vi);
+                        const VectorMax3d e0 = vertices.row(e0i);
+                        const VectorMax3d e1 = vertices.row(e1i);
+                        const PointEdgeDistanceType dtype =
+                            point_edge_distance_type(v, e0, e1);
+                        distance_sqr = point_edge_distance(v, e0, e1, dtype);
+                        return distance_sqr < offset_sqr ? (1 + int(dtype))
+                                                         : 0;
+                    });
+            }
+        });
+
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(size_t(0), ee_candidates.size()),
+        [&](const tbb::blocked_range<size_t>& r) {
+            for (size_t i = r.begin(); i < r.end(); i++) {
+                const long eai = ee_candidates[i].edge0_id;
+                const long ebi = ee_candidates[i].edge1_id;
+                const long ea0i = mesh.edges()(eai, 0),
+                           ea1i = mesh.edges()(eai, 1),
+                           eb0i = mesh.edges()(ebi, 0),
+                           eb1i = mesh.edges()(ebi, 1);
+                update_state(
+                    ee_offset + i,
+                    std::max(displacements[ea0i], displacements[ea1i])
+                        + std::max(displacements[eb0i], displacements[eb1i]),
+                    [&](double& distance_sqr) -> uint8_t {
+                        const Eigen::Vector3d ea0 = vertices.row(ea0i);
+                        const Eigen::Vector3d ea1 = vertices.row(ea1i);
+                        const Eigen::Vector3d eb0 = vertices.row(eb0i);
+                        const Eigen::Vector3d eb1 = vertices.row(eb1i);
+                        const EdgeEdgeDistanceType actual_dtype =
+                            edge_edge_distance_type(ea0, ea1, eb0, eb1);
+                        distance_sqr = edge_edge_distance(
+                            ea0, ea1, eb0, eb1, actual_dtype);
+                        if (distance_sqr >= offset_sqr) {
+                            return 0;
+                        }
+                        // Nearly parallel edges are mollified (see
+                        // NormalCollisionsBuilder::add_edge_edge_collisions).
+                        const double eps_x = edge_edge_mollifier_threshold(
+                            mesh.rest_positions().row(ea0i),
+                            mesh.rest_positions().row(ea1i),
+                            mesh.rest_positions().row(eb0i),
+                            mesh.rest_positions().row(eb1i));
+                        const EdgeEdgeDistanceType dtype =
+                            edge_edge_cross_squarednorm(ea0, ea1, eb0, eb1)
+                                < eps_x
+                            ? EdgeEdgeDistanceType::EA_EB
+                            : actual_dtype;
+                        return 1 + int(dtype);
+                    });
+            }
+        });
+
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(size_t(0), fv_candidates.size()),
+        [&](const tbb::blocked_range<size_t>& r) {
+            for (size_t i = r.begin(); i < r.end(); i++) {
+                const long fi = fv_candidates[i].face_id;
+                const long vi = fv_candidates[i].vertex_id;
+                const long f0i = mesh.faces()(fi, 0), f1i = mesh.faces()(fi, 1),
+                           f2i = mesh.faces()(fi, 2);
+                update_state(
+                    fv_offset + i,
+                    displacements[vi]
+                        + std::max(
+                            { displacements[f0i], displacements[f1i],
+                              displacements[f2i] }),
+                    [&](double& distance_sqr) -> uint8_t {
+                        const Eigen::Vector3d v = vertices.row(vi);
+                        const Eigen::Vector3d f0 = vertices.row(f0i);
+                        const Eigen::Vector3d f1 = vertices.row(f1i);
+                        const Eigen::Vector3d f2 = vertices.row(f2i);
+                        const PointTriangleDistanceType dtype =
+                            point_triangle_distance_type(v, f0, f1, f2);
+                        distance_sqr =
+                            point_triangle_distance(v, f0, f1, f2, dtype);
+                        return distance_sqr < offset_sqr ? (1 + int(dtype))
+                                                         : 0;
+                    });
+            }
+        });
+
+    return is_changed;
+}
+
+void NormalCollisions::build_collisions(
+    const Candidates& candidates,
+    const CollisionMesh& mesh,
+    Eigen::ConstRef<Eigen::MatrixXd> vertices,
+    const double dhat,
+    const double dmin)
+{
     // Cull the candidates by measuring the distance and dropping those that are
     // greater than dhat.
     auto is_active = [offset_sqr = sqr(dmin + dhat)](double distance_sqr) {
         return distance_sqr < offset_sqr;
     };
 
-    tbb::enumerable_thread_specific<NormalCollisionsBuilder> storage(
+    tbb::enumerable_thread_specific<NormalCollisionsBuilder> local_storage(
         use_area_weighting(), enable_shape_derivatives());
+    // The builders are constructed with the flags, so keep one storage per
+    // combination of flags.
+    auto& storage = m_workspace
+        ? m_workspace->thread_local_storage<NormalCollisionsBuilder>(
+              2 * int(use_area_weighting()) + int(enable_shape_derivatives()),
+              use_area_weighting(), enable_shape_derivatives())
+        : local_storage;
 
     tbb::parallel_for(
         tbb::blocked_range<size_t>(size_t(0), candidates.vv_candidates.size()),
@@ -270,11 +558,15 @@ void NormalCollisions::build(
 
     // -------------------------------------------------------------------------
 
+    weight_gradients.reset(enable_shape_derivatives() ? vertices.size() : 0);
     NormalCollisionsBuilder::merge(storage, *this);
 
     // logger().debug(to_string(mesh, vertices));
 
-    for (size_t ci = 0; ci < size(); ci++) {
+    // Plane-vertex and SDF-vertex collisions come last and are not built here.
+    const size_t num_built = vv_collisions.size() + ev_collisions.size()
+        + ee_collisions.size() + fv_collisions.size();
+    for (size_t ci = 0; ci < num_built; ci++) {
         NormalCollision& collision = (*this)[ci];
         collision.dmin = dmin;
     }
@@ -313,6 +605,16 @@ void NormalCollisions::set_use_improved_max_approximator(
     m_use_improved_max_approximator = use_improved_max_approximator;
 }
 
+void NormalCollisions::set_enable_updates(const bool enable_updates)
+{
+    if (!empty() && enable_updates != m_enable_updates) {
+        logger().warn("Setting enable_updates after building collisions. "
+                      "Re-build collisions for this to have an effect.");
+    }
+
+    m_enable_updates = enable_updates;
+}
+
 void NormalCollisions::set_enable_shape_derivatives(
     const bool enable_shape_derivatives)
 {
@@ -362,14 +664,14 @@ double NormalCollisions::compute_minimum_distance(
 size_t NormalCollisions::size() const
 {
     return vv_collisions.size() + ev_collisions.size() + ee_collisions.size()
-        + fv_collisions.size() + pv_collisions.size();
+        + fv_collisions.size() + pv_collisions.size() + sv_collisions.size();
 }
 
 bool NormalCollisions::empty() const
 {
     return vv_collisions.empty() && ev_collisions.empty()
         && ee_collisions.empty() && fv_collisions.empty()
-        && pv_collisions.empty();
+        && pv_collisions.empty() && sv_collisions.empty();
 }
 
 void NormalCollisions::clear()
@@ -379,6 +681,8 @@ void NormalCollisions::clear()
     ee_collisions.clear();
     fv_collisions.clear();
     pv_collisions.clear();
+    sv_collisions.clear();
+    weight_gradients.clear();
 }
 
 NormalCollision& NormalCollisions::operator[](size_t i)
@@ -402,6 +706,10 @@ NormalCollision& NormalCollisions::operator[](size_t i)
     if (i < pv_collisions.size()) {
         return pv_collisions[i];
     }
+    i -= pv_collisions.size();
+    if (i < sv_collisions.size()) {
+        return sv_collisions[i];
+    }
     throw std::out_of_range("Collision index is out of range!");
 }
 
@@ -426,6 +734,10 @@ const NormalCollision& NormalCollisions::operator[](size_t i) const
     if (i < pv_collisions.size()) {
         return pv_collisions[i];
     }
+    i -= pv_collisions.size();
+    if (i < sv_collisions.size()) {
+        return sv_collisions[i];
+    }
     throw std::out_of_range("Collision index is out of range!");
 }
 
@@ -464,6 +776,13 @@ bool NormalCollisions::is_plane_vertex(size_t i) const
             + pv_collisions.size();
 }
 
+bool NormalCollisions::is_sdf_vertex(size_t i) const
+{
+    return i >= vv_collisions.size() + ev_collisions.size()
+            + ee_collisions.size() + fv_collisions.size() + pv_collisions.size()
+        && i < size();
+}
+
 std::string NormalCollisions::to_string(
     const CollisionMesh& mesh, Eigen::ConstRef<Eigen::MatrixXd> vertices) const
 {
@@ -7,10 +7,14 @@
 #include <ipc/collisions/normal/face_vertex.hpp>
 #include <ipc/collisions/normal/normal_collision.hpp>
 #include <ipc/collisions/normal/plane_vertex.hpp>
+#include <ipc/collisions/normal/sdf_vertex.hpp>
 #include <ipc/collisions/normal/vertex_vertex.hpp>
+#include <ipc/collisions/weight_gradients.hpp>
+#include <ipc/utils/workspace.hpp>
 
 #include <Eigen/Core>
 
+#include <cstdint>
 #include <vector>
 
 namespace ipc {
@@ -50,6 +54,27 @@ public:
         const double dhat,
         const double dmin = 0);
 
+    /// @brief Update the set of collisions for new vertex positions without rebuilding it from scratch.
+    ///
+    /// The candidates, activation distance, and minimum distance of the last
+    /// build are reused. Candidates that provably remain inactive (i.e., their
+    /// last measured distance minus the displacement of their vertices is at
+    /// least dhat + dmin) are skipped, and only the remaining ones are
+    /// re-tested. If no candidate changed its activity or closest pair, the
+    /// existing collisions are kept along with their weights, weight
+    /// gradients, and mollifier thresholds. Otherwise, collisions are added
+    /// and removed by rebuilding them from the active candidates only.
+    ///
+    /// @note Updates must be enabled (see set_enable_updates()) before the last build.
+    /// @note With the improved max approximator, the collisions are always rebuilt from the active candidates.
+    /// @note Plane-vertex and SDF-vertex collisions are left unchanged.
+    /// @warning The candidates of the last build must still contain every pair closer than dhat + dmin (e.g., the broad phase was inflated or the step was limited).
+    /// @throws std::runtime_error If the last build was done without updates enabled.
+    /// @param mesh The collision mesh.
+    /// @param vertices Vertices of the collision mesh.
+    void update(
+        const CollisionMesh& mesh, Eigen::ConstRef<Eigen::MatrixXd> vertices);
+
     // ------------------------------------------------------------------------
 
     /// @brief Computes the minimum distance between any non-adjacent elements.
@@ -106,6 +131,11 @@ public:
     /// @return If the collision at i is an plane-vertex collision.
     bool is_plane_vertex(size_t i) const;
 
+    /// @brief Get if the collision at i is an SDF-vertex collision.
+    /// @param i The index of the collision.
+    /// @return If the collision at i is an SDF-vertex collision.
+    bool is_sdf_vertex(size_t i) const;
+
     /// @brief Get if the collision set should use area weighting.
     /// @note If not empty, this is the current value not necessarily the value used to build the collisions.
     /// @return If the collision set should use area weighting.
@@ -140,6 +170,32 @@ public:
     /// @param enable_shape_derivatives If the collision set should enable shape derivative computation.
     void set_enable_shape_derivatives(const bool enable_shape_derivatives);
 
+    /// @brief Get if the collision set can be updated without rebuilding it.
+    /// @return If the collision set keeps its candidates for update().
+    bool enable_updates() const { return m_enable_updates; }
+
+    /// @brief Set if the collision set can be updated without rebuilding it.
+    ///
+    /// If enabled, build() keeps a copy of the candidates and measures their
+    /// distances, so the following calls to update() only re-test the
+    /// candidates that may have changed. Otherwise, building does not pay for
+    /// either.
+    ///
+    /// @warning This must be set before the collisions are built.
+    /// @param enable_updates If the collision set can be updated without rebuilding it.
+    void set_enable_updates(const bool enable_updates);
+
+    /// @brief Get the workspace used to reuse buffers across builds.
+    /// @return The workspace (null if buffers are allocated per build).
+    const std::shared_ptr<Workspace>& workspace() const { return m_workspace; }
+
+    /// @brief Set the workspace used to reuse buffers across builds.
+    /// @param workspace The workspace (null to allocate buffers per build).
+    void set_workspace(std::shared_ptr<Workspace> workspace)
+    {
+        m_workspace = std::move(workspace);
+    }
+
     std::string to_string(
         const CollisionMesh& mesh,
         Eigen::ConstRef<Eigen::MatrixXd> vertices) const;
@@ -155,11 +211,56 @@ public:
     std::vector<FaceVertexNormalCollision> fv_collisions;
     /// @brief Plane-vertex normal collisions.
     std::vector<PlaneVertexNormalCollision> pv_collisions;
+    /// @brief SDF-vertex normal collisions.
+    std::vector<SDFVertexNormalCollision> sv_collisions;
+
+    /// @brief Gradients of the collision weights w.r.t. the rest positions.
+    /// Row i corresponds to the i-th collision (i.e., operator[](i)). It is only filled by build() if shape derivatives are enabled, and it has no rows for plane-vertex and SDF-vertex collisions.
+    WeightGradients weight_gradients;
 
 protected:
+    /// @brief Build the collisions of a set of candidates.
+    /// @param candidates Distance candidates from which the collision set is built.
+    /// @param mesh The collision mesh.
+    /// @param vertices Vertices of the collision mesh.
+    /// @param dhat The activation distance of the barrier.
+    /// @param dmin Minimum distance.
+    void build_collisions(
+        const Candidates& candidates,
+        const CollisionMesh& mesh,
+        Eigen::ConstRef<Eigen::MatrixXd> vertices,
+        const double dhat,
+        const double dmin);
+
+    /// @brief Measure the candidates of the last build and update their states.
+    /// @param mesh The collision mesh.
+    /// @param vertices Vertices of the collision mesh.
+    /// @param is_reference If true, measure every candidate and use the positions as the reference of the following updates.
+    /// @return If the state of any candidate changed.
+    bool update_candidate_states(
+        const CollisionMesh& mesh,
+        Eigen::ConstRef<Eigen::MatrixXd> vertices,
+        const bool is_reference);
+
     bool m_use_area_weighting = false;
     bool m_use_improved_max_approximator = false;
     bool m_enable_shape_derivatives = false;
+    bool m_enable_updates = false;
+    /// @brief Persistent buffers reused across builds (optional).
+    std::shared_ptr<Workspace> m_workspace;
+
+    /// @brief Candidates of the last build (only kept if updates are enabled).
+    Candidates m_candidates;
+    /// @brief Activation distance of the last build.
+    double m_dhat = 0;
+    /// @brief Minimum distance of the last build.
+    double m_dmin = 0;
+    /// @brief Vertex positions at which the candidate distances were measured.
+    Eigen::MatrixXd m_reference_vertices;
+    /// @brief Squared distance of each candidate at the reference positions.
+    std::vector<double> m_candidate_distances;
+    /// @brief Closest pair of each candidate offset by one (zero if inactive).
+    std::vector<uint8_t> m_candidate_states;
 };
 
 } // namespace ipc
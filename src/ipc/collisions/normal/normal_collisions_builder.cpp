@@ -7,8 +7,207 @@
 #include <ipc/distance/point_point.hpp>
 #include <ipc/distance/point_triangle.hpp>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_scan.h>
+#include <tbb/parallel_sort.h>
+
+#include <cstdint>
+#include <functional>
+#include <utility>
+
 namespace ipc {
 
+namespace {
+    /// @brief Find the indices of the elements satisfying a predicate in parallel.
+    /// @param n Number of elements.
+    /// @param predicate Function taking an index and returning true if the element should be kept.
+    /// @return Increasing indices of the elements satisfying the predicate.
+    template <typename Predicate>
+    std::vector<size_t> parallel_find_all(const size_t n, Predicate predicate)
+    {
+        std::vector<uint8_t> is_selected(n);
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(size_t(0), n),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t i = r.begin(); i < r.end(); i++) {
+                    is_selected[i] = predicate(i);
+                }
+            });
+
+        // Exclusive prefix sum of the selection flags
+        std::vector<size_t> offsets(n + 1);
+        offsets[0] = 0;
+        tbb::parallel_scan(
+            tbb::blocked_range<size_t>(size_t(0), n), size_t(0),
+            [&](const tbb::blocked_range<size_t>& r, size_t sum,
+                const bool is_final_scan) {
+                for (size_t i = r.begin(); i < r.end(); i++) {
+                    sum += is_selected[i];
+                    if (is_final_scan) {
+                        offsets[i + 1] = sum;
+                    }
+                }
+                return sum;
+            },
+            std::plus<size_t>());
+
+        std::vector<size_t> indices(offsets.back());
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(size_t(0), n),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t i = r.begin(); i < r.end(); i++) {
+                    if (is_selected[i]) {
+                        indices[offsets[i]] = i;
+                    }
+                }
+            });
+        return indices;
+    }
+
+    /// @brief A collision of a thread-local builder and its weight gradient (null if shape derivatives are disabled).
+    template <typename Collision>
+    using LocalCollision =
+        std::pair<const Collision*, const Eigen::SparseVector<double>*>;
+
+    /// @brief Gather pointers to the collisions of every thread-local builder.
+    /// @param local_collisions Collisions of each thread-local builder.
+    /// @param local_weight_gradients Weight gradients of each thread-local builder (empty if shape derivatives are disabled).
+    /// @return The collisions of all builders with their weight gradients.
+    template <typename Collision>
+    std::vector<LocalCollision<Collision>> gather_collisions(
+        const std::vector<const std::vector<Collision>*>& local_collisions,
+        const std::vector<const std::vector<Eigen::SparseVector<double>>*>&
+            local_weight_gradients)
+    {
+        assert(local_collisions.size() == local_weight_gradients.size());
+        std::vector<size_t> offsets(local_collisions.size() + 1, 0);
+        for (size_t i = 0; i < local_collisions.size(); i++) {
+            offsets[i + 1] = offsets[i] + local_collisions[i]->size();
+        }
+
+        std::vector<LocalCollision<Collision>> collisions(offsets.back());
+        tbb::parallel_for(size_t(0), local_collisions.size(), [&](size_t i) {
+            const bool has_weight_gradients =
+                !local_weight_gradients[i]->empty();
+            assert(
+                !has_weight_gradients
+                || local_weight_gradients[i]->size()
+                    == local_collisions[i]->size());
+            for (size_t j = 0; j < local_collisions[i]->size(); j++) {
+                collisions[offsets[i] + j] = {
+                    &(*local_collisions[i])[j],
+                    has_weight_gradients ? &(*local_weight_gradients[i])[j]
+                                         : nullptr
+                };
+            }
+        });
+        return collisions;
+    }
+
+    /// @brief Resize a vector of collisions so its elements can be assigned in parallel.
+    /// @note The collisions do not have default constructors, so the vector is filled with copies of a placeholder.
+    template <typename Collision>
+    void resize_collisions(
+        std::vector<Collision>& collisions,
+        const size_t n,
+        const std::vector<LocalCollision<Collision>>& prototypes)
+    {
+        collisions.clear();
+        if (n != 0) {
+            collisions.resize(n, *prototypes.front().first);
+        }
+    }
+
+    /// @brief Merge the thread-local collisions of one type.
+    ///
+    /// The collisions are sorted so duplicates are adjacent, the weights (and
+    /// weight gradients) of duplicates are summed, and collisions whose
+    /// weights cancel out are dropped. Every step is parallel, and the result
+    /// is sorted independently of how the collisions were split among threads.
+    ///
+    /// @param[in] local_collisions Collisions of each thread-local builder.
+    /// @param[in] local_weight_gradients Weight gradients of each thread-local builder (empty if shape derivatives are disabled).
+    /// @param[out] merged_collisions Unique collisions with non-zero weight.
+    /// @param[out] merged_weight_gradients Weight gradients of the merged collisions (empty if shape derivatives are disabled).
+    template <typename Collision>
+    void reduce_collisions(
+        const std::vector<const std::vector<Collision>*>& local_collisions,
+        const std::vector<const std::vector<Eigen::SparseVector<double>>*>&
+            local_weight_gradients,
+        std::vector<Collision>& merged_collisions,
+        std::vector<Eigen::SparseVector<double>>& merged_weight_gradients)
+    {
+        std::vector<LocalCollision<Collision>> collisions =
+            gather_collisions(local_collisions, local_weight_gradients);
+
+        // Break ties by weight so duplicates are summed in a fixed order.
+        tbb::parallel_sort(
+            collisions.begin(), collisions.end(),
+            [](const LocalCollision<Collision>& a,
+               const LocalCollision<Collision>& b) {
+                if (*a.first < *b.first) {
+                    return true;
+                } else if (*b.first < *a.first) {
+                    return false;
+                }
+                return a.first->weight < b.first->weight;
+            });
+
+        // Find the start of each run of duplicates
+        std::vector<size_t> run_starts =
+            parallel_find_all(collisions.size(), [&](size_t i) {
+                return i == 0
+                    || *collisions[i - 1].first != *collisions[i].first;
+            });
+        const size_t n_runs = run_starts.size();
+        run_starts.push_back(collisions.size());
+
+        std::vector<double> weights(n_runs);
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(size_t(0), n_runs),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t i = r.begin(); i < r.end(); i++) {
+                    weights[i] = 0;
+                    for (size_t j = run_starts[i]; j < run_starts[i + 1]; j++) {
+                        weights[i] += collisions[j].first->weight;
+                    }
+                }
+            });
+
+        const std::vector<size_t> kept_runs = parallel_find_all(
+            n_runs, [&](size_t i) { return weights[i] != 0; });
+
+        const bool has_weight_gradients =
+            !collisions.empty() && collisions.front().second != nullptr;
+
+        resize_collisions(merged_collisions, kept_runs.size(), collisions);
+        merged_weight_gradients.clear();
+        merged_weight_gradients.resize(
+            has_weight_gradients ? kept_runs.size() : 0);
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(size_t(0), kept_runs.size()),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t i = r.begin(); i < r.end(); i++) {
+                    const size_t run = kept_runs[i];
+                    merged_collisions[i] = *collisions[run_starts[run]].first;
+                    merged_collisions[i].weight = weights[run];
+                    if (!has_weight_gradients) {
+                        continue;
+                    }
+                    Eigen::SparseVector<double>& merged_weight_gradient =
+                        merged_weight_gradients[i];
+                    merged_weight_gradient =
+                        *collisions[run_starts[run]].second;
+                    for (size_t j = run_starts[run] + 1;
+                         j < run_starts[run + 1]; j++) {
+                        merged_weight_gradient += *collisions[j].second;
+                    }
+                }
+            });
+    }
+} // namespace
+
 NormalCollisionsBuilder::NormalCollisionsBuilder(
     const bool _use_area_weighting, const bool _enable_shape_derivatives)
     : use_area_weighting(_use_area_weighting)
@@ -16,6 +215,21 @@ NormalCollisionsBuilder::NormalCollisionsBuilder(
 {
 }
 
+void NormalCollisionsBuilder::clear()
+{
+    vv_to_id.clear();
+    ev_to_id.clear();
+    ee_to_id.clear();
+    vv_collisions.clear();
+    ev_collisions.clear();
+    ee_collisions.clear();
+    fv_collisions.clear();
+    vv_weight_gradients.clear();
+    ev_weight_gradients.clear();
+    ee_weight_gradients.clear();
+    fv_weight_gradients.clear();
+}
+
 // ============================================================================
 
 void NormalCollisionsBuilder::add_vertex_vertex_collisions(
@@ -51,9 +265,12 @@ void NormalCollisionsBuilder::add_vertex_vertex_collisions(
                 : Eigen::SparseVector<double>(vertices.size());
         }
 
-        VertexVertexNormalCollision vv(vi, vj, weight, weight_gradient);
+        VertexVertexNormalCollision vv(vi, vj, weight);
         vv_to_id.emplace(vv, vv_collisions.size());
         vv_collisions.push_back(vv);
+        if (enable_shape_derivatives) {
+            vv_weight_gradients.push_back(weight_gradient);
+        }
     }
 }
 
@@ -67,8 +284,10 @@ void NormalCollisionsBuilder::add_edge_vertex_collisions(
 {
     for (size_t i = start_i; i < end_i; i++) {
         const auto& [ei, vi] = candidates[i];
-        const auto [v, e0, e1, _] =
-            candidates[i].vertices(vertices, mesh.edges(), mesh.faces());
+        // Gather the vertices directly to avoid virtual calls.
+        const VectorMax3d v = vertices.row(vi);
+        const VectorMax3d e0 = vertices.row(mesh.edges()(ei, 0));
+        const VectorMax3d e1 = vertices.row(mesh.edges()(ei, 1));
         const PointEdgeDistanceType dtype = point_edge_distance_type(v, e0, e1);
         const double distance_sqr = point_edge_distance(v, e0, e1, dtype);
 
@@ -133,11 +352,13 @@ void NormalCollisionsBuilder::add_edge_edge_collisions(
     for (size_t i = start_i; i < end_i; i++) {
         const auto& [eai, ebi] = candidates[i];
 
-        const auto [ea0i, ea1i, eb0i, eb1i] =
-            candidates[i].vertex_ids(mesh.edges(), mesh.faces());
+        const long ea0i = mesh.edges()(eai, 0), ea1i = mesh.edges()(eai, 1),
+                   eb0i = mesh.edges()(ebi, 0), eb1i = mesh.edges()(ebi, 1);
 
-        const auto [ea0, ea1, eb0, eb1] =
-            candidates[i].vertices(vertices, mesh.edges(), mesh.faces());
+        const Eigen::Vector3d ea0 = vertices.row(ea0i);
+        const Eigen::Vector3d ea1 = vertices.row(ea1i);
+        const Eigen::Vector3d eb0 = vertices.row(eb0i);
+        const Eigen::Vector3d eb1 = vertices.row(eb1i);
 
         const EdgeEdgeDistanceType actual_dtype =
             edge_edge_distance_type(ea0, ea1, eb0, eb1);
@@ -210,9 +431,11 @@ void NormalCollisionsBuilder::add_edge_edge_collisions(
             break;
 
         case EdgeEdgeDistanceType::EA_EB:
-            ee_collisions.emplace_back(
-                eai, ebi, eps_x, weight, weight_gradient, actual_dtype);
+            ee_collisions.emplace_back(eai, ebi, eps_x, weight, actual_dtype);
             ee_to_id.emplace(ee_collisions.back(), ee_collisions.size() - 1);
+            if (enable_shape_derivatives) {
+                ee_weight_gradients.push_back(weight_gradient);
+            }
             break;
 
         case EdgeEdgeDistanceType::AUTO:
@@ -236,8 +459,10 @@ void NormalCollisionsBuilder::add_face_vertex_collisions(
         const long f0i = mesh.faces()(fi, 0), f1i = mesh.faces()(fi, 1),
                    f2i = mesh.faces()(fi, 2);
 
-        const auto [v, f0, f1, f2] =
-            candidates[i].vertices(vertices, mesh.edges(), mesh.faces());
+        const Eigen::Vector3d v = vertices.row(vi);
+        const Eigen::Vector3d f0 = vertices.row(f0i);
+        const Eigen::Vector3d f1 = vertices.row(f1i);
+        const Eigen::Vector3d f2 = vertices.row(f2i);
 
         // Compute distance type
         const PointTriangleDistanceType dtype =
@@ -288,7 +513,10 @@ void NormalCollisionsBuilder::add_face_vertex_collisions(
             break;
 
         case PointTriangleDistanceType::P_T:
-            fv_collisions.emplace_back(fi, vi, weight, weight_gradient);
+            fv_collisions.emplace_back(fi, vi, weight);
+            if (enable_shape_derivatives) {
+                fv_weight_gradients.push_back(weight_gradient);
+            }
             break;
 
         case PointTriangleDistanceType::AUTO:
@@ -518,57 +746,79 @@ void NormalCollisionsBuilder::add_edge_edge_negative_edge_vertex_collisions(
 // ============================================================================
 
 void NormalCollisionsBuilder::add_vertex_vertex_collision(
-    const VertexVertexNormalCollision& vv_collision,
-    unordered_map<VertexVertexNormalCollision, long>& vv_to_id,
-    std::vector<VertexVertexNormalCollision>& vv_collisions)
+    const long vertex0_id,
+    const long vertex1_id,
+    const double weight,
+    const Eigen::SparseVector<double>& weight_gradient)
 {
+    const VertexVertexNormalCollision vv_collision(
+        vertex0_id, vertex1_id, weight);
     auto found_item = vv_to_id.find(vv_collision);
     if (found_item != vv_to_id.end()) {
         // collision already exists, so increase weight
-        vv_collisions[found_item->second].weight += vv_collision.weight;
-        vv_collisions[found_item->second].weight_gradient +=
-            vv_collision.weight_gradient;
+        vv_collisions[found_item->second].weight += weight;
+        if (enable_shape_derivatives) {
+            vv_weight_gradients[found_item->second] += weight_gradient;
+        }
     } else {
         // New collision, so add it to the end of vv_collisions
         vv_to_id.emplace(vv_collision, vv_collisions.size());
         vv_collisions.push_back(vv_collision);
+        if (enable_shape_derivatives) {
+            vv_weight_gradients.push_back(weight_gradient);
+        }
     }
 }
 
 void NormalCollisionsBuilder::add_edge_vertex_collision(
-    const EdgeVertexNormalCollision& ev_collision,
-    unordered_map<EdgeVertexNormalCollision, long>& ev_to_id,
-    std::vector<EdgeVertexNormalCollision>& ev_collisions)
+    const long edge_id,
+    const long vertex_id,
+    const double weight,
+    const Eigen::SparseVector<double>& weight_gradient)
 {
+    const EdgeVertexNormalCollision ev_collision(edge_id, vertex_id, weight);
     auto found_item = ev_to_id.find(ev_collision);
     if (found_item != ev_to_id.end()) {
         // collision already exists, so increase weight
-        ev_collisions[found_item->second].weight += ev_collision.weight;
-        ev_collisions[found_item->second].weight_gradient +=
-            ev_collision.weight_gradient;
+        ev_collisions[found_item->second].weight += weight;
+        if (enable_shape_derivatives) {
+            ev_weight_gradients[found_item->second] += weight_gradient;
+        }
     } else {
         // New collision, so add it to the end of ev_collisions
         ev_to_id.emplace(ev_collision, ev_collisions.size());
         ev_collisions.push_back(ev_collision);
+        if (enable_shape_derivatives) {
+            ev_weight_gradients.push_back(weight_gradient);
+        }
     }
 }
 
 void NormalCollisionsBuilder::add_edge_edge_collision(
-    const EdgeEdgeNormalCollision& ee_collision,
-    unordered_map<EdgeEdgeNormalCollision, long>& ee_to_id,
-    std::vector<EdgeEdgeNormalCollision>& ee_collisions)
+    const long edge0_id,
+    const long edge1_id,
+    const double eps_x,
+    const double weight,
+    const Eigen::SparseVector<double>& weight_gradient,
+    const EdgeEdgeDistanceType dtype)
 {
+    const EdgeEdgeNormalCollision ee_collision(
+        edge0_id, edge1_id, eps_x, weight, dtype);
     auto found_item = ee_to_id.find(ee_collision);
     if (found_item != ee_to_id.end()) {
         // collision already exists, so increase weight
         assert(ee_collision == ee_collisions[found_item->second]);
-        ee_collisions[found_item->second].weight += ee_collision.weight;
-        ee_collisions[found_item->second].weight_gradient +=
-            ee_collision.weight_gradient;
+        ee_collisions[found_item->second].weight += weight;
+        if (enable_shape_derivatives) {
+            ee_weight_gradients[found_item->second] += weight_gradient;
+        }
     } else {
         // New collision, so add it to the end of ee_collisions
         ee_to_id.emplace(ee_collision, ee_collisions.size());
         ee_collisions.push_back(ee_collision);
+        if (enable_shape_derivatives) {
+            ee_weight_gradients.push_back(weight_gradient);
+        }
     }
 }
 
@@ -579,86 +829,58 @@ void NormalCollisionsBuilder::merge(
         local_storage,
     NormalCollisions& merged_collisions)
 {
-    unordered_map<VertexVertexNormalCollision, long> vv_to_id;
-    unordered_map<EdgeVertexNormalCollision, long> ev_to_id;
-    unordered_map<EdgeEdgeNormalCollision, long> ee_to_id;
-    auto& vv_collisions = merged_collisions.vv_collisions;
-    auto& ev_collisions = merged_collisions.ev_collisions;
-    auto& ee_collisions = merged_collisions.ee_collisions;
-    auto& fv_collisions = merged_collisions.fv_collisions;
-
-    // size up the hash items
-    size_t n_vv = 0, n_ev = 0, n_ee = 0, n_fv = 0;
-    for (const auto& storage : local_storage) {
-        // This is an conservative estimate
-        n_vv += storage.vv_collisions.size();
-        n_ev += storage.ev_collisions.size();
-        n_ee += storage.ee_collisions.size();
-        n_fv += storage.fv_collisions.size();
-    }
-    vv_collisions.reserve(n_vv);
-    ev_collisions.reserve(n_ev);
-    ee_collisions.reserve(n_ee);
-    fv_collisions.reserve(n_fv);
-
-    // merge
+    using WeightGradientsPtr = const std::vector<Eigen::SparseVector<double>>*;
+
+    std::vector<const std::vector<VertexVertexNormalCollision>*> vv_collisions;
+    std::vector<const std::vector<EdgeVertexNormalCollision>*> ev_collisions;
+    std::vector<const std::vector<EdgeEdgeNormalCollision>*> ee_collisions;
+    std::vector<const std::vector<FaceVertexNormalCollision>*> fv_collisions;
+    std::vector<WeightGradientsPtr> vv_weight_gradients, ev_weight_gradients,
+        ee_weight_gradients, fv_weight_gradients;
     for (const auto& builder : local_storage) {
-        if (vv_collisions.empty()) {
-            vv_to_id = builder.vv_to_id;
-            vv_collisions = builder.vv_collisions;
-        } else {
-            for (const auto& vv : builder.vv_collisions) {
-                add_vertex_vertex_collision(vv, vv_to_id, vv_collisions);
-            }
-        }
-
-        if (ev_collisions.empty()) {
-            ev_to_id = builder.ev_to_id;
-            ev_collisions = builder.ev_collisions;
-        } else {
-            for (const auto& ev : builder.ev_collisions) {
-                add_edge_vertex_collision(ev, ev_to_id, ev_collisions);
-            }
-        }
-
-        if (ee_collisions.empty()) {
-            ee_to_id = builder.ee_to_id;
-            ee_collisions = builder.ee_collisions;
-        } else {
-            for (const auto& ee : builder.ee_collisions) {
-                add_edge_edge_collision(ee, ee_to_id, ee_collisions);
-            }
-        }
-
-        fv_collisions.insert(
-            fv_collisions.end(), builder.fv_collisions.begin(),
-            builder.fv_collisions.end());
+        vv_collisions.push_back(&builder.vv_collisions);
+        ev_collisions.push_back(&builder.ev_collisions);
+        ee_collisions.push_back(&builder.ee_collisions);
+        fv_collisions.push_back(&builder.fv_collisions);
+        vv_weight_gradients.push_back(&builder.vv_weight_gradients);
+        ev_weight_gradients.push_back(&builder.ev_weight_gradients);
+        ee_weight_gradients.push_back(&builder.ee_weight_gradients);
+        fv_weight_gradients.push_back(&builder.fv_weight_gradients);
     }
 
     // If positive and negative vertex-vertex collisions cancel out, remove
     // them. This can happen when edge-vertex collisions reduce to
     // vertex-vertex collisions. This will avoid unnecessary computation.
-    vv_collisions.erase(
-        std::remove_if(
-            vv_collisions.begin(), vv_collisions.end(),
-            [&](const VertexVertexNormalCollision& vv) {
-                return vv.weight == 0;
-            }),
-        vv_collisions.end());
-    // Same for edge-vertex collisions.
-    ev_collisions.erase(
-        std::remove_if(
-            ev_collisions.begin(), ev_collisions.end(),
-            [&](const EdgeVertexNormalCollision& ev) {
-                return ev.weight == 0;
-            }),
-        ev_collisions.end());
-    // Same for edge-edge collisions.
-    ee_collisions.erase(
-        std::remove_if(
-            ee_collisions.begin(), ee_collisions.end(),
-            [&](const EdgeEdgeNormalCollision& ee) { return ee.weight == 0; }),
-        ee_collisions.end());
+    // The same holds for edge-vertex and edge-edge collisions.
+    std::vector<Eigen::SparseVector<double>> weight_gradients;
+    reduce_collisions(
+        vv_collisions, vv_weight_gradients, merged_collisions.vv_collisions,
+        weight_gradients);
+    merged_collisions.weight_gradients.append(weight_gradients);
+    reduce_collisions(
+        ev_collisions, ev_weight_gradients, merged_collisions.ev_collisions,
+        weight_gradients);
+    merged_collisions.weight_gradients.append(weight_gradients);
+    reduce_collisions(
+        ee_collisions, ee_weight_gradients, merged_collisions.ee_collisions,
+        weight_gradients);
+    merged_collisions.weight_gradients.append(weight_gradients);
+
+    // Face-vertex collisions are never duplicated, so just concatenate them.
+    const std::vector<LocalCollision<FaceVertexNormalCollision>> fv =
+        gather_collisions(fv_collisions, fv_weight_gradients);
+    resize_collisions(merged_collisions.fv_collisions, fv.size(), fv);
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(size_t(0), fv.size()),
+        [&](const tbb::blocked_range<size_t>& r) {
+            for (size_t i = r.begin(); i < r.end(); i++) {
+                merged_collisions.fv_collisions[i] = *fv[i].first;
+            }
+        });
+    for (const WeightGradientsPtr local_weight_gradients :
+         fv_weight_gradients) {
+        merged_collisions.weight_gradients.append(*local_weight_gradients);
+    }
 }
 
-} // namespace ipc
\ No newline at end of file
+} // namespace ipc
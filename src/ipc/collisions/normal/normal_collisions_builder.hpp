@@ -13,6 +13,9 @@ public:
     NormalCollisionsBuilder(
         const bool use_area_weighting, const bool enable_shape_derivatives);
 
+    /// @brief Remove all constructed collisions while retaining their capacity.
+    void clear();
+
     void add_vertex_vertex_collisions(
         const CollisionMesh& mesh,
         Eigen::ConstRef<Eigen::MatrixXd> vertices,
@@ -85,41 +88,21 @@ public:
 
     // -------------------------------------------------------------------------
 protected:
-    static void add_vertex_vertex_collision(
-        const VertexVertexNormalCollision& vv_collision,
-        unordered_map<VertexVertexNormalCollision, long>& vv_to_id,
-        std::vector<VertexVertexNormalCollision>& vv_collisions);
-
+    /// @brief Add a vertex-vertex collision or increase the weight of an existing one.
     void add_vertex_vertex_collision(
         const long vertex0_id,
         const long vertex1_id,
         const double weight,
-        const Eigen::SparseVector<double>& weight_gradient)
-    {
-        add_vertex_vertex_collision(
-            VertexVertexNormalCollision(
-                vertex0_id, vertex1_id, weight, weight_gradient),
-            vv_to_id, vv_collisions);
-    }
+        const Eigen::SparseVector<double>& weight_gradient);
 
     // -------------------------------------------------------------------------
 
-    static void add_edge_vertex_collision(
-        const EdgeVertexNormalCollision& ev_collision,
-        unordered_map<EdgeVertexNormalCollision, long>& ev_to_id,
-        std::vector<EdgeVertexNormalCollision>& ev_collisions);
-
+    /// @brief Add an edge-vertex collision or increase the weight of an existing one.
     void add_edge_vertex_collision(
         const long edge_id,
         const long vertex_id,
         const double weight,
-        const Eigen::SparseVector<double>& weight_gradient)
-    {
-        add_edge_vertex_collision(
-            EdgeVertexNormalCollision(
-                edge_id, vertex_id, weight, weight_gradient),
-            ev_to_id, ev_collisions);
-    }
+        const Eigen::SparseVector<double>& weight_gradient);
 
     void add_edge_vertex_collision(
         const CollisionMesh& mesh,
@@ -130,24 +113,14 @@ protected:
 
     // -------------------------------------------------------------------------
 
-    static void add_edge_edge_collision(
-        const EdgeEdgeNormalCollision& ee_collision,
-        unordered_map<EdgeEdgeNormalCollision, long>& ee_to_id,
-        std::vector<EdgeEdgeNormalCollision>& ee_collisions);
-
+    /// @brief Add an edge-edge collision or increase the weight of an existing one.
     void add_edge_edge_collision(
         const long edge0_id,
         const long edge1_id,
         const double eps_x,
         const double weight,
         const Eigen::SparseVector<double>& weight_gradient,
-        const EdgeEdgeDistanceType dtype)
-    {
-        add_edge_edge_collision(
-            EdgeEdgeNormalCollision(
-                edge0_id, edge1_id, eps_x, weight, weight_gradient, dtype),
-            ee_to_id, ee_collisions);
-    }
+        const EdgeEdgeDistanceType dtype);
 
     // -------------------------------------------------------------------------
 
@@ -163,6 +136,13 @@ protected:
     std::vector<FaceVertexNormalCollision> fv_collisions;
     // std::vector<PlaneVertexNormalCollision> pv_collisions;
 
+    // Gradients of the weights of the constructed collisions (only filled if
+    // shape derivatives are enabled).
+    std::vector<Eigen::SparseVector<double>> vv_weight_gradients;
+    std::vector<Eigen::SparseVector<double>> ev_weight_gradients;
+    std::vector<Eigen::SparseVector<double>> ee_weight_gradients;
+    std::vector<Eigen::SparseVector<double>> fv_weight_gradients;
+
     const bool use_area_weighting;
     const bool enable_shape_derivatives;
 };
@@ -0,0 +1,62 @@
+#include "sdf_vertex.hpp"
+
+#include <ipc/ccd/point_static_sdf.hpp>
+#include <ipc/implicits/sdf.hpp>
+
+namespace ipc {
+
+SDFVertexNormalCollision::SDFVertexNormalCollision(
+    std::shared_ptr<const GridSDF> _sdf, const long _vertex_id)
+    : sdf(std::move(_sdf))
+    , vertex_id(_vertex_id)
+{
+    assert(sdf != nullptr);
+}
+
+double SDFVertexNormalCollision::compute_distance(
+    Eigen::ConstRef<VectorMax12d> point) const
+{
+    assert(point.size() == sdf->dim());
+    const double d = sdf->value(point);
+    return d * d;
+}
+
+VectorMax12d SDFVertexNormalCollision::compute_distance_gradient(
+    Eigen::ConstRef<VectorMax12d> point) const
+{
+    assert(point.size() == sdf->dim());
+    // ∇(d²) = 2d∇d
+    return 2 * sdf->value(point) * sdf->gradient(point);
+}
+
+MatrixMax12d SDFVertexNormalCollision::compute_distance_hessian(
+    Eigen::ConstRef<VectorMax12d> point) const
+{
+    assert(point.size() == sdf->dim());
+    // ∇²(d²) = 2(∇d∇dᵀ + d∇²d)
+    const VectorMax3d grad = sdf->gradient(point);
+    return 2
+        * (grad * grad.transpose() + sdf->value(point) * sdf->hessian(point));
+}
+
+VectorMax4d SDFVertexNormalCollision::compute_coefficients(
+    Eigen::ConstRef<VectorMax12d> positions) const
+{
+    VectorMax4d coeffs(1);
+    coeffs << 1.0;
+    return coeffs;
+}
+
+bool SDFVertexNormalCollision::ccd(
+    Eigen::ConstRef<VectorMax12d> vertices_t0,
+    Eigen::ConstRef<VectorMax12d> vertices_t1,
+    double& toi,
+    const double min_distance,
+    const double tmax,
+    const NarrowPhaseCCD& narrow_phase_ccd) const
+{
+    return point_static_sdf_ccd(
+        vertices_t0, vertices_t1, *sdf, toi, min_distance, tmax);
+}
+
+} // namespace ipc
@@ -19,10 +19,9 @@ public:
     VertexVertexNormalCollision(
         const long _vertex0_id,
         const long _vertex1_id,
-        const double _weight,
-        const Eigen::SparseVector<double>& _weight_gradient)
+        const double _weight)
         : VertexVertexCandidate(_vertex0_id, _vertex1_id)
-        , NormalCollision(_weight, _weight_gradient)
+        , NormalCollision(_weight)
     {
     }
 
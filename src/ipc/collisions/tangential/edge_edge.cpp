@@ -12,7 +12,6 @@ EdgeEdgeTangentialCollision::EdgeEdgeTangentialCollision(
     : EdgeEdgeCandidate(collision.edge0_id, collision.edge1_id)
 {
     this->weight = collision.weight;
-    this->weight_gradient = collision.weight_gradient;
 }
 
 EdgeEdgeTangentialCollision::EdgeEdgeTangentialCollision(
@@ -12,7 +12,7 @@ EdgeVertexTangentialCollision::EdgeVertexTangentialCollision(
     : EdgeVertexCandidate(collision.edge_id, collision.vertex_id)
 {
     this->weight = collision.weight;
-    this->weight_gradient = collision.weight_gradient;
+    this->dtype = collision.known_dtype();
 }
 
 EdgeVertexTangentialCollision::EdgeVertexTangentialCollision(
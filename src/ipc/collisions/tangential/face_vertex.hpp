@@ -19,6 +19,14 @@ public:
         const NormalPotential& normal_potential,
         const double normal_stiffness);
 
+    PointTriangleDistanceType known_dtype() const override { return dtype; }
+
+    /// @brief Cached distance type.
+    ///
+    /// Copied from the normal collision so the distance is not reclassified in
+    /// every evaluation (AUTO if the collision was not built from one).
+    PointTriangleDistanceType dtype = PointTriangleDistanceType::AUTO;
+
 protected:
     MatrixMax<double, 3, 2> compute_tangent_basis(
         Eigen::ConstRef<VectorMax12d> positions) const override;
@@ -91,9 +91,6 @@ public:
     /// @brief Weight
     double weight = 1;
 
-    /// @brief Gradient of weight with respect to all DOF
-    Eigen::SparseVector<double> weight_gradient;
-
     /// @brief Barycentric coordinates of the closest point(s)
     VectorMax2d closest_point;
 
@@ -31,20 +31,35 @@ void TangentialCollisions::build(
     const auto& C_ev = collisions.ev_collisions;
     const auto& C_ee = collisions.ee_collisions;
     const auto& C_fv = collisions.fv_collisions;
-    auto& [FC_vv, FC_ev, FC_ee, FC_fv] = *this;
+    auto& FC_vv = vv_collisions;
+    auto& FC_ev = ev_collisions;
+    auto& FC_ee = ee_collisions;
+    auto& FC_fv = fv_collisions;
+
+    // Copy the weight gradients of the normal collisions (if computed).
+    const bool has_weight_gradients = collisions.weight_gradients.size()
+        >= C_vv.size() + C_ev.size() + C_ee.size() + C_fv.size();
+    weight_gradients.reset(
+        has_weight_gradients ? collisions.weight_gradients.ndof() : 0);
+    size_t normal_collision_id = 0;
 
     FC_vv.reserve(C_vv.size());
     for (const auto& c_vv : C_vv) {
+        const size_t ci = normal_collision_id++;
         FC_vv.emplace_back(
             c_vv, c_vv.dof(vertices, edges, faces), normal_potential,
             normal_stiffness);
         const auto& [v0i, v1i, _, __] = FC_vv.back().vertex_ids(edges, faces);
 
         FC_vv.back().mu = blend_mu(mus(v0i), mus(v1i));
+        if (has_weight_gradients) {
+            weight_gradients.push_back(collisions.weight_gradients, ci);
+        }
     }
 
     FC_ev.reserve(C_ev.size());
     for (const auto& c_ev : C_ev) {
+        const size_t ci = normal_collision_id++;
         FC_ev.emplace_back(
             c_ev, c_ev.dof(vertices, edges, faces), normal_potential,
             normal_stiffness);
@@ -53,10 +68,14 @@ void TangentialCollisions::build(
         const double edge_mu =
             (mus(e1i) - mus(e0i)) * FC_ev.back().closest_point[0] + mus(e0i);
         FC_ev.back().mu = blend_mu(edge_mu, mus(vi));
+        if (has_weight_gradients) {
+            weight_gradients.push_back(collisions.weight_gradients, ci);
+        }
     }
 
     FC_ee.reserve(C_ee.size());
     for (const auto& c_ee : C_ee) {
+        const size_t ci = normal_collision_id++;
         const auto& [ea0i, ea1i, eb0i, eb1i] = c_ee.vertex_ids(edges, faces);
         const Eigen::Vector3d ea0 = vertices.row(ea0i);
         const Eigen::Vector3d ea1 = vertices.row(ea1i);
@@ -77,10 +96,14 @@ void TangentialCollisions::build(
         double eb_mu =
             (mus(eb1i) - mus(eb0i)) * FC_ee.back().closest_point[1] + mus(eb0i);
         FC_ee.back().mu = blend_mu(ea_mu, eb_mu);
+        if (has_weight_gradients) {
+            weight_gradients.push_back(collisions.weight_gradients, ci);
+        }
     }
 
     FC_fv.reserve(C_fv.size());
     for (const auto& c_fv : C_fv) {
+        const size_t ci = normal_collision_id++;
         FC_fv.emplace_back(
             c_fv, c_fv.dof(vertices, edges, faces), normal_potential,
             normal_stiffness);
@@ -90,6 +113,9 @@ void TangentialCollisions::build(
             + FC_fv.back().closest_point[0] * (mus(f1i) - mus(f0i))
             + FC_fv.back().closest_point[1] * (mus(f2i) - mus(f0i));
         FC_fv.back().mu = blend_mu(face_mu, mus(vi));
+        if (has_weight_gradients) {
+            weight_gradients.push_back(collisions.weight_gradients, ci);
+        }
     }
 }
 
@@ -113,6 +139,7 @@ void TangentialCollisions::clear()
     ev_collisions.clear();
     ee_collisions.clear();
     fv_collisions.clear();
+    weight_gradients.clear();
 }
 
 TangentialCollision& TangentialCollisions::operator[](size_t i)
@@ -7,6 +7,7 @@
 #include <ipc/collisions/tangential/face_vertex.hpp>
 #include <ipc/collisions/tangential/tangential_collision.hpp>
 #include <ipc/collisions/tangential/vertex_vertex.hpp>
+#include <ipc/collisions/weight_gradients.hpp>
 #include <ipc/utils/eigen_ext.hpp>
 
 #include <Eigen/Core>
@@ -83,6 +84,10 @@ public:
     std::vector<EdgeEdgeTangentialCollision> ee_collisions;
     /// @brief Face-vertex tangential collisions.
     std::vector<FaceVertexTangentialCollision> fv_collisions;
+
+    /// @brief Gradients of the collision weights w.r.t. the rest positions.
+    /// Row i corresponds to the i-th collision (i.e., operator[](i)). It is copied from the normal collisions by build() if they have weight gradients.
+    WeightGradients weight_gradients;
 };
 
 } // namespace ipc
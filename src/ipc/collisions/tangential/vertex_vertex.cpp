@@ -12,7 +12,6 @@ VertexVertexTangentialCollision::VertexVertexTangentialCollision(
     : VertexVertexCandidate(collision.vertex0_id, collision.vertex1_id)
 {
     this->weight = collision.weight;
-    this->weight_gradient = collision.weight_gradient;
 }
 
 VertexVertexTangentialCollision::VertexVertexTangentialCollision(
@@ -0,0 +1,97 @@
+#include "weight_gradients.hpp"
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+
+namespace ipc {
+
+void WeightGradients::reset(const size_t ndof)
+{
+    clear();
+    m_ndof = ndof;
+}
+
+void WeightGradients::clear()
+{
+    m_offsets.resize(1);
+    m_indices.clear();
+    m_values.clear();
+}
+
+void WeightGradients::push_back(
+    const Eigen::SparseVector<double>& weight_gradient)
+{
+    assert(size_t(weight_gradient.size()) == m_ndof);
+    const size_t nnz = weight_gradient.nonZeros();
+    m_indices.insert(
+        m_indices.end(), weight_gradient.innerIndexPtr(),
+        weight_gradient.innerIndexPtr() + nnz);
+    m_values.insert(
+        m_values.end(), weight_gradient.valuePtr(),
+        weight_gradient.valuePtr() + nnz);
+    m_offsets.push_back(m_values.size());
+}
+
+void WeightGradients::push_back(const WeightGradients& other, const size_t i)
+{
+    assert(other.ndof() == m_ndof && i < other.size());
+    m_indices.insert(
+        m_indices.end(), other.m_indices.begin() + other.m_offsets[i],
+        other.m_indices.begin() + other.m_offsets[i + 1]);
+    m_values.insert(
+        m_values.end(), other.m_values.begin() + other.m_offsets[i],
+        other.m_values.begin() + other.m_offsets[i + 1]);
+    m_offsets.push_back(m_values.size());
+}
+
+void WeightGradients::append(
+    const std::vector<Eigen::SparseVector<double>>& weight_gradients)
+{
+    const size_t n = size(); // Number of existing rows
+    m_offsets.resize(n + weight_gradients.size() + 1);
+    for (size_t i = 0; i < weight_gradients.size(); i++) {
+        assert(size_t(weight_gradients[i].size()) == m_ndof);
+        m_offsets[n + i + 1] =
+            m_offsets[n + i] + weight_gradients[i].nonZeros();
+    }
+    m_indices.resize(m_offsets.back());
+    m_values.resize(m_offsets.back());
+
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(size_t(0), weight_gradients.size()),
+        [&](const tbb::blocked_range<size_t>& r) {
+            for (size_t i = r.begin(); i < r.end(); i++) {
+                const Eigen::SparseVector<double>& g = weight_gradients[i];
+                std::copy(
+                    g.innerIndexPtr(), g.innerIndexPtr() + g.nonZeros(),
+                    m_indices.begin() + m_offsets[n + i]);
+                std::copy(
+                    g.valuePtr(), g.valuePtr() + g.nonZeros(),
+                    m_values.begin() + m_offsets[n + i]);
+            }
+        });
+}
+
+void WeightGradients::append_zeros(const size_t n)
+{
+    m_offsets.resize(m_offsets.size() + n, m_offsets.back());
+}
+
+Eigen::SparseVector<double> WeightGradients::operator[](const size_t i) const
+{
+    assert(i < size());
+    const size_t nnz = m_offsets[i + 1] - m_offsets[i];
+    Eigen::SparseVector<double> weight_gradient(m_ndof);
+    weight_gradient.resizeNonZeros(nnz);
+    std::copy(
+        m_indices.begin() + m_offsets[i], m_indices.begin() + m_offsets[i + 1],
+        weight_gradient.innerIndexPtr());
+    std::copy(
+        m_values.begin() + m_offsets[i], m_values.begin() + m_offsets[i + 1],
+        weight_gradient.valuePtr());
+    return weight_gradient;
+}
+
+} // namespace ipc
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <Eigen/Core>
+#include <Eigen/SparseCore>
+
+#include <vector>
+
+namespace ipc {
+
+/// @brief Gradients of collision weights w.r.t. the rest positions stored in compressed sparse row (CSR) form.
+///
+/// Row i is the gradient of the weight of the i-th collision of the owning
+/// collection. Storing all rows in three flat arrays avoids a heap
+/// allocation per collision, and rows are only materialized as sparse vectors
+/// on demand.
+class WeightGradients {
+public:
+    WeightGradients() = default;
+
+    /// @brief Remove all rows and set the length of the gradients.
+    /// @param ndof Length of the gradients (i.e., the number of rest position degrees of freedom).
+    void reset(const size_t ndof);
+
+    /// @brief Remove all rows (the length of the gradients is kept).
+    void clear();
+
+    /// @brief Get the number of rows.
+    size_t size() const { return m_offsets.size() - 1; }
+
+    /// @brief Get if there are no rows.
+    bool empty() const { return size() == 0; }
+
+    /// @brief Get the length of the gradients.
+    size_t ndof() const { return m_ndof; }
+
+    /// @brief Get the total number of stored non-zeros.
+    size_t nonZeros() const { return m_values.size(); }
+
+    /// @brief Append a row.
+    /// @param weight_gradient Gradient of the weight (of length ndof()).
+    void push_back(const Eigen::SparseVector<double>& weight_gradient);
+
+    /// @brief Append a row of another table.
+    /// @param other The table to copy the row from.
+    /// @param i Index of the row in the other table.
+    void push_back(const WeightGradients& other, const size_t i);
+
+    /// @brief Append rows in parallel.
+    /// @param weight_gradients Gradients of the weights (each of length ndof()).
+    void
+    append(const std::vector<Eigen::SparseVector<double>>& weight_gradients);
+
+    /// @brief Append rows of zeros.
+    /// @param n Number of rows to append.
+    void append_zeros(const size_t n);
+
+    /// @brief Materialize a row as a sparse vector.
+    /// @param i Index of the row.
+    /// @return The gradient of the i-th weight.
+    Eigen::SparseVector<double> operator[](const size_t i) const;
+
+    /// @brief Get the indices of the non-zeros of a row (sorted).
+    /// @param i Index of the row.
+    /// @return A view of the row's indices.
+    Eigen::Map<const Eigen::VectorXi> indices(const size_t i) const
+    {
+        assert(i < size());
+        return Eigen::Map<const Eigen::VectorXi>(
+            m_indices.data() + m_offsets[i], m_offsets[i + 1] - m_offsets[i]);
+    }
+
+    /// @brief Get the values of the non-zeros of a row.
+    /// @param i Index of the row.
+    /// @return A view of the row's values.
+    Eigen::Map<const Eigen::VectorXd> values(const size_t i) const
+    {
+        assert(i < size());
+        return Eigen::Map<const Eigen::VectorXd>(
+            m_values.data() + m_offsets[i], m_offsets[i + 1] - m_offsets[i]);
+    }
+
+protected:
+    /// @brief Start of each row in the non-zero arrays (followed by the total number of non-zeros).
+    std::vector<size_t> m_offsets = { 0 };
+    /// @brief Indices of the non-zeros.
+    std::vector<int> m_indices;
+    /// @brief Values of the non-zeros.
+    std::vector<double> m_values;
+    /// @brief Length of the gradients.
+    size_t m_ndof = 0;
+};
+
+} // namespace ipc
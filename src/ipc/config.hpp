@@ -0,0 +1,16 @@
+#pragma once
+
+// WARNING: Do not modify config.hpp directly. Instead, modify config.hpp.in.
+
+#define IPC_TOOLKIT_NAME "IPCToolkit"
+#define IPC_TOOLKIT_VER "1.4.0"
+#define IPC_TOOLKIT_VER_MAJOR "1"
+#define IPC_TOOLKIT_VER_MINOR "4"
+#define IPC_TOOLKIT_VER_PATCH "0"
+
+/* #undef IPC_TOOLKIT_WITH_INEXACT_CCD */
+/* #undef IPC_TOOLKIT_WITH_RATIONAL_INTERSECTION */
+/* #undef IPC_TOOLKIT_WITH_CUDA */
+#define IPC_TOOLKIT_WITH_ROBIN_MAP
+#define IPC_TOOLKIT_WITH_ABSEIL
+#define IPC_TOOLKIT_WITH_FILIB
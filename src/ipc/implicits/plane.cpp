@@ -4,10 +4,152 @@
 #include <ipc/distance/point_plane.hpp>
 
 #include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
 #include <tbb/parallel_reduce.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
 namespace ipc {
 
+namespace {
+    /// @brief Number of points processed together by the batched kernels.
+    constexpr Eigen::Index POINT_BLOCK_SIZE = 256;
+
+    /// @brief Relative slack of the culling tests, absorbing the rounding
+    /// differences between the batched signed distances and the exact tests.
+    constexpr double CULLING_SLACK = 1e-8;
+
+    /// @brief Planes in Hessian normal form (i.e., n·x = c with |n| = 1)
+    /// stored one plane per row.
+    struct NormalizedPlanes {
+        NormalizedPlanes(
+            Eigen::ConstRef<Eigen::MatrixXd> plane_origins,
+            Eigen::ConstRef<Eigen::MatrixXd> plane_normals)
+            : normals(plane_normals.rowwise().normalized())
+            , abs_normals(normals.cwiseAbs())
+            , offsets(normals.cwiseProduct(plane_origins).rowwise().sum())
+        {
+            assert(plane_origins.rows() == plane_normals.rows());
+        }
+
+        /// @brief Bound the signed distances of all points in an AABB to every plane.
+        /// @param[in] min Minimum corner of the AABB.
+        /// @param[in] max Maximum corner of the AABB.
+        /// @param[out] min_distance Lower bound of the signed distance to each plane.
+        /// @param[out] max_distance Upper bound of the signed distance to each plane.
+        void signed_distance_bounds(
+            const Eigen::RowVectorXd& min,
+            const Eigen::RowVectorXd& max,
+            Eigen::VectorXd& min_distance,
+            Eigen::VectorXd& max_distance) const
+        {
+            const Eigen::VectorXd center =
+                normals * (0.5 * (min + max)).transpose() - offsets;
+            const Eigen::VectorXd radius =
+                abs_normals * (0.5 * (max - min)).transpose();
+            min_distance = center - radius;
+            max_distance = center + radius;
+        }
+
+        size_t size() const { return normals.rows(); }
+
+        Eigen::MatrixXd normals;
+        Eigen::MatrixXd abs_normals;
+        Eigen::VectorXd offsets;
+    };
+
+    /// @brief Call a function on every block of points in parallel.
+    template <typename Function>
+    void parallel_for_each_point_block(
+        const Eigen::Index num_points, const Function& f)
+    {
+        const Eigen::Index num_blocks =
+            (num_points + POINT_BLOCK_SIZE - 1) / POINT_BLOCK_SIZE;
+        tbb::parallel_for(
+            tbb::blocked_range<Eigen::Index>(0, num_blocks),
+            [&](const tbb::blocked_range<Eigen::Index>& r) {
+                for (Eigen::Index b = r.begin(); b < r.end(); b++) {
+                    const Eigen::Index begin = b * POINT_BLOCK_SIZE;
+                    f(b, begin,
+                      std::min(POINT_BLOCK_SIZE, num_points - begin));
+                }
+            });
+    }
+
+    /// @brief Find the point-plane pairs of a block of points that may collide
+    /// along a linear trajectory (as determined by point_static_plane_ccd).
+    ///
+    /// A point moving from signed distance s0 to s1 can only impact if it gets
+    /// within (1 - conservative_rescaling)·|s0| of the plane. Planes are first
+    /// culled for the whole block using the signed-distance bounds of the
+    /// block's AABBs at the start and end of the step, then the signed
+    /// distances of the remaining pairs are computed in batches.
+    ///
+    /// @param visit Function called with (vertex id, plane id) for each pair
+    /// that may collide. Returning false stops the search.
+    template <typename Visitor>
+    void for_each_point_plane_ccd_candidate(
+        Eigen::ConstRef<Eigen::MatrixXd> points_t0,
+        Eigen::ConstRef<Eigen::MatrixXd> points_t1,
+        const NormalizedPlanes& planes,
+        const Eigen::Index begin,
+        const Eigen::Index size,
+        const std::function<bool(size_t, size_t)>& can_collide,
+        const Visitor& visit)
+    {
+        // Fraction of the initial distance at which an impact is reported
+        const double ratio =
+            1 - TightInclusionCCD::DEFAULT_CONSERVATIVE_RESCALING;
+
+        const auto X0 = points_t0.middleRows(begin, size);
+        const auto X1 = points_t1.middleRows(begin, size);
+
+        Eigen::VectorXd min0, max0, min1, max1;
+        planes.signed_distance_bounds(
+            X0.colwise().minCoeff(), X0.colwise().maxCoeff(), min0, max0);
+        planes.signed_distance_bounds(
+            X1.colwise().minCoeff(), X1.colwise().maxCoeff(), min1, max1);
+
+        for (size_t pi = 0; pi < planes.size(); pi++) {
+            // Every point stays on the same side and away from the plane
+            const double slack_pos =
+                CULLING_SLACK * (std::abs(max0[pi]) + std::abs(min1[pi]));
+            const double slack_neg =
+                CULLING_SLACK * (std::abs(min0[pi]) + std::abs(max1[pi]));
+            if ((min0[pi] > 0 && min1[pi] > ratio * max0[pi] + slack_pos)
+                || (max0[pi] < 0 && max1[pi] < ratio * min0[pi] - slack_neg)) {
+                continue;
+            }
+
+            const Eigen::VectorXd s0 =
+                X0 * planes.normals.row(pi).transpose()
+                - Eigen::VectorXd::Constant(size, planes.offsets[pi]);
+            const Eigen::VectorXd s1 =
+                X1 * planes.normals.row(pi).transpose()
+                - Eigen::VectorXd::Constant(size, planes.offsets[pi]);
+
+            for (Eigen::Index k = 0; k < size; k++) {
+                const double slack =
+                    CULLING_SLACK * (std::abs(s0[k]) + std::abs(s1[k]));
+                if ((s0[k] > 0 && s1[k] > ratio * s0[k] + slack)
+                    || (s0[k] < 0 && s1[k] < ratio * s0[k] - slack)) {
+                    continue;
+                }
+
+                if (!can_collide(begin + k, pi)) {
+                    continue;
+                }
+
+                if (!visit(begin + k, pi)) {
+                    return;
+                }
+            }
+        }
+    }
+} // namespace
+
 void construct_point_plane_collisions(
     Eigen::ConstRef<Eigen::MatrixXd> points,
     Eigen::ConstRef<Eigen::MatrixXd> plane_origins,
@@ -22,29 +164,81 @@ void construct_point_plane_collisions(
     double dhat_squared = dhat * dhat;
     double dmin_squared = dmin * dmin;
 
-    // Cull the candidates by measuring the distance and dropping those that are
-    // greater than dhat.
-
     size_t n_planes = plane_origins.rows();
     assert(plane_normals.rows() == n_planes);
+    if (n_planes == 0 || points.rows() == 0) {
+        return;
+    }
 
-    for (size_t vi = 0; vi < points.rows(); vi++) {
-        for (size_t pi = 0; pi < n_planes; pi++) {
-            if (!can_collide(vi, pi)) {
-                continue;
+    const NormalizedPlanes planes(plane_origins, plane_normals);
+    const double activation_distance = (dmin + dhat) * (1 + CULLING_SLACK);
+
+    const Eigen::Index num_blocks =
+        (points.rows() + POINT_BLOCK_SIZE - 1) / POINT_BLOCK_SIZE;
+    std::vector<std::vector<PlaneVertexNormalCollision>> block_collisions(
+        num_blocks);
+
+    parallel_for_each_point_block(
+        points.rows(),
+        [&](const Eigen::Index b, const Eigen::Index begin,
+            const Eigen::Index size) {
+            const auto X = points.middleRows(begin, size);
+
+            // Cull the planes farther than dhat from the block's AABB.
+            Eigen::VectorXd lower, upper;
+            planes.signed_distance_bounds(
+                X.colwise().minCoeff(), X.colwise().maxCoeff(), lower, upper);
+            std::vector<Eigen::Index> active_planes;
+            for (size_t pi = 0; pi < n_planes; pi++) {
+                if (lower[pi] < activation_distance
+                    && upper[pi] > -activation_distance) {
+                    active_planes.push_back(pi);
+                }
+            }
+            if (active_planes.empty()) {
+                return;
             }
 
-            const auto& plane_origin = plane_origins.row(pi);
-            const auto& plane_normal = plane_normals.row(pi);
+            // Signed distances of the block to the remaining planes
+            Eigen::MatrixXd signed_distances =
+                X * planes.normals(active_planes, Eigen::all).transpose();
+            signed_distances.rowwise() -=
+                planes.offsets(active_planes).transpose();
 
-            double distance_sqr = point_plane_distance(
-                points.row(vi), plane_origin, plane_normal);
+            // Cull the candidates by measuring the distance and dropping those
+            // that are greater than dhat (in the same order as a vertex-major
+            // loop over all pairs).
+            for (Eigen::Index k = 0; k < size; k++) {
+                for (size_t j = 0; j < active_planes.size(); j++) {
+                    if (std::abs(signed_distances(k, j))
+                        >= activation_distance) {
+                        continue;
+                    }
+
+                    const size_t vi = begin + k, pi = active_planes[j];
+                    if (!can_collide(vi, pi)) {
+                        continue;
+                    }
+
+                    const auto& plane_origin = plane_origins.row(pi);
+                    const auto& plane_normal = plane_normals.row(pi);
+
+                    double distance_sqr = point_plane_distance(
+                        points.row(vi), plane_origin, plane_normal);
 
-            if (distance_sqr - dmin_squared < 2 * dmin * dhat + dhat_squared) {
-                pv_collisions.emplace_back(plane_origin, plane_normal, vi);
-                pv_collisions.back().dmin = dmin;
+                    if (distance_sqr - dmin_squared
+                        < 2 * dmin * dhat + dhat_squared) {
+                        block_collisions[b].emplace_back(
+                            plane_origin, plane_normal, vi);
+                        block_collisions[b].back().dmin = dmin;
+                    }
+                }
             }
-        }
+        });
+
+    for (const auto& collisions : block_collisions) {
+        pv_collisions.insert(
+            pv_collisions.end(), collisions.begin(), collisions.end());
     }
 }
 
@@ -60,28 +254,38 @@ bool is_step_point_plane_collision_free(
     size_t n_planes = plane_origins.rows();
     assert(plane_normals.rows() == n_planes);
     assert(points_t0.rows() == points_t1.rows());
+    if (n_planes == 0) {
+        return true;
+    }
 
-    for (size_t vi = 0; vi < points_t0.rows(); vi++) {
-        for (size_t pi = 0; pi < n_planes; pi++) {
-            if (!can_collide(vi, pi)) {
-                continue;
-            }
-
-            const auto& plane_origin = plane_origins.row(pi);
-            const auto& plane_normal = plane_normals.row(pi);
+    const NormalizedPlanes planes(plane_origins, plane_normals);
 
-            double toi;
-            bool is_collision = point_static_plane_ccd(
-                points_t0.row(vi), points_t1.row(vi), plane_origin,
-                plane_normal, toi);
+    std::atomic<bool> is_collision_free = true;
 
-            if (is_collision) {
-                return false;
+    parallel_for_each_point_block(
+        points_t0.rows(),
+        [&](const Eigen::Index, const Eigen::Index begin,
+            const Eigen::Index size) {
+            if (!is_collision_free) {
+                return; // Another block already found a collision
             }
-        }
-    }
 
-    return true;
+            for_each_point_plane_ccd_candidate(
+                points_t0, points_t1, planes, begin, size, can_collide,
+                [&](const size_t vi, const size_t pi) {
+                    double toi;
+                    bool is_collision = point_static_plane_ccd(
+                        points_t0.row(vi), points_t1.row(vi),
+                        plane_origins.row(pi), plane_normals.row(pi), toi);
+
+                    if (is_collision) {
+                        is_collision_free = false;
+                    }
+                    return !is_collision;
+                });
+        });
+
+    return is_collision_free;
 }
 
 // ============================================================================
@@ -96,31 +300,37 @@ double compute_point_plane_collision_free_stepsize(
     size_t n_planes = plane_origins.rows();
     assert(plane_normals.rows() == n_planes);
     assert(points_t0.rows() == points_t1.rows());
+    if (n_planes == 0 || points_t0.rows() == 0) {
+        return 1;
+    }
 
-    const double earliest_toi = tbb::parallel_reduce(
-        tbb::blocked_range<size_t>(0, points_t0.rows()),
-        /*inital_step_size=*/1.0,
-        [&](tbb::blocked_range<size_t> r, double current_toi) {
-            for (size_t vi = r.begin(); vi < r.end(); vi++) {
-                for (size_t pi = 0; pi < n_planes; pi++) {
-                    if (!can_collide(vi, pi)) {
-                        continue;
-                    }
+    const NormalizedPlanes planes(plane_origins, plane_normals);
 
-                    const auto& plane_origin = plane_origins.row(pi);
-                    const auto& plane_normal = plane_normals.row(pi);
+    const Eigen::Index num_blocks =
+        (points_t0.rows() + POINT_BLOCK_SIZE - 1) / POINT_BLOCK_SIZE;
 
-                    double toi;
-                    bool are_colliding = point_static_plane_ccd(
-                        points_t0.row(vi), points_t1.row(vi), plane_origin,
-                        plane_normal, toi);
+    const double earliest_toi = tbb::parallel_reduce(
+        tbb::blocked_range<Eigen::Index>(0, num_blocks),
+        /*inital_step_size=*/1.0,
+        [&](tbb::blocked_range<Eigen::Index> r, double current_toi) {
+            for (Eigen::Index b = r.begin(); b < r.end(); b++) {
+                const Eigen::Index begin = b * POINT_BLOCK_SIZE;
+                for_each_point_plane_ccd_candidate(
+                    points_t0, points_t1, planes, begin,
+                    std::min(POINT_BLOCK_SIZE, points_t0.rows() - begin),
+                    can_collide, [&](const size_t vi, const size_t pi) {
+                        double toi;
+                        bool are_colliding = point_static_plane_ccd(
+                            points_t0.row(vi), points_t1.row(vi),
+                            plane_origins.row(pi), plane_normals.row(pi), toi);
 
-                    if (are_colliding) {
-                        if (toi < current_toi) {
-                            current_toi = toi;
+                        if (are_colliding) {
+                            if (toi < current_toi) {
+                                current_toi = toi;
+                            }
                         }
-                    }
-                }
+                        return true;
+                    });
             }
             return current_toi;
         },
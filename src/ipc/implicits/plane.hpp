@@ -14,6 +14,7 @@ inline bool default_can_point_plane_collide(size_t, size_t) { return true; }
 /// the barrier potential.
 ///
 /// @note The given pv_collisions will be cleared.
+/// @note Points are processed in blocks, and planes farther than dhat from a block's bounding box are culled before the distances are computed in batch.
 ///
 /// @param[in] points Points as rows of a matrix.
 /// @param[in] plane_origins  Plane origins as rows of a matrix.
@@ -58,6 +59,7 @@ bool is_step_point_plane_collision_free(
 /// @note Assumes points_t0 is intersection free.
 /// @note Assumes the trajectory is linear.
 /// @note A value of 1.0 if a full step and 0.0 is no step.
+/// @note Points are processed in blocks, and planes that no point of a block can approach during the step are culled using the block's bounding boxes.
 ///
 /// @param points_t0 Points at start as rows of a matrix.
 /// @param points_t1 Points at end as rows of a matrix.
@@ -0,0 +1,422 @@
+#include "sdf.hpp"
+
+#include <ipc/ccd/point_static_sdf.hpp>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+
+namespace ipc {
+
+namespace {
+    /// @brief Sample a function at the nodes of a grid.
+    /// @note Returns no samples if the grid is invalid (the GridSDF constructor reports the error).
+    Eigen::VectorXd sample(
+        Eigen::ConstRef<VectorMax3d> origin,
+        const double spacing,
+        Eigen::ConstRef<VectorMax3i> resolution,
+        const std::function<double(Eigen::ConstRef<VectorMax3d>)>& sdf)
+    {
+        if (resolution.size() != origin.size() || resolution.size() == 0
+            || resolution.minCoeff() < 1) {
+            return Eigen::VectorXd();
+        }
+
+        Eigen::VectorXd samples(resolution.prod());
+        tbb::parallel_for(
+            tbb::blocked_range<Eigen::Index>(0, samples.size()),
+            [&](const tbb::blocked_range<Eigen::Index>& r) {
+                VectorMax3d node(origin.size());
+                for (Eigen::Index i = r.begin(); i < r.end(); i++) {
+                    Eigen::Index index = i;
+                    for (int a = 0; a < origin.size(); a++) {
+                        node[a] =
+                            origin[a] + spacing * double(index % resolution[a]);
+                        index /= resolution[a];
+                    }
+                    samples[i] = sdf(node);
+                }
+            });
+        return samples;
+    }
+} // namespace
+
+GridSDF::GridSDF(
+    Eigen::ConstRef<VectorMax3d> origin,
+    const double spacing,
+    Eigen::ConstRef<VectorMax3i> resolution,
+    Eigen::ConstRef<Eigen::VectorXd> samples)
+    : m_origin(origin)
+    , m_spacing(spacing)
+    , m_resolution(resolution)
+    , m_samples(samples)
+{
+    if (origin.size() != 2 && origin.size() != 3) {
+        throw std::runtime_error("GridSDF must be 2D or 3D!");
+    }
+    if (resolution.size() != origin.size()) {
+        throw std::runtime_error(
+            "GridSDF resolution and origin dimensions do not match!");
+    }
+    if (spacing <= 0) {
+        throw std::runtime_error("GridSDF spacing must be positive!");
+    }
+    if (resolution.minCoeff() < 2) {
+        throw std::runtime_error(
+            "GridSDF must have at least two samples along each axis!");
+    }
+    if (samples.size() != resolution.prod()) {
+        throw std::runtime_error(
+            "Number of GridSDF samples does not match its resolution!");
+    }
+
+    m_max_corner = m_origin
+        + m_spacing * (m_resolution.array() - 1).cast<double>().matrix();
+    compute_lipschitz_constant();
+}
+
+GridSDF::GridSDF(
+    Eigen::ConstRef<VectorMax3d> origin,
+    const double spacing,
+    Eigen::ConstRef<VectorMax3i> resolution,
+    const std::function<double(Eigen::ConstRef<VectorMax3d>)>& sdf)
+    : GridSDF(
+          origin, spacing, resolution,
+          sample(origin, spacing, resolution, sdf))
+{
+}
+
+bool GridSDF::contains(Eigen::ConstRef<VectorMax3d> point) const
+{
+    assert(point.size() == dim());
+    return (point.array() >= m_origin.array()).all()
+        && (point.array() <= m_max_corner.array()).all();
+}
+
+double GridSDF::value(Eigen::ConstRef<VectorMax3d> point) const
+{
+    double value;
+    interpolate(point, value, nullptr, nullptr);
+    return value;
+}
+
+VectorMax3d GridSDF::gradient(Eigen::ConstRef<VectorMax3d> point) const
+{
+    double value;
+    VectorMax3d gradient;
+    interpolate(point, value, &gradient, nullptr);
+    return gradient;
+}
+
+MatrixMax3d GridSDF::hessian(Eigen::ConstRef<VectorMax3d> point) const
+{
+    double value;
+    MatrixMax3d hessian;
+    interpolate(point, value, nullptr, &hessian);
+    return hessian;
+}
+
+Eigen::VectorXd GridSDF::values(Eigen::ConstRef<Eigen::MatrixXd> points) const
+{
+    assert(points.cols() == dim());
+    Eigen::VectorXd values(points.rows());
+    tbb::parallel_for(
+        tbb::blocked_range<Eigen::Index>(0, points.rows()),
+        [&](const tbb::blocked_range<Eigen::Index>& r) {
+            for (Eigen::Index i = r.begin(); i < r.end(); i++) {
+                interpolate(points.row(i), values[i], nullptr, nullptr);
+            }
+        });
+    return values;
+}
+
+Eigen::MatrixXd
+GridSDF::gradients(Eigen::ConstRef<Eigen::MatrixXd> points) const
+{
+    assert(points.cols() == dim());
+    Eigen::MatrixXd gradients(points.rows(), points.cols());
+    tbb::parallel_for(
+        tbb::blocked_range<Eigen::Index>(0, points.rows()),
+        [&](const tbb::blocked_range<Eigen::Index>& r) {
+            double value;
+            VectorMax3d gradient;
+            for (Eigen::Index i = r.begin(); i < r.end(); i++) {
+                interpolate(points.row(i), value, &gradient, nullptr);
+                gradients.row(i) = gradient;
+            }
+        });
+    return gradients;
+}
+
+void GridSDF::interpolate(
+    Eigen::ConstRef<VectorMax3d> point,
+    double& value,
+    VectorMax3d* gradient,
+    MatrixMax3d* hessian) const
+{
+    const int d = dim();
+    assert(point.size() == d);
+
+    // Locate the cell containing the closest point of the grid.
+    const VectorMax3d closest_point =
+        point.cwiseMax(m_origin).cwiseMin(m_max_corner);
+    std::array<Eigen::Index, 3> cell;
+    std::array<double, 3> u; // local coordinates in [0, 1]
+    for (int a = 0; a < d; a++) {
+        const double x = (closest_point[a] - m_origin[a]) / m_spacing;
+        cell[a] = std::clamp<Eigen::Index>(
+            Eigen::Index(std::floor(x)), 0, m_resolution[a] - 2);
+        u[a] = x - double(cell[a]);
+    }
+
+    value = 0;
+    if (gradient) {
+        gradient->setZero(d);
+    }
+    if (hessian) {
+        hessian->setZero(d, d);
+    }
+
+    // Accumulate the contribution of each corner of the cell.
+    for (int corner = 0; corner < (1 << d); corner++) {
+        std::array<double, 3> w, dw;
+        Eigen::Index index = 0, stride = 1;
+        for (int a = 0; a < d; a++) {
+            const bool is_upper = (corner >> a) & 1;
+            w[a] = is_upper ? u[a] : (1 - u[a]);
+            dw[a] = is_upper ? 1 : -1;
+            index += (cell[a] + is_upper) * stride;
+            stride *= m_resolution[a];
+        }
+        const double sample = m_samples[index];
+
+        double weight = 1;
+        for (int a = 0; a < d; a++) {
+            weight *= w[a];
+        }
+        value += weight * sample;
+
+        for (int a = 0; gradient && a < d; a++) {
+            double partial = dw[a];
+            for (int b = 0; b < d; b++) {
+                if (b != a) {
+                    partial *= w[b];
+                }
+            }
+            (*gradient)[a] += partial * sample;
+        }
+
+        for (int a = 0; hessian && a < d; a++) {
+            for (int b = a + 1; b < d; b++) {
+                double partial = dw[a] * dw[b];
+                for (int c = 0; c < d; c++) {
+                    if (c != a && c != b) {
+                        partial *= w[c];
+                    }
+                }
+                (*hessian)(a, b) += partial * sample;
+            }
+        }
+    }
+
+    if (gradient) {
+        *gradient /= m_spacing;
+    }
+    if (hessian) {
+        *hessian /= m_spacing * m_spacing;
+        for (int a = 0; a < d; a++) {
+            for (int b = a + 1; b < d; b++) {
+                (*hessian)(b, a) = (*hessian)(a, b);
+            }
+        }
+    }
+
+    // Outside of the grid, add the distance to the grid. The interpolated
+    // term is constant along the clamped axes, and the added term only varies
+    // along them.
+    const VectorMax3d offset = point - closest_point;
+    const double distance = offset.norm();
+    if (distance == 0) {
+        return;
+    }
+    value += distance;
+
+    const VectorMax3d direction = offset / distance;
+    for (int a = 0; a < d; a++) {
+        if (offset[a] == 0) {
+            continue;
+        }
+        if (gradient) {
+            (*gradient)[a] = direction[a];
+        }
+        if (hessian) {
+            hessian->row(a).setZero();
+            hessian->col(a).setZero();
+        }
+    }
+    if (hessian) {
+        // Hessian of the distance to the grid: (P - uuᵀ) / r where P projects
+        // onto the clamped axes.
+        for (int a = 0; a < d; a++) {
+            if (offset[a] != 0) {
+                (*hessian)(a, a) += 1 / distance;
+            }
+        }
+        *hessian -= direction * direction.transpose() / distance;
+    }
+}
+
+void GridSDF::compute_lipschitz_constant()
+{
+    const int d = dim();
+
+    Eigen::Index num_cells = 1;
+    for (int a = 0; a < d; a++) {
+        num_cells *= m_resolution[a] - 1;
+    }
+
+    // Inside a cell, the partial derivative along an axis is an interpolation
+    // of the finite differences along the cell's edges parallel to it, so it
+    // is bounded by their maximum magnitude.
+    const double max_squared_gradient = tbb::parallel_reduce(
+        tbb::blocked_range<Eigen::Index>(0, num_cells), 0.0,
+        [&](const tbb::blocked_range<Eigen::Index>& r, double partial_max) {
+            std::array<Eigen::Index, 3> strides;
+            strides[0] = 1;
+            for (int a = 1; a < d; a++) {
+                strides[a] = strides[a - 1] * m_resolution[a - 1];
+            }
+
+            for (Eigen::Index ci = r.begin(); ci < r.end(); ci++) {
+                // First node of the cell
+                Eigen::Index base = 0;
+                Eigen::Index cell_index = ci;
+                for (int a = 0; a < d; a++) {
+                    base += (cell_index % (m_resolution[a] - 1)) * strides[a];
+                    cell_index /= m_resolution[a] - 1;
+                }
+
+                double squared_gradient = 0;
+                for (int a = 0; a < d; a++) {
+                    double max_difference = 0;
+                    for (int corner = 0; corner < (1 << d); corner++) {
+                        if ((corner >> a) & 1) {
+                            continue; // only the lower end of each edge
+                        }
+                        Eigen::Index index = base;
+                        for (int b = 0; b < d; b++) {
+                            index += ((corner >> b) & 1) * strides[b];
+                        }
+                        max_difference = std::max(
+                            max_difference,
+                            std::abs(
+                                m_samples[index + strides[a]]
+                                - m_samples[index]));
+                    }
+                    squared_gradient += max_difference * max_difference;
+                }
+                partial_max = std::max(partial_max, squared_gradient);
+            }
+            return partial_max;
+        },
+        [](double a, double b) { return std::max(a, b); });
+
+    m_lipschitz_constant = std::sqrt(max_squared_gradient) / m_spacing;
+}
+
+// ============================================================================
+
+void construct_point_sdf_collisions(
+    Eigen::ConstRef<Eigen::MatrixXd> points,
+    const std::shared_ptr<const GridSDF>& sdf,
+    const double dhat,
+    std::vector<SDFVertexNormalCollision>& sv_collisions,
+    const double dmin,
+    const std::function<bool(size_t)>& can_collide)
+{
+    assert(sdf != nullptr);
+
+    sv_collisions.clear();
+
+    // Look up the distances of all points at once.
+    const Eigen::VectorXd distances = sdf->values(points);
+
+    for (Eigen::Index vi = 0; vi < points.rows(); vi++) {
+        const double distance = std::abs(distances[vi]);
+        if (distance - dmin < dhat && can_collide(vi)) {
+            sv_collisions.emplace_back(sdf, vi);
+            sv_collisions.back().dmin = dmin;
+        }
+    }
+}
+
+bool is_step_point_sdf_collision_free(
+    Eigen::ConstRef<Eigen::MatrixXd> points_t0,
+    Eigen::ConstRef<Eigen::MatrixXd> points_t1,
+    const GridSDF& sdf,
+    const std::function<bool(size_t)>& can_collide)
+{
+    assert(points_t0.rows() == points_t1.rows());
+    assert(points_t0.cols() == points_t1.cols());
+
+    std::atomic<bool> is_collision_free(true);
+    tbb::parallel_for(
+        tbb::blocked_range<Eigen::Index>(0, points_t0.rows()),
+        [&](const tbb::blocked_range<Eigen::Index>& r) {
+            for (Eigen::Index vi = r.begin(); vi < r.end(); vi++) {
+                if (!is_collision_free.load(std::memory_order_relaxed)) {
+                    return;
+                }
+                if (!can_collide(vi)) {
+                    continue;
+                }
+
+                double toi;
+                if (point_static_sdf_ccd(
+                        points_t0.row(vi), points_t1.row(vi), sdf, toi)) {
+                    is_collision_free.store(false, std::memory_order_relaxed);
+                    return;
+                }
+            }
+        });
+
+    return is_collision_free;
+}
+
+double compute_point_sdf_collision_free_stepsize(
+    Eigen::ConstRef<Eigen::MatrixXd> points_t0,
+    Eigen::ConstRef<Eigen::MatrixXd> points_t1,
+    const GridSDF& sdf,
+    const std::function<bool(size_t)>& can_collide)
+{
+    assert(points_t0.rows() == points_t1.rows());
+    assert(points_t0.cols() == points_t1.cols());
+
+    return tbb::parallel_reduce(
+        tbb::blocked_range<Eigen::Index>(0, points_t0.rows()), 1.0,
+        [&](const tbb::blocked_range<Eigen::Index>& r, double earliest_toi) {
+            for (Eigen::Index vi = r.begin(); vi < r.end(); vi++) {
+                if (!can_collide(vi)) {
+                    continue;
+                }
+
+                double toi;
+                // Only look for collisions before the earliest found so far.
+                if (point_static_sdf_ccd(
+                        points_t0.row(vi), points_t1.row(vi), sdf, toi,
+                        /*min_distance=*/0.0, /*tmax=*/earliest_toi)) {
+                    earliest_toi = std::min(earliest_toi, toi);
+                }
+            }
+            return earliest_toi;
+        },
+        [](double a, double b) { return std::min(a, b); });
+}
+
+} // namespace ipc
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <ipc/collisions/normal/sdf_vertex.hpp>
+#include <ipc/utils/eigen_ext.hpp>
+
+#include <Eigen/Core>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace ipc {
+
+/// @brief A static signed distance field (SDF) sampled on a regular grid.
+///
+/// The field is interpolated bilinearly (2D) or trilinearly (3D) between the
+/// samples. Outside the grid, the value at the closest point of the grid is
+/// extended by the distance to the grid, so the field is defined everywhere.
+/// The grid should therefore enclose the collider with a margin of at least
+/// the barrier's activation distance.
+///
+/// @note The interpolated field is only C⁰ across cell boundaries, so the
+/// distance Hessian is piecewise (i.e., it is the Hessian of the cell
+/// containing the query point).
+class GridSDF {
+public:
+    /// @brief Construct a grid SDF from its samples.
+    /// @param origin Position of the first sample (i.e., the minimum corner of the grid).
+    /// @param spacing Distance between adjacent samples along every axis.
+    /// @param resolution Number of samples along each axis (at least two).
+    /// @param samples Signed distances at the grid nodes ordered with the first axis varying fastest (i.e., node (i, j, k) is at i + nx * (j + ny * k)).
+    GridSDF(
+        Eigen::ConstRef<VectorMax3d> origin,
+        const double spacing,
+        Eigen::ConstRef<VectorMax3i> resolution,
+        Eigen::ConstRef<Eigen::VectorXd> samples);
+
+    /// @brief Construct a grid SDF by sampling a signed distance function at the grid nodes.
+    /// @param origin Position of the first sample (i.e., the minimum corner of the grid).
+    /// @param spacing Distance between adjacent samples along every axis.
+    /// @param resolution Number of samples along each axis (at least two).
+    /// @param sdf Signed distance function to sample.
+    GridSDF(
+        Eigen::ConstRef<VectorMax3d> origin,
+        const double spacing,
+        Eigen::ConstRef<VectorMax3i> resolution,
+        const std::function<double(Eigen::ConstRef<VectorMax3d>)>& sdf);
+
+    /// @brief Get the dimension of the grid.
+    int dim() const { return m_origin.size(); }
+
+    /// @brief Get the position of the first sample.
+    const VectorMax3d& origin() const { return m_origin; }
+
+    /// @brief Get the distance between adjacent samples.
+    double spacing() const { return m_spacing; }
+
+    /// @brief Get the number of samples along each axis.
+    const VectorMax3i& resolution() const { return m_resolution; }
+
+    /// @brief Get the signed distances at the grid nodes.
+    const Eigen::VectorXd& samples() const { return m_samples; }
+
+    /// @brief Get the position of the last sample (i.e., the maximum corner of the grid).
+    const VectorMax3d& max_corner() const { return m_max_corner; }
+
+    /// @brief Determine if a point is inside the grid.
+    /// @param point Point to test.
+    /// @return True if the point is inside the grid (or on its boundary).
+    bool contains(Eigen::ConstRef<VectorMax3d> point) const;
+
+    /// @brief Get an upper bound of the gradient norm of the interpolated field inside the grid.
+    /// @note Outside the grid, the gradient norm is bounded by \f$\sqrt{L^2 + 1}\f$.
+    double lipschitz_constant() const { return m_lipschitz_constant; }
+
+    /// @brief Evaluate the signed distance at a point.
+    /// @param point Query point.
+    /// @return Interpolated signed distance.
+    double value(Eigen::ConstRef<VectorMax3d> point) const;
+
+    /// @brief Evaluate the gradient of the signed distance at a point.
+    /// @param point Query point.
+    /// @return Gradient of the interpolated signed distance.
+    VectorMax3d gradient(Eigen::ConstRef<VectorMax3d> point) const;
+
+    /// @brief Evaluate the Hessian of the signed distance at a point.
+    /// @param point Query point.
+    /// @return Hessian of the interpolated signed distance.
+    MatrixMax3d hessian(Eigen::ConstRef<VectorMax3d> point) const;
+
+    /// @brief Evaluate the signed distance at many points in parallel.
+    /// @param points Query points as rows of a matrix.
+    /// @return Interpolated signed distance of each point.
+    Eigen::VectorXd values(Eigen::ConstRef<Eigen::MatrixXd> points) const;
+
+    /// @brief Evaluate the gradient of the signed distance at many points in parallel.
+    /// @param points Query points as rows of a matrix.
+    /// @return Gradient of the interpolated signed distance of each point (rowwise).
+    Eigen::MatrixXd gradients(Eigen::ConstRef<Eigen::MatrixXd> points) const;
+
+private:
+    /// @brief Interpolate the signed distance and its derivatives at a point.
+    /// @param[in] point Query point.
+    /// @param[out] value Interpolated signed distance.
+    /// @param[out] gradient Gradient of the signed distance (ignored if null).
+    /// @param[out] hessian Hessian of the signed distance (ignored if null).
+    void interpolate(
+        Eigen::ConstRef<VectorMax3d> point,
+        double& value,
+        VectorMax3d* gradient,
+        MatrixMax3d* hessian) const;
+
+    /// @brief Compute the Lipschitz constant of the interpolated field.
+    void compute_lipschitz_constant();
+
+    VectorMax3d m_origin;
+    VectorMax3d m_max_corner;
+    double m_spacing;
+    VectorMax3i m_resolution;
+    Eigen::VectorXd m_samples;
+    double m_lipschitz_constant = 0;
+};
+
+inline bool default_can_point_sdf_collide(size_t) { return true; }
+
+/// @brief Construct a set of point-SDF distance collisions used to compute
+/// the barrier potential.
+///
+/// @note The given sv_collisions will be cleared.
+/// @note The signed distances of all points are looked up in batch, so the cost is linear in the number of points.
+/// @note The collisions share ownership of the SDF.
+///
+/// @param[in] points Points as rows of a matrix.
+/// @param[in] sdf The static signed distance field.
+/// @param[in] dhat  The activation distance of the barrier.
+/// @param[out] sv_collisions  The constructed set of collisions.
+/// @param[in] dmin  Minimum distance.
+/// @param[in] can_collide A function that takes a vertex ID (row numbers in points) then returns true if the vertex can collide with the SDF. By default all points can collide with the SDF.
+void construct_point_sdf_collisions(
+    Eigen::ConstRef<Eigen::MatrixXd> points,
+    const std::shared_ptr<const GridSDF>& sdf,
+    const double dhat,
+    std::vector<SDFVertexNormalCollision>& sv_collisions,
+    const double dmin = 0,
+    const std::function<bool(size_t)>& can_collide =
+        default_can_point_sdf_collide);
+
+// ============================================================================
+// Collision detection
+
+/// @brief Determine if the step is collision free.
+///
+/// @note Assumes the trajectory is linear.
+///
+/// @param[in] points_t0 Points at start as rows of a matrix.
+/// @param[in] points_t1 Points at end as rows of a matrix.
+/// @param[in] sdf The static signed distance field.
+/// @param[in] can_collide A function that takes a vertex ID (row numbers in points) then returns true if the vertex can collide with the SDF. By default all points can collide with the SDF.
+/// @returns True if <b>any</b> collisions occur.
+bool is_step_point_sdf_collision_free(
+    Eigen::ConstRef<Eigen::MatrixXd> points_t0,
+    Eigen::ConstRef<Eigen::MatrixXd> points_t1,
+    const GridSDF& sdf,
+    const std::function<bool(size_t)>& can_collide =
+        default_can_point_sdf_collide);
+
+/// @brief Computes a maximal step size that is collision free.
+///
+/// @note Assumes points_t0 is intersection free.
+/// @note Assumes the trajectory is linear.
+/// @note A value of 1.0 if a full step and 0.0 is no step.
+///
+/// @param points_t0 Points at start as rows of a matrix.
+/// @param points_t1 Points at end as rows of a matrix.
+/// @param sdf The static signed distance field.
+/// @param can_collide A function that takes a vertex ID (row numbers in points) then returns true if the vertex can collide with the SDF. By default all points can collide with the SDF.
+/// @returns A step-size \f$\in [0, 1]\f$ that is collision free.
+double compute_point_sdf_collision_free_stepsize(
+    Eigen::ConstRef<Eigen::MatrixXd> points_t0,
+    Eigen::ConstRef<Eigen::MatrixXd> points_t1,
+    const GridSDF& sdf,
+    const std::function<bool(size_t)>& can_collide =
+        default_can_point_sdf_collide);
+
+} // namespace ipc
@@ -11,6 +11,12 @@
 #endif
 
 #include <igl/predicates/segment_segment_intersect.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+#include <tbb/task_group.h>
+
+#include <atomic>
 
 namespace ipc {
 
@@ -86,62 +92,217 @@ double compute_collision_free_stepsize(
         mesh, vertices_t0, vertices_t1, min_distance, narrow_phase_ccd);
 }
 
-// ============================================================================
+double compute_collision_free_stepsize(
+    const CollisionMesh& mesh,
+    const std::vector<const NonlinearTrajectory*>& trajectories,
+    const double min_distance,
+    const std::shared_ptr<BroadPhase> broad_phase,
+    const double tolerance,
+    const long max_iterations,
+    const double conservative_rescaling)
+{
+    assert(broad_phase != nullptr);
+    assert(trajectories.size() == mesh.num_vertices());
 
-bool has_intersections(
+    // Broad phase
+    Candidates candidates;
+    candidates.build(
+        mesh, trajectories, /*inflation_radius=*/0.5 * min_distance,
+        broad_phase);
+
+    // Narrow phase
+    return candidates.compute_nonlinear_collision_free_stepsize(
+        mesh, trajectories, min_distance, tolerance, max_iterations,
+        conservative_rescaling);
+}
+
+Eigen::VectorXd compute_per_vertex_collision_free_stepsize(
     const CollisionMesh& mesh,
-    Eigen::ConstRef<Eigen::MatrixXd> vertices,
-    const std::shared_ptr<BroadPhase> broad_phase)
+    Eigen::ConstRef<Eigen::MatrixXd> vertices_t0,
+    Eigen::ConstRef<Eigen::MatrixXd> vertices_t1,
+    const double min_distance,
+    const std::shared_ptr<BroadPhase> broad_phase,
+    const NarrowPhaseCCD& narrow_phase_ccd)
 {
     assert(broad_phase != nullptr);
-    assert(vertices.rows() == mesh.num_vertices());
+    assert(vertices_t0.rows() == mesh.num_vertices());
+    assert(vertices_t1.rows() == mesh.num_vertices());
+
+    // Broad phase
+    Candidates candidates;
+    candidates.build(
+        mesh, vertices_t0, vertices_t1, /*inflation_radius=*/0.5 * min_distance,
+        broad_phase);
 
-    const double conservative_inflation_radius =
-        1e-6 * world_bbox_diagonal_length(vertices);
+    // Narrow phase
+    return candidates.compute_per_vertex_collision_free_stepsize(
+        mesh, vertices_t0, vertices_t1, min_distance, narrow_phase_ccd);
+}
 
-    broad_phase->can_vertices_collide = mesh.can_collide;
+// ============================================================================
 
-    broad_phase->build(
-        vertices, mesh.edges(), mesh.faces(), conservative_inflation_radius);
+namespace {
+    /// @brief Check candidates in parallel, stopping at the first intersection.
+    /// @param candidates The candidates to check.
+    /// @param is_intersecting Predicate for if a candidate is intersecting.
+    /// @return A boolean for if any candidate is intersecting.
+    template <typename Candidate, typename Predicate>
+    bool any_intersecting(
+        const std::vector<Candidate>& candidates,
+        const Predicate& is_intersecting)
+    {
+        std::atomic<bool> found = false;
+        tbb::task_group_context context;
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(0, candidates.size()),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t i = r.begin(); i < r.end(); i++) {
+                    if (found.load(std::memory_order_relaxed)) {
+                        return;
+                    }
+                    if (is_intersecting(candidates[i])) {
+                        found = true;
+                        context.cancel_group_execution();
+                        return;
+                    }
+                }
+            },
+            context);
+        return found;
+    }
 
-    if (vertices.cols() == 2) {
-        // Need to check segment-segment intersections in 2D
-        std::vector<EdgeEdgeCandidate> ee_candidates;
+    /// @brief Check the broad-phase candidates for intersections in parallel.
+    /// @param mesh The collision mesh.
+    /// @param vertices Vertices of the collision mesh.
+    /// @param broad_phase The broad phase method to use.
+    /// @param has_moved If given, only check primitives with a moved vertex.
+    /// @return A boolean for if any candidate is intersecting.
+    bool has_intersecting_candidates(
+        const CollisionMesh& mesh,
+        Eigen::ConstRef<Eigen::MatrixXd> vertices,
+        const std::shared_ptr<BroadPhase> broad_phase,
+        const std::vector<uint8_t>* has_moved = nullptr)
+    {
+        assert(broad_phase != nullptr);
+        assert(vertices.rows() == mesh.num_vertices());
 
-        broad_phase->detect_edge_edge_candidates(ee_candidates);
-        broad_phase->clear();
+        const double conservative_inflation_radius =
+            1e-6 * world_bbox_diagonal_length(vertices);
 
-        // narrow-phase using igl
-        igl::predicates::exactinit();
-        for (const auto& [ea_id, eb_id] : ee_candidates) {
-            if (igl::predicates::segment_segment_intersect(
-                    vertices.row(mesh.edges()(ea_id, 0)).head<2>(),
-                    vertices.row(mesh.edges()(ea_id, 1)).head<2>(),
-                    vertices.row(mesh.edges()(eb_id, 0)).head<2>(),
-                    vertices.row(mesh.edges()(eb_id, 1)).head<2>())) {
-                return true;
+        // The broad phase combines the vertex pairs of two primitives with OR,
+        // so the movement filter cannot be combined with the mesh's
+        // can_collide without dropping pairs that can collide through their
+        // fixed vertices. Apply can_collide to the candidates instead.
+        const ScopedVertexFilter filter(
+            *broad_phase,
+            has_moved == nullptr
+                ? mesh.can_collide
+                : [has_moved](size_t vi, size_t vj) {
+                      return (*has_moved)[vi] || (*has_moved)[vj];
+                  });
+        const auto can_collide = [&](const auto& vids_a, const auto& vids_b) {
+            if (has_moved == nullptr) {
+                return true; // Already filtered by the broad phase
             }
-        }
-    } else {
-        // Need to check segment-triangle intersections in 3D
-        assert(vertices.cols() == 3);
-
-        std::vector<EdgeFaceCandidate> ef_candidates;
-        broad_phase->detect_edge_face_candidates(ef_candidates);
-        broad_phase->clear();
-
-        for (const auto& [e_id, f_id] : ef_candidates) {
-            if (is_edge_intersecting_triangle(
-                    vertices.row(mesh.edges()(e_id, 0)),
-                    vertices.row(mesh.edges()(e_id, 1)),
-                    vertices.row(mesh.faces()(f_id, 0)),
-                    vertices.row(mesh.faces()(f_id, 1)),
-                    vertices.row(mesh.faces()(f_id, 2)))) {
-                return true;
+            for (const long vi : vids_a) {
+                for (const long vj : vids_b) {
+                    if (mesh.can_collide(vi, vj)) {
+                        return true;
+                    }
+                }
             }
+            return false;
+        };
+
+        broad_phase->build(
+            vertices, mesh.edges(), mesh.faces(),
+            conservative_inflation_radius);
+
+        if (vertices.cols() == 2) {
+            // Need to check segment-segment intersections in 2D
+            std::vector<EdgeEdgeCandidate> ee_candidates;
+
+            broad_phase->detect_edge_edge_candidates(ee_candidates);
+            broad_phase->clear();
+
+            // narrow-phase using igl
+            igl::predicates::exactinit();
+            return any_intersecting(
+                ee_candidates, [&](const EdgeEdgeCandidate& candidate) {
+                    const auto& [ea_id, eb_id] = candidate;
+                    if (!can_collide(
+                            mesh.edges().row(ea_id),
+                            mesh.edges().row(eb_id))) {
+                        return false;
+                    }
+                    return igl::predicates::segment_segment_intersect(
+                        vertices.row(mesh.edges()(ea_id, 0)).head<2>(),
+                        vertices.row(mesh.edges()(ea_id, 1)).head<2>(),
+                        vertices.row(mesh.edges()(eb_id, 0)).head<2>(),
+                        vertices.row(mesh.edges()(eb_id, 1)).head<2>());
+                });
+        } else {
+            // Need to check segment-triangle intersections in 3D
+            assert(vertices.cols() == 3);
+
+            std::vector<EdgeFaceCandidate> ef_candidates;
+            broad_phase->detect_edge_face_candidates(ef_candidates);
+            broad_phase->clear();
+
+            return any_intersecting(
+                ef_candidates, [&](const EdgeFaceCandidate& candidate) {
+                    const auto& [e_id, f_id] = candidate;
+                    if (!can_collide(
+                            mesh.edges().row(e_id), mesh.faces().row(f_id))) {
+                        return false;
+                    }
+                    return is_edge_intersecting_triangle(
+                        vertices.row(mesh.edges()(e_id, 0)),
+                        vertices.row(mesh.edges()(e_id, 1)),
+                        vertices.row(mesh.faces()(f_id, 0)),
+                        vertices.row(mesh.faces()(f_id, 1)),
+                        vertices.row(mesh.faces()(f_id, 2)));
+                });
         }
     }
+} // namespace
+
+bool has_intersections(
+    const CollisionMesh& mesh,
+    Eigen::ConstRef<Eigen::MatrixXd> vertices,
+    const std::shared_ptr<BroadPhase> broad_phase)
+{
+    return has_intersecting_candidates(mesh, vertices, broad_phase);
+}
+
+bool has_intersections(
+    const CollisionMesh& mesh,
+    Eigen::ConstRef<Eigen::MatrixXd> vertices,
+    Eigen::ConstRef<Eigen::MatrixXd> verified_vertices,
+    const std::shared_ptr<BroadPhase> broad_phase)
+{
+    assert(vertices.rows() == mesh.num_vertices());
+    assert(verified_vertices.rows() == mesh.num_vertices());
+    assert(verified_vertices.cols() == vertices.cols());
+
+    // Elements whose vertices did not move cannot intersect each other.
+    std::vector<uint8_t> has_moved(mesh.num_vertices());
+    const size_t num_moved = tbb::parallel_reduce(
+        tbb::blocked_range<size_t>(0, mesh.num_vertices()), size_t(0),
+        [&](const tbb::blocked_range<size_t>& r, size_t count) {
+            for (size_t vi = r.begin(); vi < r.end(); vi++) {
+                has_moved[vi] = vertices.row(vi) != verified_vertices.row(vi);
+                count += has_moved[vi];
+            }
+            return count;
+        },
+        std::plus<size_t>());
+
+    if (num_moved == 0) {
+        return false;
+    }
 
-    return false;
+    return has_intersecting_candidates(mesh, vertices, broad_phase, &has_moved);
 }
+
 } // namespace ipc
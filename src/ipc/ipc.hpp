@@ -3,6 +3,7 @@
 #include <ipc/collision_mesh.hpp>
 #include <ipc/broad_phase/default_broad_phase.hpp>
 #include <ipc/ccd/default_narrow_phase_ccd.hpp>
+#include <ipc/ccd/nonlinear_ccd.hpp>
 
 #include <Eigen/Core>
 #include <Eigen/Sparse>
@@ -47,6 +48,42 @@ double compute_collision_free_stepsize(
     const std::shared_ptr<BroadPhase> broad_phase = make_default_broad_phase(),
     const NarrowPhaseCCD& narrow_phase_ccd = DEFAULT_NARROW_PHASE_CCD);
 
+/// @brief Computes a maximal step size that is collision free along nonlinear trajectories.
+/// @param mesh The collision mesh.
+/// @param trajectories Trajectory of each vertex. Assumes the vertices at t=0 are intersection free.
+/// @param min_distance The minimum distance allowable between any two elements.
+/// @param broad_phase_method The broad phase method to use.
+/// @param tolerance Tolerance for the linear CCD algorithm.
+/// @param max_iterations Maximum number of iterations for the linear CCD algorithm.
+/// @param conservative_rescaling Conservative rescaling of the time of impact.
+/// @returns A step-size \f$\in [0, 1]\f$ that is collision free. A value of 1.0 if a full step and 0.0 is no step.
+double compute_collision_free_stepsize(
+    const CollisionMesh& mesh,
+    const std::vector<const NonlinearTrajectory*>& trajectories,
+    const double min_distance = 0.0,
+    const std::shared_ptr<BroadPhase> broad_phase = make_default_broad_phase(),
+    const double tolerance = TightInclusionCCD::DEFAULT_TOLERANCE,
+    const long max_iterations = TightInclusionCCD::DEFAULT_MAX_ITERATIONS,
+    const double conservative_rescaling =
+        TightInclusionCCD::DEFAULT_CONSERVATIVE_RESCALING);
+
+/// @brief Computes the maximum collision-free step size of each vertex.
+/// @note Assumes the trajectory is linear.
+/// @param mesh The collision mesh.
+/// @param vertices_t0 Vertex vertices at start as rows of a matrix. Assumes vertices_t0 is intersection free.
+/// @param vertices_t1 Surface vertex vertices at end as rows of a matrix.
+/// @param min_distance The minimum distance allowable between any two elements.
+/// @param broad_phase_method The broad phase method to use.
+/// @param narrow_phase_ccd The narrow phase CCD algorithm to use.
+/// @returns A step-size \f$\in [0, 1]\f$ per vertex that is collision free for all candidates incident on the vertex.
+Eigen::VectorXd compute_per_vertex_collision_free_stepsize(
+    const CollisionMesh& mesh,
+    Eigen::ConstRef<Eigen::MatrixXd> vertices_t0,
+    Eigen::ConstRef<Eigen::MatrixXd> vertices_t1,
+    const double min_distance = 0.0,
+    const std::shared_ptr<BroadPhase> broad_phase = make_default_broad_phase(),
+    const NarrowPhaseCCD& narrow_phase_ccd = DEFAULT_NARROW_PHASE_CCD);
+
 // ============================================================================
 // Utilities
 
@@ -60,4 +97,17 @@ bool has_intersections(
     Eigen::ConstRef<Eigen::MatrixXd> vertices,
     const std::shared_ptr<BroadPhase> broad_phase = make_default_broad_phase());
 
+/// @brief Determine if the mesh has self intersections, given an intersection-free state.
+/// @note Only elements incident to vertices that moved since the verified state are checked.
+/// @param mesh The collision mesh.
+/// @param vertices Vertices of the collision mesh.
+/// @param verified_vertices Intersection-free vertices of the collision mesh (e.g., the last accepted state).
+/// @param broad_phase_method The broad phase method to use.
+/// @return A boolean for if the mesh has intersections.
+bool has_intersections(
+    const CollisionMesh& mesh,
+    Eigen::ConstRef<Eigen::MatrixXd> vertices,
+    Eigen::ConstRef<Eigen::MatrixXd> verified_vertices,
+    const std::shared_ptr<BroadPhase> broad_phase = make_default_broad_phase());
+
 } // namespace ipc
@@ -15,15 +15,62 @@ Eigen::SparseMatrix<double> NormalPotential::shape_derivative(
         return Eigen::SparseMatrix<double>(vertices.size(), vertices.size());
     }
 
+    const int ndof = vertices.size();
+
+    TripletStorage local_storage;
+    TripletStorage& storage =
+        thread_local_storage(m_workspace.get(), local_storage);
+
+    shape_derivative_triplets(collisions, mesh, vertices, storage);
+
+    Eigen::SparseMatrix<double> shape_derivative(ndof, ndof);
+    for (const auto& local_triplets : storage) {
+        Eigen::SparseMatrix<double> local_shape_derivative(ndof, ndof);
+        local_shape_derivative.setFromTriplets(
+            local_triplets.begin(), local_triplets.end());
+        shape_derivative += local_shape_derivative;
+    }
+    return shape_derivative;
+}
+
+BlockSparseMatrix NormalPotential::shape_derivative_bsr(
+    const NormalCollisions& collisions,
+    const CollisionMesh& mesh,
+    Eigen::ConstRef<Eigen::MatrixXd> vertices) const
+{
+    assert(vertices.rows() == mesh.num_vertices());
+
+    BlockSparseMatrix shape_derivative(
+        vertices.size(), vertices.size(), vertices.cols());
+    if (collisions.empty()) {
+        return shape_derivative;
+    }
+
+    TripletStorage local_storage;
+    TripletStorage& storage =
+        thread_local_storage(m_workspace.get(), local_storage);
+
+    shape_derivative_triplets(collisions, mesh, vertices, storage);
+
+    shape_derivative.set_from_triplets(storage);
+    return shape_derivative;
+}
+
+void NormalPotential::shape_derivative_triplets(
+    const NormalCollisions& collisions,
+    const CollisionMesh& mesh,
+    Eigen::ConstRef<Eigen::MatrixXd> vertices,
+    TripletStorage& storage) const
+{
+    if (collisions.weight_gradients.size() < collisions.size()) {
+        throw std::runtime_error(
+            "Shape derivative is not computed for collisions!");
+    }
+
     const Eigen::MatrixXd& rest_positions = mesh.rest_positions();
     const Eigen::MatrixXi& edges = mesh.edges();
     const Eigen::MatrixXi& faces = mesh.faces();
 
-    const int ndof = vertices.size();
-
-    tbb::enumerable_thread_specific<std::vector<Eigen::Triplet<double>>>
-        storage;
-
     tbb::parallel_for(
         tbb::blocked_range<size_t>(size_t(0), collisions.size()),
         [&](const tbb::blocked_range<size_t>& r) {
@@ -31,20 +78,12 @@ Eigen::SparseMatrix<double> NormalPotential::shape_derivative(
 
             for (size_t i = r.begin(); i < r.end(); i++) {
                 this->shape_derivative(
-                    collisions[i], collisions[i].vertex_ids(edges, faces),
+                    collisions[i], collisions.weight_gradients[i],
+                    collisions[i].vertex_ids(edges, faces),
                     collisions[i].dof(rest_positions, edges, faces),
                     collisions[i].dof(vertices, edges, faces), local_triplets);
             }
         });
-
-    Eigen::SparseMatrix<double> shape_derivative(ndof, ndof);
-    for (const auto& local_triplets : storage) {
-        Eigen::SparseMatrix<double> local_shape_derivative(ndof, ndof);
-        local_shape_derivative.setFromTriplets(
-            local_triplets.begin(), local_triplets.end());
-        shape_derivative += local_shape_derivative;
-    }
-    return shape_derivative;
 }
 
 // -- Single collision methods -------------------------------------------------
@@ -53,39 +92,24 @@ double NormalPotential::operator()(
     const NormalCollision& collision,
     Eigen::ConstRef<VectorMax12d> positions) const
 {
-    // w * m(x) * f(d(x))
-    // NOTE: can save a multiplication by checking if !collision.is_mollified()
-    const double d = collision.compute_distance(positions);
-    return collision.weight * collision.mollifier(positions)
-        * (*this)(d, collision.dmin);
+    double energy;
+    VectorMax12d grad;
+    MatrixMax12d hess;
+    evaluate(
+        collision, positions, EvaluationFlags::ENERGY, energy, grad, hess);
+    return energy;
 }
 
 VectorMax12d NormalPotential::gradient(
     const NormalCollision& collision,
     Eigen::ConstRef<VectorMax12d> positions) const
 {
-    // d(x)
-    const double d = collision.compute_distance(positions);
-    // ∇d(x)
-    const VectorMax12d grad_d = collision.compute_distance_gradient(positions);
-
-    // f(d(x))
-    const double f = (*this)(d, collision.dmin);
-    // f'(d(x))
-    const double grad_f = gradient(d, collision.dmin);
-
-    if (!collision.is_mollified()) {
-        // ∇[f(d(x))] = f'(d(x)) * ∇d(x)
-        return (collision.weight * grad_f) * grad_d;
-    }
-
-    const double m = collision.mollifier(positions); // m(x)
-    const VectorMax12d grad_m =
-        collision.mollifier_gradient(positions); // ∇m(x)
-
-    // ∇[m(x) * f(d(x))] = f(d(x)) * ∇m(x) + m(x) * ∇ f(d(x))
-    return (collision.weight * f) * grad_m
-        + (collision.weight * m * grad_f) * grad_d;
+    double energy;
+    VectorMax12d grad;
+    MatrixMax12d hess;
+    evaluate(
+        collision, positions, EvaluationFlags::GRADIENT, energy, grad, hess);
+    return grad;
 }
 
 MatrixMax12d NormalPotential::hessian(
@@ -93,31 +117,85 @@ MatrixMax12d NormalPotential::hessian(
     Eigen::ConstRef<VectorMax12d> positions,
     const PSDProjectionMethod project_hessian_to_psd) const
 {
+    double energy;
+    VectorMax12d grad;
+    MatrixMax12d hess;
+    evaluate(
+        collision, positions, EvaluationFlags::HESSIAN, energy, grad, hess,
+        project_hessian_to_psd);
+    return hess;
+}
+
+void NormalPotential::evaluate(
+    const NormalCollision& collision,
+    Eigen::ConstRef<VectorMax12d> positions,
+    const EvaluationFlags flags,
+    double& energy,
+    VectorMax12d& grad,
+    MatrixMax12d& hess,
+    const PSDProjectionMethod project_hessian_to_psd) const
+{
+    const bool compute_energy = has_flag(flags, EvaluationFlags::ENERGY);
+    const bool compute_grad = has_flag(flags, EvaluationFlags::GRADIENT);
+    const bool compute_hess = has_flag(flags, EvaluationFlags::HESSIAN);
+    const bool compute_derivatives = compute_grad || compute_hess;
+    const bool is_mollified = collision.is_mollified();
+
     // d(x)
     const double d = collision.compute_distance(positions);
+
+    // f(d(x)) and m(x) (only needed by the derivatives if mollified)
+    double f = 0, m = 1;
+    if (compute_energy || (compute_derivatives && is_mollified)) {
+        f = (*this)(d, collision.dmin);
+        m = collision.mollifier(positions);
+    }
+
+    if (compute_energy) {
+        // w * m(x) * f(d(x))
+        energy = collision.weight * m * f;
+    }
+
+    if (!compute_derivatives) {
+        return;
+    }
+
     // ∇d(x)
     const VectorMax12d grad_d = collision.compute_distance_gradient(positions);
-    // ∇²d(x)
-    const MatrixMax12d hess_d = collision.compute_distance_hessian(positions);
-
     // f'(d(x))
     const double grad_f = gradient(d, collision.dmin);
+    // ∇m(x)
+    VectorMax12d grad_m;
+    if (is_mollified) {
+        grad_m = collision.mollifier_gradient(positions);
+    }
+
+    if (compute_grad) {
+        if (!is_mollified) {
+            // ∇[f(d(x))] = f'(d(x)) * ∇d(x)
+            grad = (collision.weight * grad_f) * grad_d;
+        } else {
+            // ∇[m(x) * f(d(x))] = f(d(x)) * ∇m(x) + m(x) * ∇ f(d(x))
+            grad = (collision.weight * f) * grad_m
+                + (collision.weight * m * grad_f) * grad_d;
+        }
+    }
+
+    if (!compute_hess) {
+        return;
+    }
+
+    // ∇²d(x)
+    const MatrixMax12d hess_d = collision.compute_distance_hessian(positions);
     // f"(d(x))
     const double hess_f = hessian(d, collision.dmin);
 
-    MatrixMax12d hess;
-    if (!collision.is_mollified()) {
+    if (!is_mollified) {
         // ∇²[f(d(x))] = ∇(f'(d(x)) * ∇d(x))
         //             = f"(d(x)) * ∇d(x) * ∇d(x)ᵀ + f'(d(x)) * ∇²d(x)
         hess = (collision.weight * hess_f) * grad_d * grad_d.transpose()
             + (collision.weight * grad_f) * hess_d;
     } else {
-        const double f = (*this)(d, collision.dmin); // f(d(x))
-
-        // m(x)
-        const double m = collision.mollifier(positions);
-        // ∇ m(x)
-        const VectorMax12d grad_m = collision.mollifier_gradient(positions);
         // ∇² m(x)
         const MatrixMax12d hess_m = collision.mollifier_hessian(positions);
 
@@ -137,11 +215,12 @@ MatrixMax12d NormalPotential::hessian(
     }
 
     // Need to project entire hessian because w can be negative
-    return project_to_psd(hess, project_hessian_to_psd);
+    hess = project_to_psd(hess, project_hessian_to_psd);
 }
 
 void NormalPotential::shape_derivative(
     const NormalCollision& collision,
+    const Eigen::SparseVector<double>& weight_gradient,
     const std::array<long, 4>& vertex_ids,
     Eigen::ConstRef<VectorMax12d> rest_positions, // = x̄
     Eigen::ConstRef<VectorMax12d> positions,      // = x̄ + u
@@ -157,12 +236,12 @@ void NormalPotential::shape_derivative(
     //                         (first term)        (second term)
 
     // First term:
-    if (collision.weight_gradient.size() <= 0) {
+    if (weight_gradient.size() <= 0) {
         throw std::runtime_error(
             "Shape derivative is not computed for collisions!");
     }
 
-    if (collision.weight_gradient.nonZeros()) {
+    if (weight_gradient.nonZeros()) {
         VectorMax12d grad_f = gradient(collision, positions);
         assert(collision.weight != 0);
         grad_f.array() /= collision.weight; // remove weight
@@ -170,7 +249,7 @@ void NormalPotential::shape_derivative(
         for (int i = 0; i < collision.num_vertices(); i++) {
             for (int d = 0; d < dim; d++) {
                 using Itr = Eigen::SparseVector<double>::InnerIterator;
-                for (Itr j(collision.weight_gradient); j; ++j) {
+                for (Itr j(weight_gradient); j; ++j) {
                     out.emplace_back(
                         vertex_ids[i] * dim + d, j.index(),
                         grad_f[dim * i + d] * j.value());
@@ -20,6 +20,7 @@ public:
     using Super::operator();
     using Super::gradient;
     using Super::hessian;
+    using Super::evaluate;
 
     /// @brief Compute the shape derivative of the potential.
     /// @param collisions The set of collisions.
@@ -32,6 +33,17 @@ public:
         const CollisionMesh& mesh,
         Eigen::ConstRef<Eigen::MatrixXd> vertices) const;
 
+    /// @brief Compute the shape derivative of the potential in block compressed sparse row (BSR) format.
+    /// @param collisions The set of collisions.
+    /// @param mesh The collision mesh.
+    /// @param vertices Vertices of the collision mesh.
+    /// @throws std::runtime_error If the collision collisions were not built with shape derivatives enabled.
+    /// @returns The derivative of the force with respect to X, the rest vertices, made of dim×dim blocks.
+    BlockSparseMatrix shape_derivative_bsr(
+        const NormalCollisions& collisions,
+        const CollisionMesh& mesh,
+        Eigen::ConstRef<Eigen::MatrixXd> vertices) const;
+
     // -- Single collision methods ---------------------------------------------
 
     /// @brief Compute the potential for a single collision.
@@ -60,14 +72,35 @@ public:
         const PSDProjectionMethod project_hessian_to_psd =
             PSDProjectionMethod::NONE) const override;
 
+    /// @brief Compute any subset of the potential, its gradient, and its hessian for a single collision.
+    /// @note The distance, mollifier, and barrier values are shared between the requested outputs.
+    /// @param[in] collision The collision.
+    /// @param[in] positions The collision stencil's positions.
+    /// @param[in] flags The quantities to compute.
+    /// @param[out] energy The potential (only set if requested).
+    /// @param[out] grad The gradient of the potential (only set if requested).
+    /// @param[out] hess The hessian of the potential (only set if requested).
+    /// @param[in] project_hessian_to_psd Make sure the hessian is positive semi-definite.
+    void evaluate(
+        const NormalCollision& collision,
+        Eigen::ConstRef<VectorMax12d> positions,
+        const EvaluationFlags flags,
+        double& energy,
+        VectorMax12d& grad,
+        MatrixMax12d& hess,
+        const PSDProjectionMethod project_hessian_to_psd =
+            PSDProjectionMethod::NONE) const override;
+
     /// @brief Compute the shape derivative of the potential for a single collision.
     /// @param[in] collision The collision.
+    /// @param[in] weight_gradient The gradient of the collision's weight w.r.t. the rest positions (e.g., NormalCollisions::weight_gradients[i]).
     /// @param[in] vertex_ids The collision stencil's vertex ids.
     /// @param[in] rest_positions The collision stencil's rest positions.
     /// @param[in] positions The collision stencil's positions.
     /// @param[in,out] out Store the triplets of the shape derivative here.
     void shape_derivative(
         const NormalCollision& collision,
+        const Eigen::SparseVector<double>& weight_gradient,
         const std::array<long, 4>& vertex_ids,
         Eigen::ConstRef<VectorMax12d> rest_positions,
         Eigen::ConstRef<VectorMax12d> positions,
@@ -96,6 +129,17 @@ public:
         const double barrier_stiffness) const = 0;
 
 protected:
+    /// @brief Compute the triplets of the shape derivative of the potential.
+    /// @param[in] collisions The set of collisions.
+    /// @param[in] mesh The collision mesh.
+    /// @param[in] vertices Vertices of the collision mesh.
+    /// @param[in,out] storage Store the triplets of the shape derivative here.
+    void shape_derivative_triplets(
+        const NormalCollisions& collisions,
+        const CollisionMesh& mesh,
+        Eigen::ConstRef<Eigen::MatrixXd> vertices,
+        TripletStorage& storage) const;
+
     /// @brief Compute the unmollified distance-based potential for a collisions.
     /// @param distance_squared The distance (squared) between the two objects.
     /// @param dmin The minimum distance (unsquared) between the two objects.
@@ -1,10 +1,58 @@
 #pragma once
 
 #include <ipc/collision_mesh.hpp>
+#include <ipc/utils/block_sparse_matrix.hpp>
 #include <ipc/utils/eigen_ext.hpp>
+#include <ipc/utils/gradient_scatter.hpp>
+#include <ipc/utils/hessian_operator.hpp>
+#include <ipc/utils/hessian_pattern.hpp>
+#include <ipc/utils/workspace.hpp>
+
+#include <cstdint>
+#include <vector>
 
 namespace ipc {
 
+/// @brief Quantities computed by Potential::evaluate (combine with |).
+enum class EvaluationFlags : uint8_t {
+    NONE = 0,                         ///< Compute nothing
+    ENERGY = 1 << 0,                  ///< Compute the potential
+    GRADIENT = 1 << 1,                ///< Compute the gradient
+    HESSIAN = 1 << 2,                 ///< Compute the Hessian
+    ALL = ENERGY | GRADIENT | HESSIAN ///< Compute all quantities
+};
+
+inline EvaluationFlags
+operator|(const EvaluationFlags a, const EvaluationFlags b)
+{
+    return static_cast<EvaluationFlags>(uint8_t(a) | uint8_t(b));
+}
+
+inline EvaluationFlags
+operator&(const EvaluationFlags a, const EvaluationFlags b)
+{
+    return static_cast<EvaluationFlags>(uint8_t(a) & uint8_t(b));
+}
+
+/// @brief Determine if a flag is set.
+/// @param flags The set of flags.
+/// @param flag The flag to check.
+/// @return True if the flag is set in flags.
+inline bool has_flag(const EvaluationFlags flags, const EvaluationFlags flag)
+{
+    return (flags & flag) != EvaluationFlags::NONE;
+}
+
+/// @brief Quantities computed by Potential::evaluate.
+struct PotentialEvaluation {
+    /// @brief The potential (zero if not requested).
+    double energy = 0;
+    /// @brief The gradient of the potential w.r.t. X (empty if not requested).
+    Eigen::VectorXd gradient;
+    /// @brief The Hessian of the potential w.r.t. X (empty if not requested).
+    Eigen::SparseMatrix<double> hessian;
+};
+
 /// @brief Base class for potentials.
 /// @tparam TCollisions The type of the collisions.
 template <class TCollisions> class Potential {
@@ -15,6 +63,18 @@ public:
     Potential() = default;
     virtual ~Potential() = default;
 
+    /// @brief Get the workspace used to reuse buffers across evaluations.
+    /// @return The workspace (null if buffers are allocated per evaluation).
+    const std::shared_ptr<Workspace>& workspace() const { return m_workspace; }
+
+    /// @brief Set the workspace used to reuse buffers across evaluations.
+    /// @note A potential with a workspace must not be evaluated concurrently from multiple threads.
+    /// @param workspace The workspace (null to allocate buffers per evaluation).
+    void set_workspace(std::shared_ptr<Workspace> workspace)
+    {
+        m_workspace = std::move(workspace);
+    }
+
     // -- Cumulative methods ---------------------------------------------------
 
     /// @brief Compute the potential for a set of collisions.
@@ -28,6 +88,7 @@ public:
         Eigen::ConstRef<Eigen::MatrixXd> X) const;
 
     /// @brief Compute the gradient of the potential.
+    /// @note The local gradients are gathered with a GradientScatter, which is kept in the workspace (if any) and reused while the collisions' stencils do not change.
     /// @param collisions The set of collisions.
     /// @param mesh The collision mesh.
     /// @param X Degrees of freedom of the collision mesh (e.g., vertices or velocities).
@@ -37,6 +98,24 @@ public:
         const CollisionMesh& mesh,
         Eigen::ConstRef<Eigen::MatrixXd> X) const;
 
+    /// @brief Compute the gradient of the potential with a given scatter.
+    ///
+    /// The local gradients are written to the scatter's per-collision buffers
+    /// and gathered by vertex, so the scratch memory does not grow with the
+    /// number of threads and no two threads write the same entry. The scatter
+    /// is only rebuilt if the collisions' stencils changed since it was built.
+    ///
+    /// @param collisions The set of collisions.
+    /// @param mesh The collision mesh.
+    /// @param X Degrees of freedom of the collision mesh (e.g., vertices or velocities).
+    /// @param scatter The scatter to reuse (rebuilt if needed).
+    /// @returns The gradient of the potential w.r.t. X stored in the scatter (valid until the scatter is reused). This will have a size of |X|.
+    const Eigen::VectorXd& gradient(
+        const TCollisions& collisions,
+        const CollisionMesh& mesh,
+        Eigen::ConstRef<Eigen::MatrixXd> X,
+        GradientScatter& scatter) const;
+
     /// @brief Compute the hessian of the potential.
     /// @param collisions The set of collisions.
     /// @param mesh The collision mesh.
@@ -50,6 +129,183 @@ public:
         const PSDProjectionMethod project_hessian_to_psd =
             PSDProjectionMethod::NONE) const;
 
+    /// @brief Compute the hessian of the potential reusing a sparsity pattern.
+    ///
+    /// The local hessians are scattered directly into the pattern's values
+    /// instead of being assembled from triplets. The pattern is only rebuilt
+    /// if the collisions' stencils changed since it was built (e.g., when the
+    /// active set changes), so across Newton iterations with the same
+    /// collisions only the numeric values are refreshed.
+    ///
+    /// @param collisions The set of collisions.
+    /// @param mesh The collision mesh.
+    /// @param X Degrees of freedom of the collision mesh (e.g., vertices or velocities).
+    /// @param pattern The sparsity pattern to reuse (rebuilt if needed).
+    /// @param project_hessian_to_psd Make sure the hessian is positive semi-definite.
+    /// @returns The Hessian of the potential w.r.t. X stored in the pattern (valid until the pattern is reused). This will have a size of |X|×|X|.
+    const Eigen::SparseMatrix<double>& hessian(
+        const TCollisions& collisions,
+        const CollisionMesh& mesh,
+        Eigen::ConstRef<Eigen::MatrixXd> X,
+        HessianPattern& pattern,
+        const PSDProjectionMethod project_hessian_to_psd =
+            PSDProjectionMethod::NONE) const;
+
+    /// @brief Compute the hessian of the potential in block compressed sparse row (BSR) format.
+    /// @param collisions The set of collisions.
+    /// @param mesh The collision mesh.
+    /// @param X Degrees of freedom of the collision mesh (e.g., vertices or velocities).
+    /// @param project_hessian_to_psd Make sure the hessian is positive semi-definite.
+    /// @returns The Hessian of the potential w.r.t. X made of dim×dim blocks. This will have a size of |X|×|X|.
+    BlockSparseMatrix hessian_bsr(
+        const TCollisions& collisions,
+        const CollisionMesh& mesh,
+        Eigen::ConstRef<Eigen::MatrixXd> X,
+        const PSDProjectionMethod project_hessian_to_psd =
+            PSDProjectionMethod::NONE) const;
+
+    /// @brief Compute the product of the hessian of the potential with a vector without assembling the hessian.
+    ///
+    /// Each collision's local hessian is applied to the collision stencil's
+    /// entries of p as soon as it is computed, so no global matrix is stored.
+    /// The local products are then gathered by vertex (see GradientScatter),
+    /// so no per-thread global vectors are needed either.
+    ///
+    /// @param collisions The set of collisions.
+    /// @param mesh The collision mesh.
+    /// @param X Degrees of freedom of the collision mesh (e.g., vertices or velocities).
+    /// @param p The vector to multiply (of size |X|, ordered like the gradient).
+    /// @param project_hessian_to_psd Make sure the hessian is positive semi-definite.
+    /// @returns The product of the Hessian of the potential w.r.t. X with p. This will have a size of |X|.
+    Eigen::VectorXd hessian_vector_product(
+        const TCollisions& collisions,
+        const CollisionMesh& mesh,
+        Eigen::ConstRef<Eigen::MatrixXd> X,
+        Eigen::ConstRef<Eigen::VectorXd> p,
+        const PSDProjectionMethod project_hessian_to_psd =
+            PSDProjectionMethod::NONE) const;
+
+    /// @brief Compute the local hessians of the potential as a matrix-free operator.
+    /// @note Use this instead of hessian_vector_product() when multiplying the same hessian by several vectors (e.g., in a conjugate gradient solve).
+    /// @param collisions The set of collisions.
+    /// @param mesh The collision mesh.
+    /// @param X Degrees of freedom of the collision mesh (e.g., vertices or velocities).
+    /// @param project_hessian_to_psd Make sure the hessian is positive semi-definite.
+    /// @returns The Hessian of the potential w.r.t. X as an operator. This will have a size of |X|×|X|.
+    HessianOperator hessian_operator(
+        const TCollisions& collisions,
+        const CollisionMesh& mesh,
+        Eigen::ConstRef<Eigen::MatrixXd> X,
+        const PSDProjectionMethod project_hessian_to_psd =
+            PSDProjectionMethod::NONE) const;
+
+    /// @brief Compute the diagonal of the hessian of the potential without assembling the hessian.
+    /// @note Useful for Jacobi preconditioners.
+    /// @param collisions The set of collisions.
+    /// @param mesh The collision mesh.
+    /// @param X Degrees of freedom of the collision mesh (e.g., vertices or velocities).
+    /// @param project_hessian_to_psd Make sure the hessian is positive semi-definite (applied to the local hessians before their diagonals are extracted).
+    /// @returns The diagonal of the Hessian of the potential w.r.t. X. This will have a size of |X|.
+    Eigen::VectorXd hessian_diagonal(
+        const TCollisions& collisions,
+        const CollisionMesh& mesh,
+        Eigen::ConstRef<Eigen::MatrixXd> X,
+        const PSDProjectionMethod project_hessian_to_psd =
+            PSDProjectionMethod::NONE) const;
+
+    /// @brief Compute the vertex diagonal blocks of the hessian of the potential without assembling the hessian.
+    /// @note Useful for block-Jacobi preconditioners.
+    /// @param collisions The set of collisions.
+    /// @param mesh The collision mesh.
+    /// @param X Degrees of freedom of the collision mesh (e.g., vertices or velocities).
+    /// @param project_hessian_to_psd Make sure the hessian is positive semi-definite (applied to the local hessians before their blocks are extracted).
+    /// @returns The dim×dim diagonal blocks of the Hessian of the potential w.r.t. X stacked vertically (i.e., rows [dim·i, dim·i + dim) hold the block of vertex i). This will have a size of |X|×dim.
+    Eigen::MatrixXd hessian_block_diagonal(
+        const TCollisions& collisions,
+        const CollisionMesh& mesh,
+        Eigen::ConstRef<Eigen::MatrixXd> X,
+        const PSDProjectionMethod project_hessian_to_psd =
+            PSDProjectionMethod::NONE) const;
+
+    /// @brief Compute any subset of the potential, its gradient, and its hessian in a single pass.
+    ///
+    /// Each collision's degrees of freedom are gathered once and the
+    /// intermediate quantities (e.g., distances and their derivatives) are
+    /// shared between the requested outputs, which is cheaper than calling
+    /// operator(), gradient(), and hessian() separately.
+    ///
+    /// @param collisions The set of collisions.
+    /// @param mesh The collision mesh.
+    /// @param X Degrees of freedom of the collision mesh (e.g., vertices or velocities).
+    /// @param flags The quantities to compute.
+    /// @param project_hessian_to_psd Make sure the hessian is positive semi-definite.
+    /// @returns The requested quantities.
+    PotentialEvaluation evaluate(
+        const TCollisions& collisions,
+        const CollisionMesh& mesh,
+        Eigen::ConstRef<Eigen::MatrixXd> X,
+        const EvaluationFlags flags = EvaluationFlags::ALL,
+        const PSDProjectionMethod project_hessian_to_psd =
+            PSDProjectionMethod::NONE) const;
+
+    // -- Restricted cumulative methods ----------------------------------------
+
+    /// @brief Compute the potential for a subset of the collisions.
+    /// @param collisions The set of collisions.
+    /// @param mesh The collision mesh.
+    /// @param X Degrees of freedom of the collision mesh (e.g., vertices or velocities).
+    /// @param collision_ids Indices of the collisions to include (e.g., the stencils of a contact island).
+    /// @returns The potential for the subset of collisions.
+    double operator()(
+        const TCollisions& collisions,
+        const CollisionMesh& mesh,
+        Eigen::ConstRef<Eigen::MatrixXd> X,
+        const std::vector<size_t>& collision_ids) const;
+
+    /// @brief Compute the gradient of the potential for a subset of the collisions.
+    /// @param collisions The set of collisions.
+    /// @param mesh The collision mesh.
+    /// @param X Degrees of freedom of the collision mesh (e.g., vertices or velocities).
+    /// @param collision_ids Indices of the collisions to include (e.g., the stencils of a contact island).
+    /// @returns The gradient of the potential w.r.t. X. This will have a size of |X|.
+    Eigen::VectorXd gradient(
+        const TCollisions& collisions,
+        const CollisionMesh& mesh,
+        Eigen::ConstRef<Eigen::MatrixXd> X,
+        const std::vector<size_t>& collision_ids) const;
+
+    /// @brief Compute the hessian of the potential for a subset of the collisions.
+    /// @param collisions The set of collisions.
+    /// @param mesh The collision mesh.
+    /// @param X Degrees of freedom of the collision mesh (e.g., vertices or velocities).
+    /// @param collision_ids Indices of the collisions to include (e.g., the stencils of a contact island).
+    /// @param project_hessian_to_psd Make sure the hessian is positive semi-definite.
+    /// @returns The Hessian of the potential w.r.t. X. This will have a size of |X|×|X|.
+    Eigen::SparseMatrix<double> hessian(
+        const TCollisions& collisions,
+        const CollisionMesh& mesh,
+        Eigen::ConstRef<Eigen::MatrixXd> X,
+        const std::vector<size_t>& collision_ids,
+        const PSDProjectionMethod project_hessian_to_psd =
+            PSDProjectionMethod::NONE) const;
+
+    /// @brief Compute any subset of the potential, its gradient, and its hessian for a subset of the collisions in a single pass.
+    /// @param collisions The set of collisions.
+    /// @param mesh The collision mesh.
+    /// @param X Degrees of freedom of the collision mesh (e.g., vertices or velocities).
+    /// @param collision_ids Indices of the collisions to include (e.g., the stencils of a contact island).
+    /// @param flags The quantities to compute.
+    /// @param project_hessian_to_psd Make sure the hessian is positive semi-definite.
+    /// @returns The requested quantities.
+    PotentialEvaluation evaluate(
+        const TCollisions& collisions,
+        const CollisionMesh& mesh,
+        Eigen::ConstRef<Eigen::MatrixXd> X,
+        const std::vector<size_t>& collision_ids,
+        const EvaluationFlags flags = EvaluationFlags::ALL,
+        const PSDProjectionMethod project_hessian_to_psd =
+            PSDProjectionMethod::NONE) const;
+
     // -- Single collision methods ---------------------------------------------
 
     /// @brief Compute the potential for a single collision.
@@ -75,6 +331,122 @@ public:
         Eigen::ConstRef<VectorMax12d> x,
         const PSDProjectionMethod project_hessian_to_psd =
             PSDProjectionMethod::NONE) const = 0;
+
+    /// @brief Compute any subset of the potential, its gradient, and its hessian for a single collision.
+    /// @note The default implementation calls operator(), gradient(), and hessian(). Derived classes should override it to share intermediate quantities.
+    /// @param[in] collision The collision.
+    /// @param[in] x The collision stencil's degrees of freedom.
+    /// @param[in] flags The quantities to compute.
+    /// @param[out] energy The potential (only set if requested).
+    /// @param[out] grad The gradient of the potential (only set if requested).
+    /// @param[out] hess The hessian of the potential (only set if requested).
+    /// @param[in] project_hessian_to_psd Make sure the hessian is positive semi-definite.
+    virtual void evaluate(
+        const TCollision& collision,
+        Eigen::ConstRef<VectorMax12d> x,
+        const EvaluationFlags flags,
+        double& energy,
+        VectorMax12d& grad,
+        MatrixMax12d& hess,
+        const PSDProjectionMethod project_hessian_to_psd =
+            PSDProjectionMethod::NONE) const;
+
+protected:
+    /// @brief Identity map over the indices of all collisions.
+    struct AllCollisionIds {
+        size_t size() const { return n; }
+        size_t operator[](size_t i) const { return i; }
+        size_t n;
+    };
+
+    /// @brief Compute the vertex ids of each collision's stencil.
+    std::vector<std::array<long, 4>> collision_stencils(
+        const TCollisions& collisions, const CollisionMesh& mesh) const
+    {
+        return collision_stencils(
+            collisions, mesh, AllCollisionIds { collisions.size() });
+    }
+
+    /// @brief Compute the vertex ids of the stencils of the collisions selected by ids.
+    template <typename CollisionIds>
+    std::vector<std::array<long, 4>> collision_stencils(
+        const TCollisions& collisions,
+        const CollisionMesh& mesh,
+        const CollisionIds& collision_ids) const;
+
+    /// @brief Compute the potential for the collisions selected by ids.
+    template <typename CollisionIds>
+    double energy_impl(
+        const TCollisions& collisions,
+        const CollisionMesh& mesh,
+        Eigen::ConstRef<Eigen::MatrixXd> X,
+        const CollisionIds& collision_ids) const;
+
+    /// @brief Compute the gradient for the collisions selected by ids.
+    template <typename CollisionIds>
+    Eigen::VectorXd gradient_impl(
+        const TCollisions& collisions,
+        const CollisionMesh& mesh,
+        Eigen::ConstRef<Eigen::MatrixXd> X,
+        const CollisionIds& collision_ids) const;
+
+    /// @brief Compute the gradient for the collisions selected by ids with a given scatter.
+    template <typename CollisionIds>
+    const Eigen::VectorXd& gradient_impl(
+        const TCollisions& collisions,
+        const CollisionMesh& mesh,
+        Eigen::ConstRef<Eigen::MatrixXd> X,
+        const CollisionIds& collision_ids,
+        GradientScatter& scatter) const;
+
+    /// @brief Thread-local triplets of a sparse matrix.
+    using TripletStorage =
+        tbb::enumerable_thread_specific<std::vector<Eigen::Triplet<double>>>;
+
+    /// @brief Compute the triplets of the hessian for the collisions selected by ids.
+    template <typename CollisionIds>
+    void hessian_triplets(
+        const TCollisions& collisions,
+        const CollisionMesh& mesh,
+        Eigen::ConstRef<Eigen::MatrixXd> X,
+        const CollisionIds& collision_ids,
+        const PSDProjectionMethod project_hessian_to_psd,
+        TripletStorage& storage) const;
+
+    /// @brief Compute the hessian for the collisions selected by ids.
+    template <typename CollisionIds>
+    Eigen::SparseMatrix<double> hessian_impl(
+        const TCollisions& collisions,
+        const CollisionMesh& mesh,
+        Eigen::ConstRef<Eigen::MatrixXd> X,
+        const CollisionIds& collision_ids,
+        const PSDProjectionMethod project_hessian_to_psd) const;
+
+    /// @brief Thread-local accumulators of evaluate().
+    struct LocalEvaluation {
+        /// @brief Reset the accumulators (keeping their capacity).
+        void clear()
+        {
+            energy = 0;
+            hessian_triplets.clear();
+        }
+
+        double energy = 0;
+        std::vector<Eigen::Triplet<double>> hessian_triplets;
+    };
+
+    /// @brief Compute the requested quantities for the collisions selected by ids.
+    template <typename CollisionIds>
+    PotentialEvaluation evaluate_impl(
+        const TCollisions& collisions,
+        const CollisionMesh& mesh,
+        Eigen::ConstRef<Eigen::MatrixXd> X,
+        const CollisionIds& collision_ids,
+        const EvaluationFlags flags,
+        const PSDProjectionMethod project_hessian_to_psd) const;
+
+    /// @brief Persistent buffers reused across evaluations (optional).
+    std::shared_ptr<Workspace> m_workspace;
 };
 
 } // namespace ipc
@@ -17,63 +17,213 @@ double Potential<TCollisions>::operator()(
     const TCollisions& collisions,
     const CollisionMesh& mesh,
     Eigen::ConstRef<Eigen::MatrixXd> X) const
+{
+    return energy_impl(
+        collisions, mesh, X, AllCollisionIds { collisions.size() });
+}
+
+template <class TCollisions>
+Eigen::VectorXd Potential<TCollisions>::gradient(
+    const TCollisions& collisions,
+    const CollisionMesh& mesh,
+    Eigen::ConstRef<Eigen::MatrixXd> X) const
+{
+    return gradient_impl(
+        collisions, mesh, X, AllCollisionIds { collisions.size() });
+}
+
+template <class TCollisions>
+const Eigen::VectorXd& Potential<TCollisions>::gradient(
+    const TCollisions& collisions,
+    const CollisionMesh& mesh,
+    Eigen::ConstRef<Eigen::MatrixXd> X,
+    GradientScatter& scatter) const
+{
+    return gradient_impl(
+        collisions, mesh, X, AllCollisionIds { collisions.size() }, scatter);
+}
+
+template <class TCollisions>
+Eigen::SparseMatrix<double> Potential<TCollisions>::hessian(
+    const TCollisions& collisions,
+    const CollisionMesh& mesh,
+    Eigen::ConstRef<Eigen::MatrixXd> X,
+    const PSDProjectionMethod project_hessian_to_psd) const
+{
+    return hessian_impl(
+        collisions, mesh, X, AllCollisionIds { collisions.size() },
+        project_hessian_to_psd);
+}
+
+template <class TCollisions>
+const Eigen::SparseMatrix<double>& Potential<TCollisions>::hessian(
+    const TCollisions& collisions,
+    const CollisionMesh& mesh,
+    Eigen::ConstRef<Eigen::MatrixXd> X,
+    HessianPattern& pattern,
+    const PSDProjectionMethod project_hessian_to_psd) const
 {
     assert(X.rows() == mesh.num_vertices());
 
-    return tbb::parallel_reduce(
-        tbb::blocked_range<size_t>(size_t(0), collisions.size()), 0.0,
-        [&](const tbb::blocked_range<size_t>& r, double partial_sum) {
+    const Eigen::MatrixXi& edges = mesh.edges();
+    const Eigen::MatrixXi& faces = mesh.faces();
+
+    const std::vector<std::array<long, 4>> stencils =
+        collision_stencils(collisions, mesh);
+
+    if (!pattern.is_built_for(stencils, X.cols(), X.size())) {
+        pattern.build(stencils, X.cols(), X.size());
+    }
+
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(size_t(0), collisions.size()),
+        [&](const tbb::blocked_range<size_t>& r) {
             for (size_t i = r.begin(); i < r.end(); i++) {
-                // Quadrature weight is premultiplied by local potential
-                partial_sum += (*this)(
-                    collisions[i],
-                    collisions[i].dof(X, mesh.edges(), mesh.faces()));
+                const TCollision& collision = collisions[i];
+
+                // Each collision writes to its own buffer
+                pattern.local_hessian(i) = this->hessian(
+                    collision, collision.dof(X, edges, faces),
+                    project_hessian_to_psd);
             }
-            return partial_sum;
-        },
-        [](double a, double b) { return a + b; });
+        });
+
+    return pattern.assemble();
 }
 
 template <class TCollisions>
-Eigen::VectorXd Potential<TCollisions>::gradient(
+BlockSparseMatrix Potential<TCollisions>::hessian_bsr(
     const TCollisions& collisions,
     const CollisionMesh& mesh,
-    Eigen::ConstRef<Eigen::MatrixXd> X) const
+    Eigen::ConstRef<Eigen::MatrixXd> X,
+    const PSDProjectionMethod project_hessian_to_psd) const
+{
+    assert(X.rows() == mesh.num_vertices());
+
+    TripletStorage local_storage;
+    TripletStorage& storage =
+        thread_local_storage(m_workspace.get(), local_storage);
+
+    hessian_triplets(
+        collisions, mesh, X, AllCollisionIds { collisions.size() },
+        project_hessian_to_psd, storage);
+
+    BlockSparseMatrix hess(X.size(), X.size(), X.cols());
+    hess.set_from_triplets(storage);
+    return hess;
+}
+
+template <class TCollisions>
+Eigen::VectorXd Potential<TCollisions>::hessian_vector_product(
+    const TCollisions& collisions,
+    const CollisionMesh& mesh,
+    Eigen::ConstRef<Eigen::MatrixXd> X,
+    Eigen::ConstRef<Eigen::VectorXd> p,
+    const PSDProjectionMethod project_hessian_to_psd) const
 {
     assert(X.rows() == mesh.num_vertices());
+    assert(p.size() == X.size());
 
     if (collisions.empty()) {
         return Eigen::VectorXd::Zero(X.size());
     }
 
+    const Eigen::MatrixXi& edges = mesh.edges();
+    const Eigen::MatrixXi& faces = mesh.faces();
+
     const int dim = X.cols();
 
-    tbb::combinable<Eigen::VectorXd> grad(Eigen::VectorXd::Zero(X.size()));
+    const std::vector<std::array<long, 4>> stencils =
+        collision_stencils(collisions, mesh);
+
+    GradientScatter local_scatter;
+    GradientScatter& scatter =
+        m_workspace ? m_workspace->get<GradientScatter>() : local_scatter;
+    if (!scatter.is_built_for(stencils, dim, X.size())) {
+        scatter.build(stencils, dim, X.size());
+    }
 
     tbb::parallel_for(
         tbb::blocked_range<size_t>(size_t(0), collisions.size()),
         [&](const tbb::blocked_range<size_t>& r) {
+            VectorMax12d local_p;
             for (size_t i = r.begin(); i < r.end(); i++) {
                 const TCollision& collision = collisions[i];
 
-                const VectorMax12d local_grad = this->gradient(
-                    collision, collision.dof(X, mesh.edges(), mesh.faces()));
+                const MatrixMax12d local_hess = this->hessian(
+                    collision, collision.dof(X, edges, faces),
+                    project_hessian_to_psd);
 
-                const std::array<long, 4> vids =
-                    collision.vertex_ids(mesh.edges(), mesh.faces());
+                // Gather the stencil's entries of p
+                local_p.resize(local_hess.rows());
+                for (int v = 0; v < local_hess.rows() / dim; v++) {
+                    local_p.segment(dim * v, dim) =
+                        p.segment(dim * stencils[i][v], dim);
+                }
 
-                local_gradient_to_global_gradient(
-                    local_grad, vids, dim, grad.local());
+                // Each collision writes to its own buffer
+                scatter.local_gradient(i).noalias() = local_hess * local_p;
             }
         });
 
-    return grad.combine([](const Eigen::VectorXd& a, const Eigen::VectorXd& b) {
-        return a + b;
-    });
+    return scatter.assemble();
 }
 
 template <class TCollisions>
-Eigen::SparseMatrix<double> Potential<TCollisions>::hessian(
+HessianOperator Potential<TCollisions>::hessian_operator(
+    const TCollisions& collisions,
+    const CollisionMesh& mesh,
+    Eigen::ConstRef<Eigen::MatrixXd> X,
+    const PSDProjectionMethod project_hessian_to_psd) const
+{
+    assert(X.rows() == mesh.num_vertices());
+
+    const Eigen::MatrixXi& edges = mesh.edges();
+    const Eigen::MatrixXi& faces = mesh.faces();
+
+    const std::vector<std::array<long, 4>> stencils =
+        collision_stencils(collisions, mesh);
+
+    HessianOperator hess;
+    hess.build(stencils, X.cols(), X.size());
+
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(size_t(0), collisions.size()),
+        [&](const tbb::blocked_range<size_t>& r) {
+            for (size_t i = r.begin(); i < r.end(); i++) {
+                const TCollision& collision = collisions[i];
+
+                // Each collision writes to its own buffer
+                hess.local_hessian(i) = this->hessian(
+                    collision, collision.dof(X, edges, faces),
+                    project_hessian_to_psd);
+            }
+        });
+
+    return hess;
+}
+
+template <class TCollisions>
+Eigen::VectorXd Potential<TCollisions>::hessian_diagonal(
+    const TCollisions& collisions,
+    const CollisionMesh& mesh,
+    Eigen::ConstRef<Eigen::MatrixXd> X,
+    const PSDProjectionMethod project_hessian_to_psd) const
+{
+    const int dim = X.cols();
+
+    const Eigen::MatrixXd blocks =
+        hessian_block_diagonal(collisions, mesh, X, project_hessian_to_psd);
+
+    Eigen::VectorXd diag(X.size());
+    for (int i = 0; i < X.size(); i++) {
+        diag[i] = blocks(i, i % dim);
+    }
+    return diag;
+}
+
+template <class TCollisions>
+Eigen::MatrixXd Potential<TCollisions>::hessian_block_diagonal(
     const TCollisions& collisions,
     const CollisionMesh& mesh,
     Eigen::ConstRef<Eigen::MatrixXd> X,
@@ -81,29 +231,269 @@ Eigen::SparseMatrix<double> Potential<TCollisions>::hessian(
 {
     assert(X.rows() == mesh.num_vertices());
 
+    const int dim = X.cols();
+    const int block_size = dim * dim;
+
     if (collisions.empty()) {
-        return Eigen::SparseMatrix<double>(X.size(), X.size());
+        return Eigen::MatrixXd::Zero(X.size(), dim);
     }
 
     const Eigen::MatrixXi& edges = mesh.edges();
     const Eigen::MatrixXi& faces = mesh.faces();
 
-    const int dim = X.cols();
-    const int ndof = X.size();
+    const std::vector<std::array<long, 4>> stencils =
+        collision_stencils(collisions, mesh);
 
-    tbb::enumerable_thread_specific<std::vector<Eigen::Triplet<double>>>
-        storage;
+    // The dim×dim blocks are gathered like vectors of size dim².
+    GradientScatter local_scatter;
+    GradientScatter& scatter = m_workspace
+        ? m_workspace->get<GradientScatter>(/*id=*/1)
+        : local_scatter;
+    if (!scatter.is_built_for(stencils, block_size, block_size * X.rows())) {
+        scatter.build(stencils, block_size, block_size * X.rows());
+    }
 
     tbb::parallel_for(
         tbb::blocked_range<size_t>(size_t(0), collisions.size()),
+        [&](const tbb::blocked_range<size_t>& r) {
+            for (size_t i = r.begin(); i < r.end(); i++) {
+                const TCollision& collision = collisions[i];
+
+                const MatrixMax12d local_hess = this->hessian(
+                    collision, collision.dof(X, edges, faces),
+                    project_hessian_to_psd);
+
+                // Only the diagonal blocks are kept
+                Eigen::Map<Eigen::VectorXd> local_blocks =
+                    scatter.local_gradient(i);
+                for (int v = 0; v < local_blocks.size() / block_size; v++) {
+                    Eigen::Map<Eigen::MatrixXd>(
+                        local_blocks.data() + block_size * v, dim, dim) =
+                        local_hess.block(dim * v, dim * v, dim, dim);
+                }
+            }
+        });
+
+    const Eigen::VectorXd& block_values = scatter.assemble();
+
+    Eigen::MatrixXd blocks(X.size(), dim);
+    for (int vi = 0; vi < X.rows(); vi++) {
+        blocks.middleRows(dim * vi, dim) = Eigen::Map<const Eigen::MatrixXd>(
+            block_values.data() + block_size * vi, dim, dim);
+    }
+    return blocks;
+}
+
+template <class TCollisions>
+PotentialEvaluation Potential<TCollisions>::evaluate(
+    const TCollisions& collisions,
+    const CollisionMesh& mesh,
+    Eigen::ConstRef<Eigen::MatrixXd> X,
+    const EvaluationFlags flags,
+    const PSDProjectionMethod project_hessian_to_psd) const
+{
+    return evaluate_impl(
+        collisions, mesh, X, AllCollisionIds { collisions.size() }, flags,
+        project_hessian_to_psd);
+}
+
+// -- Restricted cumulative methods --------------------------------------------
+
+template <class TCollisions>
+double Potential<TCollisions>::operator()(
+    const TCollisions& collisions,
+    const CollisionMesh& mesh,
+    Eigen::ConstRef<Eigen::MatrixXd> X,
+    const std::vector<size_t>& collision_ids) const
+{
+    return energy_impl(collisions, mesh, X, collision_ids);
+}
+
+template <class TCollisions>
+Eigen::VectorXd Potential<TCollisions>::gradient(
+    const TCollisions& collisions,
+    const CollisionMesh& mesh,
+    Eigen::ConstRef<Eigen::MatrixXd> X,
+    const std::vector<size_t>& collision_ids) const
+{
+    return gradient_impl(collisions, mesh, X, collision_ids);
+}
+
+template <class TCollisions>
+Eigen::SparseMatrix<double> Potential<TCollisions>::hessian(
+    const TCollisions& collisions,
+    const CollisionMesh& mesh,
+    Eigen::ConstRef<Eigen::MatrixXd> X,
+    const std::vector<size_t>& collision_ids,
+    const PSDProjectionMethod project_hessian_to_psd) const
+{
+    return hessian_impl(
+        collisions, mesh, X, collision_ids, project_hessian_to_psd);
+}
+
+template <class TCollisions>
+PotentialEvaluation Potential<TCollisions>::evaluate(
+    const TCollisions& collisions,
+    const CollisionMesh& mesh,
+    Eigen::ConstRef<Eigen::MatrixXd> X,
+    const std::vector<size_t>& collision_ids,
+    const EvaluationFlags flags,
+    const PSDProjectionMethod project_hessian_to_psd) const
+{
+    return evaluate_impl(
+        collisions, mesh, X, collision_ids, flags, project_hessian_to_psd);
+}
+
+// -- Single collision methods -------------------------------------------------
+
+template <class TCollisions>
+void Potential<TCollisions>::evaluate(
+    const TCollision& collision,
+    Eigen::ConstRef<VectorMax12d> x,
+    const EvaluationFlags flags,
+    double& energy,
+    VectorMax12d& grad,
+    MatrixMax12d& hess,
+    const PSDProjectionMethod project_hessian_to_psd) const
+{
+    if (has_flag(flags, EvaluationFlags::ENERGY)) {
+        energy = (*this)(collision, x);
+    }
+    if (has_flag(flags, EvaluationFlags::GRADIENT)) {
+        grad = this->gradient(collision, x);
+    }
+    if (has_flag(flags, EvaluationFlags::HESSIAN)) {
+        hess = this->hessian(collision, x, project_hessian_to_psd);
+    }
+}
+
+// -- Implementations ----------------------------------------------------------
+
+template <class TCollisions>
+template <typename CollisionIds>
+std::vector<std::array<long, 4>> Potential<TCollisions>::collision_stencils(
+    const TCollisions& collisions,
+    const CollisionMesh& mesh,
+    const CollisionIds& collision_ids) const
+{
+    std::vector<std::array<long, 4>> stencils(collision_ids.size());
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(size_t(0), collision_ids.size()),
+        [&](const tbb::blocked_range<size_t>& r) {
+            for (size_t i = r.begin(); i < r.end(); i++) {
+                stencils[i] = collisions[collision_ids[i]].vertex_ids(
+                    mesh.edges(), mesh.faces());
+            }
+        });
+    return stencils;
+}
+
+template <class TCollisions>
+template <typename CollisionIds>
+double Potential<TCollisions>::energy_impl(
+    const TCollisions& collisions,
+    const CollisionMesh& mesh,
+    Eigen::ConstRef<Eigen::MatrixXd> X,
+    const CollisionIds& collision_ids) const
+{
+    assert(X.rows() == mesh.num_vertices());
+
+    return tbb::parallel_reduce(
+        tbb::blocked_range<size_t>(size_t(0), collision_ids.size()), 0.0,
+        [&](const tbb::blocked_range<size_t>& r, double partial_sum) {
+            for (size_t i = r.begin(); i < r.end(); i++) {
+                const TCollision& collision = collisions[collision_ids[i]];
+
+                // Quadrature weight is premultiplied by local potential
+                partial_sum += (*this)(
+                    collision, collision.dof(X, mesh.edges(), mesh.faces()));
+            }
+            return partial_sum;
+        },
+        [](double a, double b) { return a + b; });
+}
+
+template <class TCollisions>
+template <typename CollisionIds>
+Eigen::VectorXd Potential<TCollisions>::gradient_impl(
+    const TCollisions& collisions,
+    const CollisionMesh& mesh,
+    Eigen::ConstRef<Eigen::MatrixXd> X,
+    const CollisionIds& collision_ids) const
+{
+    assert(X.rows() == mesh.num_vertices());
+
+    if (collision_ids.size() == 0) {
+        return Eigen::VectorXd::Zero(X.size());
+    }
+
+    GradientScatter local_scatter;
+    GradientScatter& scatter =
+        m_workspace ? m_workspace->get<GradientScatter>() : local_scatter;
+    return gradient_impl(collisions, mesh, X, collision_ids, scatter);
+}
+
+template <class TCollisions>
+template <typename CollisionIds>
+const Eigen::VectorXd& Potential<TCollisions>::gradient_impl(
+    const TCollisions& collisions,
+    const CollisionMesh& mesh,
+    Eigen::ConstRef<Eigen::MatrixXd> X,
+    const CollisionIds& collision_ids,
+    GradientScatter& scatter) const
+{
+    assert(X.rows() == mesh.num_vertices());
+
+    const Eigen::MatrixXi& edges = mesh.edges();
+    const Eigen::MatrixXi& faces = mesh.faces();
+
+    const std::vector<std::array<long, 4>> stencils =
+        collision_stencils(collisions, mesh, collision_ids);
+
+    if (!scatter.is_built_for(stencils, X.cols(), X.size())) {
+        scatter.build(stencils, X.cols(), X.size());
+    }
+
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(size_t(0), collision_ids.size()),
+        [&](const tbb::blocked_range<size_t>& r) {
+            for (size_t i = r.begin(); i < r.end(); i++) {
+                const TCollision& collision = collisions[collision_ids[i]];
+
+                // Each collision writes to its own buffer
+                scatter.local_gradient(i) =
+                    this->gradient(collision, collision.dof(X, edges, faces));
+            }
+        });
+
+    return scatter.assemble();
+}
+
+template <class TCollisions>
+template <typename CollisionIds>
+void Potential<TCollisions>::hessian_triplets(
+    const TCollisions& collisions,
+    const CollisionMesh& mesh,
+    Eigen::ConstRef<Eigen::MatrixXd> X,
+    const CollisionIds& collision_ids,
+    const PSDProjectionMethod project_hessian_to_psd,
+    TripletStorage& storage) const
+{
+    const Eigen::MatrixXi& edges = mesh.edges();
+    const Eigen::MatrixXi& faces = mesh.faces();
+
+    const int dim = X.cols();
+
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(size_t(0), collision_ids.size()),
         [&](const tbb::blocked_range<size_t>& r) {
             auto& hess_triplets = storage.local();
 
             for (size_t i = r.begin(); i < r.end(); i++) {
-                const TCollision& collision = collisions[i];
+                const TCollision& collision = collisions[collision_ids[i]];
 
                 const MatrixMax12d local_hess = this->hessian(
-                    collisions[i], collisions[i].dof(X, edges, faces),
+                    collision, collision.dof(X, edges, faces),
                     project_hessian_to_psd);
 
                 const std::array<long, 4> vids =
@@ -113,15 +503,40 @@ Eigen::SparseMatrix<double> Potential<TCollisions>::hessian(
                     local_hess, vids, dim, hess_triplets);
             }
         });
+}
+
+template <class TCollisions>
+template <typename CollisionIds>
+Eigen::SparseMatrix<double> Potential<TCollisions>::hessian_impl(
+    const TCollisions& collisions,
+    const CollisionMesh& mesh,
+    Eigen::ConstRef<Eigen::MatrixXd> X,
+    const CollisionIds& collision_ids,
+    const PSDProjectionMethod project_hessian_to_psd) const
+{
+    assert(X.rows() == mesh.num_vertices());
+
+    if (collision_ids.size() == 0) {
+        return Eigen::SparseMatrix<double>(X.size(), X.size());
+    }
+
+    const int ndof = X.size();
+
+    TripletStorage local_storage;
+    TripletStorage& storage =
+        thread_local_storage(m_workspace.get(), local_storage);
+
+    hessian_triplets(
+        collisions, mesh, X, collision_ids, project_hessian_to_psd, storage);
 
     // Combine the local hessians
     tbb::combinable<Eigen::SparseMatrix<double>> hess(
         Eigen::SparseMatrix<double>(ndof, ndof));
 
     tbb::parallel_for(
-        tbb::blocked_range<decltype(storage)::iterator>(
+        tbb::blocked_range<TripletStorage::iterator>(
             storage.begin(), storage.end()),
-        [&](const tbb::blocked_range<decltype(storage)::iterator>& r) {
+        [&](const tbb::blocked_range<TripletStorage::iterator>& r) {
             for (auto it = r.begin(); it != r.end(); ++it) {
                 Eigen::SparseMatrix<double> local_hess(ndof, ndof);
                 local_hess.setFromTriplets(it->begin(), it->end());
@@ -134,4 +549,120 @@ Eigen::SparseMatrix<double> Potential<TCollisions>::hessian(
            const Eigen::SparseMatrix<double>& b) { return a + b; });
 }
 
-} // namespace ipc
\ No newline at end of file
+template <class TCollisions>
+template <typename CollisionIds>
+PotentialEvaluation Potential<TCollisions>::evaluate_impl(
+    const TCollisions& collisions,
+    const CollisionMesh& mesh,
+    Eigen::ConstRef<Eigen::MatrixXd> X,
+    const CollisionIds& collision_ids,
+    const EvaluationFlags flags,
+    const PSDProjectionMethod project_hessian_to_psd) const
+{
+    assert(X.rows() == mesh.num_vertices());
+
+    const bool compute_energy = has_flag(flags, EvaluationFlags::ENERGY);
+    const bool compute_grad = has_flag(flags, EvaluationFlags::GRADIENT);
+    const bool compute_hess = has_flag(flags, EvaluationFlags::HESSIAN);
+
+    const Eigen::MatrixXi& edges = mesh.edges();
+    const Eigen::MatrixXi& faces = mesh.faces();
+
+    const int dim = X.cols();
+    const int ndof = X.size();
+
+    PotentialEvaluation result;
+    if (compute_grad) {
+        result.gradient.setZero(ndof);
+    }
+    if (compute_hess) {
+        result.hessian.resize(ndof, ndof);
+    }
+    if (collision_ids.size() == 0 || flags == EvaluationFlags::NONE) {
+        return result;
+    }
+
+    using LocalStorage = tbb::enumerable_thread_specific<LocalEvaluation>;
+    LocalStorage local_storage;
+    LocalStorage& storage =
+        thread_local_storage(m_workspace.get(), local_storage);
+
+    // The local gradients are gathered by vertex (see gradient_impl()).
+    GradientScatter local_scatter;
+    GradientScatter& scatter =
+        m_workspace ? m_workspace->get<GradientScatter>() : local_scatter;
+    if (compute_grad) {
+        const std::vector<std::array<long, 4>> stencils =
+            collision_stencils(collisions, mesh, collision_ids);
+        if (!scatter.is_built_for(stencils, dim, ndof)) {
+            scatter.build(stencils, dim, ndof);
+        }
+    }
+
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(size_t(0), collision_ids.size()),
+        [&](const tbb::blocked_range<size_t>& r) {
+            LocalEvaluation& local = storage.local();
+
+            double local_energy;
+            VectorMax12d local_grad;
+            MatrixMax12d local_hess;
+            for (size_t i = r.begin(); i < r.end(); i++) {
+                const TCollision& collision = collisions[collision_ids[i]];
+
+                this->evaluate(
+                    collision, collision.dof(X, edges, faces), flags,
+                    local_energy, local_grad, local_hess,
+                    project_hessian_to_psd);
+
+                if (compute_energy) {
+                    local.energy += local_energy;
+                }
+
+                if (compute_grad) {
+                    // Each collision writes to its own buffer
+                    scatter.local_gradient(i) = local_grad;
+                }
+                if (compute_hess) {
+                    local_hessian_to_global_triplets(
+                        local_hess, collision.vertex_ids(edges, faces), dim,
+                        local.hessian_triplets);
+                }
+            }
+        });
+
+    for (const LocalEvaluation& local : storage) {
+        result.energy += local.energy;
+    }
+    if (compute_grad) {
+        result.gradient = scatter.assemble();
+    }
+
+    if (compute_hess) {
+        // Combine the local hessians
+        tbb::combinable<Eigen::SparseMatrix<double>> hess(
+            Eigen::SparseMatrix<double>(ndof, ndof));
+
+        tbb::parallel_for(
+            tbb::blocked_range<typename LocalStorage::iterator>(
+                storage.begin(), storage.end()),
+            [&](const tbb::blocked_range<typename LocalStorage::iterator>&
+                    r) {
+                for (auto it = r.begin(); it != r.end(); ++it) {
+                    Eigen::SparseMatrix<double> local_hess(ndof, ndof);
+                    local_hess.setFromTriplets(
+                        it->hessian_triplets.begin(),
+                        it->hessian_triplets.end());
+                    hess.local() += local_hess;
+                }
+            });
+
+        result.hessian = hess.combine(
+            [](const Eigen::SparseMatrix<double>& a,
+               const Eigen::SparseMatrix<double>& b) { return a + b; });
+    }
+
+    return result;
+}
+
+} // namespace ipc
@@ -19,36 +19,52 @@ Eigen::VectorXd TangentialPotential::force(
         return Eigen::VectorXd::Zero(velocities.size());
     }
 
-    const int dim = velocities.cols();
+    GradientScatter local_scatter;
+    GradientScatter& scatter =
+        m_workspace ? m_workspace->get<GradientScatter>() : local_scatter;
+    return force(
+        collisions, mesh, rest_positions, lagged_displacements, velocities,
+        normal_potential, normal_stiffness, scatter, dmin, no_mu);
+}
+
+const Eigen::VectorXd& TangentialPotential::force(
+    const TangentialCollisions& collisions,
+    const CollisionMesh& mesh,
+    Eigen::ConstRef<Eigen::MatrixXd> rest_positions,
+    Eigen::ConstRef<Eigen::MatrixXd> lagged_displacements,
+    Eigen::ConstRef<Eigen::MatrixXd> velocities,
+    const NormalPotential& normal_potential,
+    const double normal_stiffness,
+    GradientScatter& scatter,
+    const double dmin,
+    const bool no_mu) const
+{
     const Eigen::MatrixXi& edges = mesh.edges();
     const Eigen::MatrixXi& faces = mesh.faces();
 
-    tbb::combinable<Eigen::VectorXd> storage(
-        Eigen::VectorXd::Zero(velocities.size()));
+    const std::vector<std::array<long, 4>> stencils =
+        collision_stencils(collisions, mesh);
+
+    if (!scatter.is_built_for(stencils, velocities.cols(), velocities.size())) {
+        scatter.build(stencils, velocities.cols(), velocities.size());
+    }
 
     tbb::parallel_for(
         tbb::blocked_range<size_t>(size_t(0), collisions.size()),
         [&](const tbb::blocked_range<size_t>& r) {
-            Eigen::VectorXd& global_force = storage.local();
             for (size_t i = r.begin(); i < r.end(); i++) {
                 const auto& collision = collisions[i];
 
-                const VectorMax12d local_force = force(
+                // Each collision writes to its own buffer
+                scatter.local_gradient(i) = force(
                     collision, collision.dof(rest_positions, edges, faces),
                     collision.dof(lagged_displacements, edges, faces),
                     collision.dof(velocities, edges, faces), //
                     normal_potential, normal_stiffness, dmin, no_mu);
-
-                const std::array<long, 4> vis =
-                    collision.vertex_ids(mesh.edges(), mesh.faces());
-
-                local_gradient_to_global_gradient(
-                    local_force, vis, dim, global_force);
             }
         });
 
-    return storage.combine([](const Eigen::VectorXd& a,
-                              const Eigen::VectorXd& b) { return a + b; });
+    return scatter.assemble();
 }
 
 Eigen::SparseMatrix<double> TangentialPotential::force_jacobian(
@@ -67,13 +83,85 @@ Eigen::SparseMatrix<double> TangentialPotential::force_jacobian(
             velocities.size(), velocities.size());
     }
 
+    TripletStorage local_storage;
+    TripletStorage& storage =
+        thread_local_storage(m_workspace.get(), local_storage);
+
+    force_jacobian_triplets(
+        collisions, mesh, rest_positions, lagged_displacements, velocities,
+        normal_potential, normal_stiffness, wrt, dmin, storage);
+
+    Eigen::SparseMatrix<double> jacobian(velocities.size(), velocities.size());
+    for (const auto& local_jac_triplets : storage) {
+        Eigen::SparseMatrix<double> local_jacobian(
+            velocities.size(), velocities.size());
+        local_jacobian.setFromTriplets(
+            local_jac_triplets.begin(), local_jac_triplets.end());
+        jacobian += local_jacobian;
+    }
+    return jacobian;
+}
+
+BlockSparseMatrix TangentialPotential::force_jacobian_bsr(
+    const TangentialCollisions& collisions,
+    const CollisionMesh& mesh,
+    Eigen::ConstRef<Eigen::MatrixXd> rest_positions,
+    Eigen::ConstRef<Eigen::MatrixXd> lagged_displacements,
+    Eigen::ConstRef<Eigen::MatrixXd> velocities,
+    const NormalPotential& normal_potential,
+    const double normal_stiffness,
+    const DiffWRT wrt,
+    const double dmin) const
+{
+    BlockSparseMatrix jacobian(
+        velocities.size(), velocities.size(), velocities.cols());
+    if (collisions.empty()) {
+        return jacobian;
+    }
+
+    TripletStorage local_storage;
+    TripletStorage& storage =
+        thread_local_storage(m_workspace.get(), local_storage);
+
+    force_jacobian_triplets(
+        collisions, mesh, rest_positions, lagged_displacements, velocities,
+        normal_potential, normal_stiffness, wrt, dmin, storage);
+
+    jacobian.set_from_triplets(storage);
+    return jacobian;
+}
+
+void TangentialPotential::force_jacobian_triplets(
+    const TangentialCollisions& collisions,
+    const CollisionMesh& mesh,
+    Eigen::ConstRef<Eigen::MatrixXd> rest_positions,
+    Eigen::ConstRef<Eigen::MatrixXd> lagged_displacements,
+    Eigen::ConstRef<Eigen::MatrixXd> velocities,
+    const NormalPotential& normal_potential,
+    const double normal_stiffness,
+    const DiffWRT wrt,
+    const double dmin,
+    TripletStorage& storage) const
+{
+    // if wrt == X then also compute ∇ₓ w(x)
+    const bool diff_weights = wrt == DiffWRT::REST_POSITIONS;
+    if (diff_weights) {
+        assert(collisions.weight_gradients.size() == collisions.size());
+        assert(
+            collisions.weight_gradients.ndof()
+            == size_t(rest_positions.size()));
+        if (collisions.weight_gradients.size() != collisions.size()
+            || collisions.weight_gradients.ndof()
+                != size_t(rest_positions.size())) {
+            throw std::runtime_error(
+                "Shape derivative is not computed for friction collision!");
+        }
+    }
+
     const int dim = velocities.cols();
     Eigen::ConstRef<Eigen::MatrixXi> edges = mesh.edges();
     Eigen::ConstRef<Eigen::MatrixXi> faces = mesh.faces();
 
-    tbb::enumerable_thread_specific<std::vector<Eigen::Triplet<double>>>
-        storage;
-
     tbb::parallel_for(
         tbb::blocked_range<size_t>(size_t(0), collisions.size()),
         [&](const tbb::blocked_range<size_t>& r) {
@@ -82,99 +170,70 @@ Eigen::SparseMatrix<double> TangentialPotential::force_jacobian(
             for (size_t i = r.begin(); i < r.end(); i++) {
                 const TangentialCollision& collision = collisions[i];
 
+                const VectorMax12d x =
+                    collision.dof(rest_positions, edges, faces);
+                const VectorMax12d u =
+                    collision.dof(lagged_displacements, edges, faces);
+                const VectorMax12d v = collision.dof(velocities, edges, faces);
+
                 const MatrixMax12d local_force_jacobian = force_jacobian(
-                    collision, collision.dof(rest_positions, edges, faces),
-                    collision.dof(lagged_displacements, edges, faces),
-                    collision.dof(velocities, edges, faces), //
-                    normal_potential, normal_stiffness, wrt, dmin);
+                    collision, x, u, v, normal_potential, normal_stiffness,
+                    wrt, dmin);
 
                 const std::array<long, 4> vis =
                     collision.vertex_ids(mesh.edges(), mesh.faces());
 
                 local_hessian_to_global_triplets(
                     local_force_jacobian, vis, dim, jac_triplets);
-            }
-        });
 
-    Eigen::SparseMatrix<double> jacobian(velocities.size(), velocities.size());
-    for (const auto& local_jac_triplets : storage) {
-        Eigen::SparseMatrix<double> local_jacobian(
-            velocities.size(), velocities.size());
-        local_jacobian.setFromTriplets(
-            local_jac_triplets.begin(), local_jac_triplets.end());
-        jacobian += local_jacobian;
-    }
+                if (!diff_weights) {
+                    continue;
+                }
 
-    // if wrt == X then compute ∇ₓ w(x)
-    if (wrt == DiffWRT::REST_POSITIONS) {
-        for (int i = 0; i < collisions.size(); i++) {
-            const TangentialCollision& collision = collisions[i];
-            assert(collision.weight_gradient.size() == rest_positions.size());
-            if (collision.weight_gradient.size() != rest_positions.size()) {
-                throw std::runtime_error(
-                    "Shape derivative is not computed for friction collision!");
+                // (F / w) ⊗ ∇ₓ w
+                VectorMax12d local_force = force(
+                    collision, x, u, v, normal_potential, normal_stiffness,
+                    dmin);
+                assert(collision.weight != 0);
+                local_force /= collision.weight;
+
+                const auto wg_indices = collisions.weight_gradients.indices(i);
+                const auto wg_values = collisions.weight_gradients.values(i);
+                for (int k = 0; k < local_force.size(); k++) {
+                    const int row = dim * vis[k / dim] + k % dim;
+                    for (int j = 0; j < wg_indices.size(); j++) {
+                        jac_triplets.emplace_back(
+                            row, wg_indices[j], local_force[k] * wg_values[j]);
+                    }
+                }
             }
-
-            VectorMax12d local_force = force(
-                collision, collision.dof(rest_positions, edges, faces),
-                collision.dof(lagged_displacements, edges, faces),
-                collision.dof(velocities, edges, faces), //
-                normal_potential, normal_stiffness, dmin);
-            assert(collision.weight != 0);
-            local_force /= collision.weight;
-
-            Eigen::SparseVector<double> force(rest_positions.size());
-            force.reserve(local_force.size());
-            local_gradient_to_global_gradient(
-                local_force, collision.vertex_ids(edges, faces), dim, force);
-
-            jacobian += force * collision.weight_gradient.transpose();
-        }
-    }
-
-    return jacobian;
+        });
 }
+
 // -- Single collision methods -------------------------------------------------
 
 double TangentialPotential::operator()(
     const TangentialCollision& collision,
     Eigen::ConstRef<VectorMax12d> velocities) const
 {
-    // μ N(xᵗ) f₀(‖u‖) (where u = T(xᵗ)ᵀv)
-
-    // Compute u = PᵀΓv
-    const VectorMax2d u = collision.tangent_basis.transpose()
-        * collision.relative_velocity(velocities);
-
-    return collision.weight * collision.mu * collision.normal_force_magnitude
-        * f0(u.norm());
+    double energy;
+    VectorMax12d grad;
+    MatrixMax12d hess;
+    evaluate(
+        collision, velocities, EvaluationFlags::ENERGY, energy, grad, hess);
+    return energy;
 }
 
 VectorMax12d TangentialPotential::gradient(
     const TangentialCollision& collision,
     Eigen::ConstRef<VectorMax12d> velocities) const
 {
-    // ∇ₓ μ N(xᵗ) f₀(‖u‖) (where u = T(xᵗ)ᵀv)
-    //  = μ N(xᵗ) f₁(‖u‖)/‖u‖ T(xᵗ) u
-
-    // Compute u = PᵀΓv
-    const VectorMax2d u = collision.tangent_basis.transpose()
-        * collision.relative_velocity(velocities);
-
-    // Compute T = ΓᵀP
-    const MatrixMax<double, 12, 2> T =
-        collision.relative_velocity_matrix().transpose()
-        * collision.tangent_basis;
-
-    // Compute f₁(‖u‖)/‖u‖
-    const double f1_over_norm_u = f1_over_x(u.norm());
-
-    // μ N(xᵗ) f₁(‖u‖)/‖u‖ T(xᵗ) u ∈ ℝⁿ
-    // (n×2)(2×1) = (n×1)
-    return T
-        * ((collision.weight * collision.mu * collision.normal_force_magnitude
-            * f1_over_norm_u)
-           * u);
+    double energy;
+    VectorMax12d grad;
+    MatrixMax12d hess;
+    evaluate(
+        collision, velocities, EvaluationFlags::GRADIENT, energy, grad, hess);
+    return grad;
 }
 
 MatrixMax12d TangentialPotential::hessian(
@@ -182,30 +241,68 @@ MatrixMax12d TangentialPotential::hessian(
     Eigen::ConstRef<VectorMax12d> velocities,
     const PSDProjectionMethod project_hessian_to_psd) const
 {
-    // ∇ₓ μ N(xᵗ) f₁(‖u‖)/‖u‖ T(xᵗ) u (where u = T(xᵗ)ᵀ v)
-    //  = μ N T [(f₂(‖u‖)‖u‖ − f₁(‖u‖))/‖u‖³ uuᵀ + f₁(‖u‖)/‖u‖ I] Tᵀ
-    //  = μ N T [f₂(‖u‖) uuᵀ + f₁(‖u‖)/‖u‖ I] Tᵀ
+    double energy;
+    VectorMax12d grad;
+    MatrixMax12d hess;
+    evaluate(
+        collision, velocities, EvaluationFlags::HESSIAN, energy, grad, hess,
+        project_hessian_to_psd);
+    return hess;
+}
 
+void TangentialPotential::evaluate(
+    const TangentialCollision& collision,
+    Eigen::ConstRef<VectorMax12d> velocities,
+    const EvaluationFlags flags,
+    double& energy,
+    VectorMax12d& grad,
+    MatrixMax12d& hess,
+    const PSDProjectionMethod project_hessian_to_psd) const
+{
     // Compute u = PᵀΓv
     const VectorMax2d u = collision.tangent_basis.transpose()
         * collision.relative_velocity(velocities);
 
+    // Compute ‖u‖
+    const double norm_u = u.norm();
+
+    // Compute μ N(xᵗ)
+    const double scale =
+        collision.weight * collision.mu * collision.normal_force_magnitude;
+
+    if (has_flag(flags, EvaluationFlags::ENERGY)) {
+        // μ N(xᵗ) f₀(‖u‖) (where u = T(xᵗ)ᵀv)
+        energy = scale * f0(norm_u);
+    }
+
+    const bool compute_grad = has_flag(flags, EvaluationFlags::GRADIENT);
+    const bool compute_hess = has_flag(flags, EvaluationFlags::HESSIAN);
+    if (!compute_grad && !compute_hess) {
+        return;
+    }
+
     // Compute T = ΓᵀP
     const MatrixMax<double, 12, 2> T =
         collision.relative_velocity_matrix().transpose()
         * collision.tangent_basis;
 
-    // Compute ‖u‖
-    const double norm_u = u.norm();
-
     // Compute f₁(‖u‖)/‖u‖
     const double f1_over_norm_u = f1_over_x(norm_u);
 
-    // Compute μ N(xᵗ)
-    const double scale =
-        collision.weight * collision.mu * collision.normal_force_magnitude;
+    if (compute_grad) {
+        // ∇ₓ μ N(xᵗ) f₀(‖u‖) (where u = T(xᵗ)ᵀv)
+        //  = μ N(xᵗ) f₁(‖u‖)/‖u‖ T(xᵗ) u ∈ ℝⁿ
+        // (n×2)(2×1) = (n×1)
+        grad = T * ((scale * f1_over_norm_u) * u);
+    }
 
-    MatrixMax12d hess;
+    if (!compute_hess) {
+        return;
+    }
+
+    // ∇ₓ μ N(xᵗ) f₁(‖u‖)/‖u‖ T(xᵗ) u (where u = T(xᵗ)ᵀ v)
+    //  = μ N T [(f₂(‖u‖)‖u‖ − f₁(‖u‖))/‖u‖³ uuᵀ + f₁(‖u‖)/‖u‖ I] Tᵀ
+    //  = μ N T [f₂(‖u‖) uuᵀ + f₁(‖u‖)/‖u‖ I] Tᵀ
     if (is_dynamic(norm_u)) {
         // f₁(‖u‖) = 1 ⟹ f₂(‖u‖) = 0
         //  ⟹ ∇²D(v) = μ N T [-f₁(‖u‖)/‖u‖³ uuᵀ + f₁(‖u‖)/‖u‖ I] Tᵀ
@@ -246,8 +343,6 @@ MatrixMax12d TangentialPotential::hessian(
 
         hess = T * inner_hess * T.transpose();
     }
-
-    return hess;
 }
 
 VectorMax12d TangentialPotential::force(
@@ -339,16 +434,16 @@ MatrixMax12d TangentialPotential::force_jacobian(
     const bool need_jac_N_or_T = wrt != DiffWRT::VELOCITIES;
 
     // Compute N
-    const double N = normal_potential.force_magnitude(
-        collision.compute_distance(lagged_positions), dmin, normal_stiffness);
+    const double d = collision.compute_distance(lagged_positions);
+    const double N =
+        normal_potential.force_magnitude(d, dmin, normal_stiffness);
 
     // Compute ∇N
     VectorMax12d grad_N;
     if (need_jac_N_or_T) {
         // ∇ₓN = ∇ᵤN
         grad_N = normal_potential.force_magnitude_gradient(
-            collision.compute_distance(lagged_positions),
-            collision.compute_distance_gradient(lagged_positions), dmin,
+            d, collision.compute_distance_gradient(lagged_positions), dmin,
             normal_stiffness);
         assert(grad_N.array().isFinite().all());
     }
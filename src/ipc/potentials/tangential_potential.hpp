@@ -19,6 +19,7 @@ public:
     using Super::operator();
     using Super::gradient;
     using Super::hessian;
+    using Super::evaluate;
 
     /// @brief Variable to differentiate the friction force with respect to.
     enum class DiffWRT {
@@ -28,6 +29,7 @@ public:
     };
 
     /// @brief Compute the friction force from the given velocities.
+    /// @note The local forces are gathered with a GradientScatter, which is kept in the workspace (if any) and reused while the collisions' stencils do not change.
     /// @param collisions The set of collisions.
     /// @param mesh The collision mesh.
     /// @param rest_positions Rest positions of the vertices (rowwise).
@@ -49,6 +51,35 @@ public:
         const double dmin = 0,
         const bool no_mu = false) const;
 
+    /// @brief Compute the friction force with a given scatter.
+    ///
+    /// The local forces are written to the scatter's per-collision buffers
+    /// and gathered by vertex (see GradientScatter). The scatter is only
+    /// rebuilt if the collisions' stencils changed since it was built.
+    ///
+    /// @param collisions The set of collisions.
+    /// @param mesh The collision mesh.
+    /// @param rest_positions Rest positions of the vertices (rowwise).
+    /// @param lagged_displacements Previous displacements of the vertices (rowwise).
+    /// @param velocities Current displacements of the vertices (rowwise).
+    /// @param normal_potential Normal potential (used for normal force magnitude).
+    /// @param normal_stiffness Normal stiffness (used for normal force magnitude).
+    /// @param scatter The scatter to reuse (rebuilt if needed).
+    /// @param dmin Minimum distance (used for normal force magnitude).
+    /// @param no_mu whether to not multiply by mu
+    /// @return The friction force stored in the scatter (valid until the scatter is reused).
+    const Eigen::VectorXd& force(
+        const TangentialCollisions& collisions,
+        const CollisionMesh& mesh,
+        Eigen::ConstRef<Eigen::MatrixXd> rest_positions,
+        Eigen::ConstRef<Eigen::MatrixXd> lagged_displacements,
+        Eigen::ConstRef<Eigen::MatrixXd> velocities,
+        const NormalPotential& normal_potential,
+        const double normal_stiffness,
+        GradientScatter& scatter,
+        const double dmin = 0,
+        const bool no_mu = false) const;
+
     /// @brief Compute the Jacobian of the friction force wrt the velocities.
     /// @param collisions The set of collisions.
     /// @param mesh The collision mesh.
@@ -71,6 +102,28 @@ public:
         const DiffWRT wrt,
         const double dmin = 0) const;
 
+    /// @brief Compute the Jacobian of the friction force in block compressed sparse row (BSR) format.
+    /// @param collisions The set of collisions.
+    /// @param mesh The collision mesh.
+    /// @param rest_positions Rest positions of the vertices (rowwise).
+    /// @param lagged_displacements Previous displacements of the vertices (rowwise).
+    /// @param velocities Current displacements of the vertices (rowwise).
+    /// @param normal_potential Normal potential (used for normal force magnitude).
+    /// @param normal_stiffness Normal stiffness (used for normal force magnitude).
+    /// @param wrt The variable to take the derivative with respect to.
+    /// @param dmin Minimum distance (used for normal force magnitude).
+    /// @return The Jacobian of the friction force made of dim×dim blocks.
+    BlockSparseMatrix force_jacobian_bsr(
+        const TangentialCollisions& collisions,
+        const CollisionMesh& mesh,
+        Eigen::ConstRef<Eigen::MatrixXd> rest_positions,
+        Eigen::ConstRef<Eigen::MatrixXd> lagged_displacements,
+        Eigen::ConstRef<Eigen::MatrixXd> velocities,
+        const NormalPotential& normal_potential,
+        const double normal_stiffness,
+        const DiffWRT wrt,
+        const double dmin = 0) const;
+
     // -- Single collision methods ---------------------------------------------
 
     /// @brief Compute the potential for a single collision.
@@ -99,6 +152,25 @@ public:
         const PSDProjectionMethod project_hessian_to_psd =
             PSDProjectionMethod::NONE) const override;
 
+    /// @brief Compute any subset of the potential, its gradient, and its hessian for a single collision.
+    /// @note The tangential velocity and tangent space are shared between the requested outputs.
+    /// @param[in] collision The collision.
+    /// @param[in] velocities The collision stencil's velocities.
+    /// @param[in] flags The quantities to compute.
+    /// @param[out] energy The potential (only set if requested).
+    /// @param[out] grad The gradient of the potential (only set if requested).
+    /// @param[out] hess The hessian of the potential (only set if requested).
+    /// @param[in] project_hessian_to_psd Make sure the hessian is positive semi-definite.
+    void evaluate(
+        const TangentialCollision& collision,
+        Eigen::ConstRef<VectorMax12d> velocities,
+        const EvaluationFlags flags,
+        double& energy,
+        VectorMax12d& grad,
+        MatrixMax12d& hess,
+        const PSDProjectionMethod project_hessian_to_psd =
+            PSDProjectionMethod::NONE) const override;
+
     /// @brief Compute the friction force.
     /// @param collision The collision
     /// @param rest_positions Rest positions of the vertices (rowwise).
@@ -140,6 +212,21 @@ public:
         const double dmin = 0) const;
 
 protected:
+    /// @brief Compute the triplets of the Jacobian of the friction force.
+    /// @param[in,out] storage Store the triplets of the Jacobian here.
+    /// @see force_jacobian for the other parameters.
+    void force_jacobian_triplets(
+        const TangentialCollisions& collisions,
+        const CollisionMesh& mesh,
+        Eigen::ConstRef<Eigen::MatrixXd> rest_positions,
+        Eigen::ConstRef<Eigen::MatrixXd> lagged_displacements,
+        Eigen::ConstRef<Eigen::MatrixXd> velocities,
+        const NormalPotential& normal_potential,
+        const double normal_stiffness,
+        const DiffWRT wrt,
+        const double dmin,
+        TripletStorage& storage) const;
+
     virtual double f0(const double x) const = 0;
     virtual double f1_over_x(const double x) const = 0;
     virtual double f2_x_minus_f1_over_x3(const double x) const = 0;
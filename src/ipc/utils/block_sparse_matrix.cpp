@@ -0,0 +1,220 @@
+#include "block_sparse_matrix.hpp"
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+
+namespace ipc {
+
+BlockSparseMatrix::BlockSparseMatrix(
+    const int rows, const int cols, const int block_size)
+    : m_block_size(block_size)
+    , m_block_cols(cols / block_size)
+    , m_row_offsets(rows / block_size + 1, 0)
+{
+    assert(block_size > 0);
+    assert(rows % block_size == 0 && cols % block_size == 0);
+}
+
+void BlockSparseMatrix::set_from_triplets(
+    const std::vector<Eigen::Triplet<double>>& triplets)
+{
+    set_from_triplets(
+        std::vector<const std::vector<Eigen::Triplet<double>>*> { &triplets });
+}
+
+void BlockSparseMatrix::set_from_triplets(
+    const tbb::enumerable_thread_specific<std::vector<Eigen::Triplet<double>>>&
+        triplets)
+{
+    std::vector<const std::vector<Eigen::Triplet<double>>*> pointers;
+    for (const auto& local_triplets : triplets) {
+        pointers.push_back(&local_triplets);
+    }
+    set_from_triplets(pointers);
+}
+
+void BlockSparseMatrix::set_from_triplets(
+    const std::vector<const std::vector<Eigen::Triplet<double>>*>& triplets)
+{
+    const int bs = m_block_size;
+    const int n_block_rows = block_rows();
+
+    // Bucket the entries by block row (counting sort)
+    struct Entry {
+        int block_col;
+        int local; // Row-major index inside the block
+        double value;
+    };
+
+    std::vector<size_t> bucket_offsets(n_block_rows + 1, 0);
+    for (const auto* local_triplets : triplets) {
+        for (const Eigen::Triplet<double>& t : *local_triplets) {
+            assert(t.row() >= 0 && t.row() < rows());
+            assert(t.col() >= 0 && t.col() < cols());
+            bucket_offsets[t.row() / bs + 1]++;
+        }
+    }
+    for (int i = 0; i < n_block_rows; i++) {
+        bucket_offsets[i + 1] += bucket_offsets[i];
+    }
+
+    std::vector<Entry> entries(bucket_offsets.back());
+    {
+        std::vector<size_t> next(
+            bucket_offsets.begin(), bucket_offsets.end() - 1);
+        for (const auto* local_triplets : triplets) {
+            for (const Eigen::Triplet<double>& t : *local_triplets) {
+                entries[next[t.row() / bs]++] = {
+                    t.col() / bs, (t.row() % bs) * bs + t.col() % bs, t.value()
+                };
+            }
+        }
+    }
+
+    // Find the distinct block columns of each block row. A dense marker per
+    // thread maps block columns to blocks, which avoids sorting the entries.
+    tbb::enumerable_thread_specific<std::vector<int>> markers;
+    std::vector<std::vector<int>> row_cols(n_block_rows);
+    tbb::parallel_for(
+        tbb::blocked_range<int>(0, n_block_rows),
+        [&](const tbb::blocked_range<int>& r) {
+            std::vector<int>& marker = markers.local();
+            marker.resize(m_block_cols, -1);
+            for (int i = r.begin(); i < r.end(); i++) {
+                std::vector<int>& cols = row_cols[i];
+                for (size_t e = bucket_offsets[i]; e < bucket_offsets[i + 1];
+                     e++) {
+                    if (marker[entries[e].block_col] != i) {
+                        marker[entries[e].block_col] = i;
+                        cols.push_back(entries[e].block_col);
+                    }
+                }
+                std::sort(cols.begin(), cols.end());
+            }
+        });
+
+    m_row_offsets.resize(n_block_rows + 1);
+    m_row_offsets[0] = 0;
+    for (int i = 0; i < n_block_rows; i++) {
+        m_row_offsets[i + 1] = m_row_offsets[i] + int(row_cols[i].size());
+    }
+
+    // Accumulate the entries into the blocks (in their original order)
+    m_col_indices.resize(m_row_offsets.back());
+    m_values.assign(size_t(m_row_offsets.back()) * bs * bs, 0.0);
+    tbb::parallel_for(
+        tbb::blocked_range<int>(0, n_block_rows),
+        [&](const tbb::blocked_range<int>& r) {
+            std::vector<int>& marker = markers.local();
+            marker.resize(m_block_cols);
+            for (int i = r.begin(); i < r.end(); i++) {
+                for (size_t j = 0; j < row_cols[i].size(); j++) {
+                    const int k = m_row_offsets[i] + int(j);
+                    m_col_indices[k] = row_cols[i][j];
+                    marker[row_cols[i][j]] = k;
+                }
+                for (size_t e = bucket_offsets[i]; e < bucket_offsets[i + 1];
+                     e++) {
+                    const size_t k = marker[entries[e].block_col];
+                    m_values[k * bs * bs + entries[e].local] += entries[e].value;
+                }
+            }
+        });
+}
+
+namespace {
+    /// @brief Multiply a block row by a vector (y_i += Σ_k A_k x_{j_k}).
+    /// @tparam BS Block size known at compile time (or Eigen::Dynamic).
+    template <int BS>
+    void block_row_product(
+        const int bs,
+        const double* values,
+        const int* col_indices,
+        const int begin,
+        const int end,
+        const double* x,
+        double* y)
+    {
+        using Block = Eigen::Matrix<double, BS, BS, Eigen::RowMajor>;
+        using Vector = Eigen::Matrix<double, BS, 1>;
+        Eigen::Map<Vector> yi(y, bs);
+        for (int k = begin; k < end; k++) {
+            yi.noalias() += Eigen::Map<const Block>(
+                                values + size_t(k) * bs * bs, bs, bs)
+                * Eigen::Map<const Vector>(x + bs * col_indices[k], bs);
+        }
+    }
+} // namespace
+
+Eigen::VectorXd
+BlockSparseMatrix::operator*(Eigen::ConstRef<Eigen::VectorXd> x) const
+{
+    assert(x.size() == cols());
+    const int bs = m_block_size;
+
+    // Contact blocks are 2×2 or 3×3, so use fixed-size kernels for them.
+    const auto product = bs == 3 ? block_row_product<3>
+        : bs == 2                ? block_row_product<2>
+                                 : block_row_product<Eigen::Dynamic>;
+
+    Eigen::VectorXd y = Eigen::VectorXd::Zero(rows());
+    // Each block row is owned by one task, so no two tasks write the same
+    // entry.
+    tbb::parallel_for(
+        tbb::blocked_range<int>(0, block_rows()),
+        [&](const tbb::blocked_range<int>& r) {
+            for (int i = r.begin(); i < r.end(); i++) {
+                product(
+                    bs, m_values.data(), m_col_indices.data(),
+                    m_row_offsets[i], m_row_offsets[i + 1], x.data(),
+                    y.data() + bs * i);
+            }
+        });
+    return y;
+}
+
+Eigen::SparseMatrix<double, Eigen::RowMajor> BlockSparseMatrix::to_csr() const
+{
+    using StorageIndex =
+        Eigen::SparseMatrix<double, Eigen::RowMajor>::StorageIndex;
+    const int bs = m_block_size;
+
+    Eigen::SparseMatrix<double, Eigen::RowMajor> csr(rows(), cols());
+    csr.resizeNonZeros(m_values.size());
+    StorageIndex* outer = csr.outerIndexPtr();
+    StorageIndex* inner = csr.innerIndexPtr();
+    double* values = csr.valuePtr();
+
+    outer[0] = 0;
+    for (int i = 0; i < block_rows(); i++) {
+        const int n = m_row_offsets[i + 1] - m_row_offsets[i];
+        for (int l = 0; l < bs; l++) {
+            outer[bs * i + l + 1] = outer[bs * i + l] + StorageIndex(bs * n);
+        }
+    }
+
+    tbb::parallel_for(
+        tbb::blocked_range<int>(0, block_rows()),
+        [&](const tbb::blocked_range<int>& r) {
+            for (int i = r.begin(); i < r.end(); i++) {
+                for (int k = m_row_offsets[i]; k < m_row_offsets[i + 1]; k++) {
+                    const int offset = bs * (k - m_row_offsets[i]);
+                    for (int l = 0; l < bs; l++) {
+                        const StorageIndex start = outer[bs * i + l] + offset;
+                        for (int c = 0; c < bs; c++) {
+                            inner[start + c] =
+                                StorageIndex(bs * m_col_indices[k] + c);
+                            values[start + c] =
+                                m_values[size_t(k) * bs * bs + l * bs + c];
+                        }
+                    }
+                }
+            }
+        });
+
+    return csr;
+}
+
+} // namespace ipc
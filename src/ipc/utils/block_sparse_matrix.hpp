@@ -0,0 +1,119 @@
+#pragma once
+
+#include <ipc/utils/eigen_ext.hpp>
+
+#include <tbb/enumerable_thread_specific.h>
+
+#include <vector>
+
+namespace ipc {
+
+/// @brief A sparse matrix of dense square blocks in block compressed sparse row (BSR) format.
+///
+/// Contact Hessians and Jacobians consist of dense dim×dim vertex blocks, so
+/// storing one column index per block (instead of one per entry) reduces the
+/// index storage and allows blocked matrix-vector products. Blocks are stored
+/// consecutively in row-major order (i.e., like SciPy's bsr_matrix).
+class BlockSparseMatrix {
+public:
+    /// @brief A writable view of a block.
+    using BlockMap = Eigen::Map<
+        Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>;
+    /// @brief A read-only view of a block.
+    using ConstBlockMap = Eigen::Map<const Eigen::Matrix<
+        double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>;
+
+    BlockSparseMatrix() = default;
+
+    /// @brief Construct an empty (i.e., all zero) matrix.
+    /// @param rows Number of rows (a multiple of block_size).
+    /// @param cols Number of columns (a multiple of block_size).
+    /// @param block_size Number of rows and columns of each block.
+    BlockSparseMatrix(const int rows, const int cols, const int block_size);
+
+    /// @brief Set the entries from triplets (duplicates are summed).
+    /// @param triplets Triplets of entries (which must lie inside the matrix).
+    void set_from_triplets(const std::vector<Eigen::Triplet<double>>& triplets);
+
+    /// @brief Set the entries from thread-local triplets (duplicates are summed).
+    /// @param triplets Thread-local triplets of entries (which must lie inside the matrix).
+    void set_from_triplets(
+        const tbb::enumerable_thread_specific<
+            std::vector<Eigen::Triplet<double>>>& triplets);
+
+    /// @brief Get the number of rows.
+    int rows() const { return m_block_size * block_rows(); }
+
+    /// @brief Get the number of columns.
+    int cols() const { return m_block_size * m_block_cols; }
+
+    /// @brief Get the number of rows and columns of each block.
+    int block_size() const { return m_block_size; }
+
+    /// @brief Get the number of block rows.
+    int block_rows() const { return int(m_row_offsets.size()) - 1; }
+
+    /// @brief Get the number of block columns.
+    int block_cols() const { return m_block_cols; }
+
+    /// @brief Get the number of stored blocks.
+    size_t num_blocks() const { return m_col_indices.size(); }
+
+    /// @brief Get the start of each block row in the blocks (followed by the number of blocks).
+    const std::vector<int>& row_offsets() const { return m_row_offsets; }
+
+    /// @brief Get the block column of each block (sorted within each block row).
+    const std::vector<int>& col_indices() const { return m_col_indices; }
+
+    /// @brief Get the entries of the blocks (each block is row-major).
+    const std::vector<double>& values() const { return m_values; }
+
+    /// @brief Get a block.
+    /// @param k Index of the block.
+    /// @return A read-only view of the block.
+    ConstBlockMap block(const size_t k) const
+    {
+        assert(k < num_blocks());
+        const size_t n = m_block_size * m_block_size;
+        return ConstBlockMap(
+            m_values.data() + k * n, m_block_size, m_block_size);
+    }
+
+    /// @brief Get a block.
+    /// @param k Index of the block.
+    /// @return A writable view of the block.
+    BlockMap block(const size_t k)
+    {
+        assert(k < num_blocks());
+        const size_t n = m_block_size * m_block_size;
+        return BlockMap(m_values.data() + k * n, m_block_size, m_block_size);
+    }
+
+    /// @brief Multiply the matrix by a vector.
+    /// @param x Vector of size cols().
+    /// @return The product of size rows().
+    Eigen::VectorXd operator*(Eigen::ConstRef<Eigen::VectorXd> x) const;
+
+    /// @brief Convert to an Eigen compressed sparse row (CSR) matrix.
+    /// @note Zeros inside stored blocks are kept as explicit entries.
+    Eigen::SparseMatrix<double, Eigen::RowMajor> to_csr() const;
+
+protected:
+    /// @brief Set the entries from several vectors of triplets.
+    void set_from_triplets(
+        const std::vector<const std::vector<Eigen::Triplet<double>>*>&
+            triplets);
+
+    /// @brief Number of rows and columns of each block.
+    int m_block_size = 1;
+    /// @brief Number of block columns.
+    int m_block_cols = 0;
+    /// @brief Start of each block row in the blocks.
+    std::vector<int> m_row_offsets = { 0 };
+    /// @brief Block column of each block.
+    std::vector<int> m_col_indices;
+    /// @brief Entries of the blocks.
+    std::vector<double> m_values;
+};
+
+} // namespace ipc
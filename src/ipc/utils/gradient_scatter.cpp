@@ -0,0 +1,111 @@
+#include "gradient_scatter.hpp"
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+
+namespace ipc {
+
+void GradientScatter::build(
+    const std::vector<std::array<long, 4>>& stencils,
+    const int dim,
+    const int ndof)
+{
+    assert(dim > 0 && ndof % dim == 0);
+    const int num_vertices = ndof / dim;
+
+    m_stencils = stencils;
+    m_dim = dim;
+
+    // Allocate a buffer for each stencil's local gradient
+    m_local_offsets.resize(stencils.size() + 1);
+    m_local_offsets[0] = 0;
+    for (size_t i = 0; i < stencils.size(); i++) {
+        int n_verts = 0;
+        while (n_verts < int(stencils[i].size())
+               && stencils[i][n_verts] >= 0) {
+            n_verts++;
+        }
+        m_local_offsets[i + 1] = m_local_offsets[i] + dim * n_verts;
+    }
+    m_local_values.resize(m_local_offsets.back());
+
+    // Group the local dim-vectors by vertex (counting sort). The stencil order
+    // is kept within each vertex, which makes the summation order
+    // deterministic.
+    m_vertex_offsets.assign(num_vertices + 1, 0);
+    for (size_t i = 0; i < stencils.size(); i++) {
+        const size_t n = m_local_offsets[i + 1] - m_local_offsets[i];
+        for (size_t vi = 0; vi < n / dim; vi++) {
+            assert(stencils[i][vi] < num_vertices);
+            m_vertex_offsets[stencils[i][vi] + 1]++;
+        }
+    }
+    for (int v = 0; v < num_vertices; v++) {
+        m_vertex_offsets[v + 1] += m_vertex_offsets[v];
+    }
+
+    m_contributions.resize(m_vertex_offsets.back());
+    std::vector<size_t> next(
+        m_vertex_offsets.begin(), m_vertex_offsets.end() - 1);
+    for (size_t i = 0; i < stencils.size(); i++) {
+        const size_t n = m_local_offsets[i + 1] - m_local_offsets[i];
+        for (size_t vi = 0; vi < n / dim; vi++) {
+            m_contributions[next[stencils[i][vi]]++] =
+                m_local_offsets[i] + dim * vi;
+        }
+    }
+
+    m_vector.setZero(ndof);
+}
+
+bool GradientScatter::is_built_for(
+    const std::vector<std::array<long, 4>>& stencils,
+    const int dim,
+    const int ndof) const
+{
+    return m_dim == dim && m_vector.size() == ndof && m_stencils == stencils;
+}
+
+void GradientScatter::clear()
+{
+    m_stencils.clear();
+    m_dim = 0;
+    m_local_offsets.clear();
+    m_local_values.clear();
+    m_vertex_offsets.clear();
+    m_contributions.clear();
+    m_vector.resize(0);
+}
+
+const Eigen::VectorXd& GradientScatter::assemble()
+{
+    if (m_vertex_offsets.empty()) {
+        return m_vector; // Not built
+    }
+
+    const int dim = m_dim;
+
+    // Each vertex is owned by one task, so no two tasks write the same entry.
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(size_t(0), m_vertex_offsets.size() - 1),
+        [&](const tbb::blocked_range<size_t>& r) {
+            for (size_t v = r.begin(); v < r.end(); v++) {
+                double* out = m_vector.data() + dim * v;
+                std::fill_n(out, dim, 0.0);
+                for (size_t c = m_vertex_offsets[v];
+                     c < m_vertex_offsets[v + 1]; c++) {
+                    const double* local =
+                        m_local_values.data() + m_contributions[c];
+                    for (int k = 0; k < dim; k++) {
+                        out[k] += local[k];
+                    }
+                }
+            }
+        });
+
+    return m_vector;
+}
+
+} // namespace ipc
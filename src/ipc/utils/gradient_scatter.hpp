@@ -0,0 +1,94 @@
+#pragma once
+
+#include <Eigen/Core>
+
+#include <array>
+#include <vector>
+
+namespace ipc {
+
+/// @brief Reusable scatter for assembling a gradient from local stencil gradients without per-thread global vectors.
+///
+/// Each stencil writes its local gradient into its own slot of a flat buffer
+/// (in parallel without races). The slots are then gathered by a segmented
+/// reduction keyed on vertex id: the contributions to each vertex are stored
+/// contiguously, so every vertex's entries are summed by a single task and no
+/// two tasks write the same entry. Scratch memory is proportional to the
+/// number of stencils and degrees of freedom instead of the number of threads
+/// times the number of degrees of freedom, and the summation order (and
+/// hence the result) does not depend on the scheduling.
+class GradientScatter {
+public:
+    GradientScatter() = default;
+
+    /// @brief Build the scatter.
+    /// @param stencils Vertex ids of each stencil (padded with -1).
+    /// @param dim Dimension of the vertices.
+    /// @param ndof Number of entries of the gradient.
+    void build(
+        const std::vector<std::array<long, 4>>& stencils,
+        const int dim,
+        const int ndof);
+
+    /// @brief Determine if the scatter was built for the given stencils.
+    /// @param stencils Vertex ids of each stencil (padded with -1).
+    /// @param dim Dimension of the vertices.
+    /// @param ndof Number of entries of the gradient.
+    /// @return True if the scatter can be reused for the stencils.
+    bool is_built_for(
+        const std::vector<std::array<long, 4>>& stencils,
+        const int dim,
+        const int ndof) const;
+
+    /// @brief Remove the scatter.
+    void clear();
+
+    /// @brief Get the number of stencils.
+    size_t num_stencils() const { return m_stencils.size(); }
+
+    /// @brief Get the dimension of the vertices.
+    int dim() const { return m_dim; }
+
+    /// @brief Get the number of entries of the gradient.
+    Eigen::Index size() const { return m_vector.size(); }
+
+    /// @brief Get the buffer of a stencil's local gradient.
+    /// @note Buffers of distinct stencils do not overlap, so they can be written concurrently.
+    /// @param i Index of the stencil.
+    /// @return A writable view of the stencil's local gradient.
+    Eigen::Map<Eigen::VectorXd> local_gradient(const size_t i)
+    {
+        assert(i < num_stencils());
+        return Eigen::Map<Eigen::VectorXd>(
+            m_local_values.data() + m_local_offsets[i],
+            m_local_offsets[i + 1] - m_local_offsets[i]);
+    }
+
+    /// @brief Gather the local gradients into the global gradient.
+    /// @return The assembled gradient (valid until the next call to assemble() or build()).
+    const Eigen::VectorXd& assemble();
+
+    /// @brief Get the global gradient (as of the last call to assemble()).
+    const Eigen::VectorXd& vector() const { return m_vector; }
+
+protected:
+    /// @brief Vertex ids of the stencils the scatter was built for.
+    std::vector<std::array<long, 4>> m_stencils;
+    /// @brief Dimension of the vertices.
+    int m_dim = 0;
+
+    /// @brief Start of each stencil's local gradient in the local buffer (followed by the buffer size).
+    std::vector<size_t> m_local_offsets;
+    /// @brief Local gradients of all stencils.
+    std::vector<double> m_local_values;
+
+    /// @brief Start of each vertex's contributions in m_contributions.
+    std::vector<size_t> m_vertex_offsets;
+    /// @brief Start of each contributing local dim-vector in the local buffer (grouped by vertex).
+    std::vector<size_t> m_contributions;
+
+    /// @brief The global gradient.
+    Eigen::VectorXd m_vector;
+};
+
+} // namespace ipc
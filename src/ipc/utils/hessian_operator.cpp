@@ -0,0 +1,78 @@
+#include "hessian_operator.hpp"
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+namespace ipc {
+
+void HessianOperator::build(
+    const std::vector<std::array<long, 4>>& stencils,
+    const int dim,
+    const int ndof)
+{
+    assert(dim > 0 && ndof % dim == 0);
+
+    m_stencils = stencils;
+    m_dim = dim;
+    m_ndof = ndof;
+
+    // Allocate a buffer for each stencil's local Hessian
+    m_local_offsets.resize(stencils.size() + 1);
+    m_local_sizes.resize(stencils.size());
+    m_local_offsets[0] = 0;
+    for (size_t i = 0; i < stencils.size(); i++) {
+        int n_verts = 0;
+        while (n_verts < int(stencils[i].size())
+               && stencils[i][n_verts] >= 0) {
+            assert(stencils[i][n_verts] < ndof / dim);
+            n_verts++;
+        }
+        m_local_sizes[i] = dim * n_verts;
+        m_local_offsets[i + 1] =
+            m_local_offsets[i] + m_local_sizes[i] * m_local_sizes[i];
+    }
+    m_local_values.resize(m_local_offsets.back());
+
+    m_scatter.build(stencils, dim, ndof);
+}
+
+void HessianOperator::clear()
+{
+    m_stencils.clear();
+    m_dim = 0;
+    m_ndof = 0;
+    m_local_offsets.clear();
+    m_local_sizes.clear();
+    m_local_values.clear();
+    m_scatter.clear();
+}
+
+Eigen::VectorXd
+HessianOperator::operator*(Eigen::ConstRef<Eigen::VectorXd> p) const
+{
+    assert(p.size() == cols());
+
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(size_t(0), num_stencils()),
+        [&](const tbb::blocked_range<size_t>& r) {
+            VectorMax12d local_p;
+            for (size_t i = r.begin(); i < r.end(); i++) {
+                const std::array<long, 4>& vids = m_stencils[i];
+
+                // Gather the stencil's entries of p
+                local_p.resize(m_local_sizes[i]);
+                for (int v = 0; v < m_local_sizes[i] / m_dim; v++) {
+                    local_p.segment(m_dim * v, m_dim) =
+                        p.segment(m_dim * vids[v], m_dim);
+                }
+
+                // Each stencil writes to its own buffer
+                m_scatter.local_gradient(i).noalias() =
+                    local_hessian(i) * local_p;
+            }
+        });
+
+    return m_scatter.assemble();
+}
+
+} // namespace ipc
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <ipc/utils/eigen_ext.hpp>
+#include <ipc/utils/gradient_scatter.hpp>
+
+#include <array>
+#include <vector>
+
+namespace ipc {
+
+/// @brief Matrix-free Hessian stored as the local Hessians of the collision stencils.
+///
+/// Products with a vector apply each local Hessian to the stencil's entries
+/// of the vector, so the global sparse matrix is never assembled. Memory is
+/// proportional to the number of stencils instead of the number of nonzeros,
+/// and the local Hessians are computed once for any number of products (e.g.,
+/// the iterations of a conjugate gradient solve).
+class HessianOperator {
+public:
+    HessianOperator() = default;
+
+    /// @brief Allocate the local Hessians of the stencils.
+    /// @param stencils Vertex ids of each stencil (padded with -1).
+    /// @param dim Dimension of the vertices.
+    /// @param ndof Number of rows and columns of the Hessian.
+    void build(
+        const std::vector<std::array<long, 4>>& stencils,
+        const int dim,
+        const int ndof);
+
+    /// @brief Remove all stencils.
+    void clear();
+
+    /// @brief Get the number of stencils.
+    size_t num_stencils() const { return m_stencils.size(); }
+
+    /// @brief Get the dimension of the vertices.
+    int dim() const { return m_dim; }
+
+    /// @brief Get the number of rows.
+    int rows() const { return m_ndof; }
+
+    /// @brief Get the number of columns.
+    int cols() const { return m_ndof; }
+
+    /// @brief Get the vertex ids of a stencil.
+    /// @param i Index of the stencil.
+    /// @return The vertex ids of the stencil (padded with -1).
+    const std::array<long, 4>& stencil(const size_t i) const
+    {
+        assert(i < num_stencils());
+        return m_stencils[i];
+    }
+
+    /// @brief Get a stencil's local Hessian.
+    /// @note Buffers of distinct stencils do not overlap, so they can be written concurrently.
+    /// @param i Index of the stencil.
+    /// @return A writable view of the stencil's local Hessian.
+    Eigen::Map<Eigen::MatrixXd> local_hessian(const size_t i)
+    {
+        assert(i < num_stencils());
+        const Eigen::Index n = m_local_sizes[i];
+        return Eigen::Map<Eigen::MatrixXd>(
+            m_local_values.data() + m_local_offsets[i], n, n);
+    }
+
+    /// @brief Get a stencil's local Hessian.
+    /// @param i Index of the stencil.
+    /// @return A read-only view of the stencil's local Hessian.
+    Eigen::Map<const Eigen::MatrixXd> local_hessian(const size_t i) const
+    {
+        assert(i < num_stencils());
+        const Eigen::Index n = m_local_sizes[i];
+        return Eigen::Map<const Eigen::MatrixXd>(
+            m_local_values.data() + m_local_offsets[i], n, n);
+    }
+
+    /// @brief Multiply the Hessian by a vector.
+    /// @note The local products are gathered in buffers owned by the operator, so concurrent products with the same operator are not safe.
+    /// @param p Vector of size cols().
+    /// @return The product of size rows().
+    Eigen::VectorXd operator*(Eigen::ConstRef<Eigen::VectorXd> p) const;
+
+protected:
+    /// @brief Vertex ids of the stencils.
+    std::vector<std::array<long, 4>> m_stencils;
+    /// @brief Dimension of the vertices.
+    int m_dim = 0;
+    /// @brief Number of rows and columns of the Hessian.
+    int m_ndof = 0;
+
+    /// @brief Start of each stencil's local Hessian in the local buffer.
+    std::vector<size_t> m_local_offsets;
+    /// @brief Number of rows (and columns) of each stencil's local Hessian.
+    std::vector<int> m_local_sizes;
+    /// @brief Local Hessians of all stencils (column-major).
+    std::vector<double> m_local_values;
+
+    /// @brief Gathers the local products of the stencils (allocated once by build()).
+    mutable GradientScatter m_scatter;
+};
+
+} // namespace ipc
@@ -0,0 +1,175 @@
+#include "hessian_pattern.hpp"
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+
+#include <algorithm>
+#include <tuple>
+
+namespace ipc {
+
+void HessianPattern::build(
+    const std::vector<std::array<long, 4>>& stencils,
+    const int dim,
+    const int ndof)
+{
+    assert(dim > 0 && ndof % dim == 0);
+    const int num_vertices = ndof / dim;
+
+    m_stencils = stencils;
+    m_dim = dim;
+
+    // Allocate a buffer for each stencil's local Hessian
+    m_local_offsets.resize(stencils.size() + 1);
+    m_local_sizes.resize(stencils.size());
+    m_local_offsets[0] = 0;
+    for (size_t i = 0; i < stencils.size(); i++) {
+        int n_verts = 0;
+        while (n_verts < int(stencils[i].size())
+               && stencils[i][n_verts] >= 0) {
+            n_verts++;
+        }
+        m_local_sizes[i] = dim * n_verts;
+        m_local_offsets[i + 1] =
+            m_local_offsets[i] + m_local_sizes[i] * m_local_sizes[i];
+    }
+    m_local_values.resize(m_local_offsets.back());
+
+    // Collect the global position of every local dim×dim block
+    struct Entry {
+        int col; // Column vertex
+        int row; // Row vertex
+        Contribution contribution;
+    };
+    std::vector<Entry> entries;
+    for (size_t i = 0; i < stencils.size(); i++) {
+        const int n = m_local_sizes[i];
+        for (int vj = 0; vj < n / dim; vj++) {
+            for (int vi = 0; vi < n / dim; vi++) {
+                assert(stencils[i][vi] < num_vertices);
+                assert(stencils[i][vj] < num_vertices);
+                entries.push_back(
+                    { int(stencils[i][vj]),
+                      int(stencils[i][vi]),
+                      { m_local_offsets[i] + size_t(dim * vj * n + dim * vi),
+                        n } });
+            }
+        }
+    }
+
+    // Group the contributions by block (sorted by column then row vertex).
+    // Ties are broken by position to make the summation order deterministic.
+    tbb::parallel_sort(
+        entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+            return std::tie(a.col, a.row, a.contribution.start)
+                < std::tie(b.col, b.row, b.contribution.start);
+        });
+
+    m_block_col_offsets.assign(num_vertices + 1, 0);
+    m_block_rows.clear();
+    m_block_offsets.clear();
+    m_contributions.resize(entries.size());
+    for (size_t k = 0; k < entries.size(); k++) {
+        if (k == 0 || entries[k].col != entries[k - 1].col
+            || entries[k].row != entries[k - 1].row) {
+            m_block_rows.push_back(entries[k].row);
+            m_block_offsets.push_back(k);
+            m_block_col_offsets[entries[k].col + 1]++;
+        }
+        m_contributions[k] = entries[k].contribution;
+    }
+    m_block_offsets.push_back(entries.size());
+    for (int j = 0; j < num_vertices; j++) {
+        m_block_col_offsets[j + 1] += m_block_col_offsets[j];
+    }
+
+    // Expand the block pattern into the scalar pattern
+    using StorageIndex = Eigen::SparseMatrix<double>::StorageIndex;
+    m_matrix.resize(ndof, ndof);
+    m_matrix.resizeNonZeros(m_block_rows.size() * dim * dim);
+    StorageIndex* outer = m_matrix.outerIndexPtr();
+    StorageIndex* inner = m_matrix.innerIndexPtr();
+    outer[0] = 0;
+    for (int vj = 0; vj < num_vertices; vj++) {
+        const size_t begin = m_block_col_offsets[vj];
+        const size_t end = m_block_col_offsets[vj + 1];
+        for (int l = 0; l < dim; l++) {
+            const int col = dim * vj + l;
+            outer[col + 1] = outer[col] + StorageIndex(dim * (end - begin));
+            for (size_t p = begin; p < end; p++) {
+                for (int k = 0; k < dim; k++) {
+                    inner[outer[col] + dim * (p - begin) + k] =
+                        StorageIndex(dim * m_block_rows[p] + k);
+                }
+            }
+        }
+    }
+    std::fill_n(m_matrix.valuePtr(), m_matrix.nonZeros(), 0.0);
+}
+
+bool HessianPattern::is_built_for(
+    const std::vector<std::array<long, 4>>& stencils,
+    const int dim,
+    const int ndof) const
+{
+    return m_dim == dim && m_matrix.rows() == ndof && m_stencils == stencils;
+}
+
+void HessianPattern::clear()
+{
+    m_stencils.clear();
+    m_dim = 0;
+    m_local_offsets.clear();
+    m_local_sizes.clear();
+    m_local_values.clear();
+    m_block_col_offsets.clear();
+    m_block_rows.clear();
+    m_block_offsets.clear();
+    m_contributions.clear();
+    m_matrix = Eigen::SparseMatrix<double>();
+}
+
+const Eigen::SparseMatrix<double>& HessianPattern::assemble()
+{
+    if (m_block_col_offsets.empty()) {
+        return m_matrix; // Not built
+    }
+
+    const int dim = m_dim;
+    const auto* outer = m_matrix.outerIndexPtr();
+    double* values = m_matrix.valuePtr();
+
+    // Each vertex column is owned by one task, so no two tasks write the same
+    // value.
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(size_t(0), m_block_col_offsets.size() - 1),
+        [&](const tbb::blocked_range<size_t>& r) {
+            for (size_t vj = r.begin(); vj < r.end(); vj++) {
+                const size_t begin = m_block_col_offsets[vj];
+                for (size_t p = begin; p < m_block_col_offsets[vj + 1]; p++) {
+                    const size_t offset = dim * (p - begin);
+                    for (int l = 0; l < dim; l++) {
+                        std::fill_n(
+                            values + outer[dim * vj + l] + offset, dim, 0.0);
+                    }
+                    for (size_t c = m_block_offsets[p];
+                         c < m_block_offsets[p + 1]; c++) {
+                        const double* local =
+                            m_local_values.data() + m_contributions[c].start;
+                        const int stride = m_contributions[c].stride;
+                        for (int l = 0; l < dim; l++) {
+                            double* col = values + outer[dim * vj + l] + offset;
+                            for (int k = 0; k < dim; k++) {
+                                col[k] += local[l * stride + k];
+                            }
+                        }
+                    }
+                }
+            }
+        });
+
+    return m_matrix;
+}
+
+} // namespace ipc
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <Eigen/Core>
+#include <Eigen/SparseCore>
+
+#include <array>
+#include <vector>
+
+namespace ipc {
+
+/// @brief Reusable sparsity pattern for assembling a Hessian from local stencil Hessians.
+///
+/// The symbolic structure (the nonzero positions and the map from local
+/// entries to global entries) is computed once per set of stencils. Refreshing
+/// the numeric values then writes each stencil's local Hessian into its own
+/// slot of a flat buffer (in parallel without races) and gathers the slots
+/// into the matrix's values in O(nnz), avoiding triplet sorting and sparse
+/// matrix additions.
+///
+/// The pattern is stored at the level of dim×dim vertex blocks, so each
+/// column of a block is a contiguous run of dim values.
+class HessianPattern {
+public:
+    HessianPattern() = default;
+
+    /// @brief Build the pattern.
+    /// @param stencils Vertex ids of each stencil (padded with -1).
+    /// @param dim Dimension of the vertices.
+    /// @param ndof Number of rows and columns of the Hessian.
+    void build(
+        const std::vector<std::array<long, 4>>& stencils,
+        const int dim,
+        const int ndof);
+
+    /// @brief Determine if the pattern was built for the given stencils.
+    /// @param stencils Vertex ids of each stencil (padded with -1).
+    /// @param dim Dimension of the vertices.
+    /// @param ndof Number of rows and columns of the Hessian.
+    /// @return True if the pattern can be reused for the stencils.
+    bool is_built_for(
+        const std::vector<std::array<long, 4>>& stencils,
+        const int dim,
+        const int ndof) const;
+
+    /// @brief Remove the pattern.
+    void clear();
+
+    /// @brief Get the number of stencils.
+    size_t num_stencils() const { return m_stencils.size(); }
+
+    /// @brief Get the dimension of the vertices.
+    int dim() const { return m_dim; }
+
+    /// @brief Get the number of stored nonzeros.
+    Eigen::Index nonZeros() const { return m_matrix.nonZeros(); }
+
+    /// @brief Get the buffer of a stencil's local Hessian.
+    /// @note Buffers of distinct stencils do not overlap, so they can be written concurrently.
+    /// @param i Index of the stencil.
+    /// @return A writable view of the stencil's local Hessian.
+    Eigen::Map<Eigen::MatrixXd> local_hessian(const size_t i)
+    {
+        assert(i < num_stencils());
+        const Eigen::Index n = m_local_sizes[i];
+        return Eigen::Map<Eigen::MatrixXd>(
+            m_local_values.data() + m_local_offsets[i], n, n);
+    }
+
+    /// @brief Gather the local Hessians into the global Hessian.
+    /// @return The assembled Hessian (valid until the next call to assemble() or build()).
+    const Eigen::SparseMatrix<double>& assemble();
+
+    /// @brief Get the global Hessian (as of the last call to assemble()).
+    const Eigen::SparseMatrix<double>& matrix() const { return m_matrix; }
+
+protected:
+    /// @brief Vertex ids of the stencils the pattern was built for.
+    std::vector<std::array<long, 4>> m_stencils;
+    /// @brief Dimension of the vertices.
+    int m_dim = 0;
+
+    /// @brief Start of each stencil's local Hessian in the local buffer.
+    std::vector<size_t> m_local_offsets;
+    /// @brief Number of rows (and columns) of each stencil's local Hessian.
+    std::vector<int> m_local_sizes;
+    /// @brief Local Hessians of all stencils (column-major).
+    std::vector<double> m_local_values;
+
+    /// @brief Start of each vertex column's blocks in m_block_rows.
+    std::vector<size_t> m_block_col_offsets;
+    /// @brief Row vertex of each block (sorted within each vertex column).
+    std::vector<int> m_block_rows;
+    /// @brief Start of each block's contributions in m_contributions.
+    std::vector<size_t> m_block_offsets;
+
+    /// @brief A local dim×dim block contributing to a global block.
+    struct Contribution {
+        /// @brief Index of the block's first entry in the local buffer.
+        size_t start;
+        /// @brief Distance between the block's columns in the local buffer.
+        int stride;
+    };
+    /// @brief Local blocks contributing to each global block.
+    std::vector<Contribution> m_contributions;
+
+    /// @brief The global Hessian with a fixed pattern.
+    Eigen::SparseMatrix<double> m_matrix;
+};
+
+} // namespace ipc
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <tbb/enumerable_thread_specific.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <typeindex>
+#include <utility>
+
+namespace ipc {
+
+/// @brief Persistent scratch buffers that are reused across calls.
+///
+/// Passing the same workspace to successive calls (e.g., once per time step)
+/// lets temporary and thread-local buffers keep their capacity, so the steady
+/// state does not allocate. Buffers are created lazily on first use and are
+/// only released by clear() or when the workspace is destroyed.
+///
+/// @note A workspace may be shared by several objects, but it must not be
+/// used by two operations running at the same time.
+class Workspace {
+public:
+    Workspace() = default;
+
+    /// @brief Get a persistent object, constructing it on first use.
+    /// @tparam T Type of the object.
+    /// @param id Identifier to distinguish objects of the same type.
+    /// @param args Arguments used to construct the object on first use.
+    /// @return Reference to the persistent object.
+    template <typename T, typename... Args>
+    T& get(const int id = 0, Args&&... args)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::shared_ptr<void>& buffer =
+            m_buffers[std::make_pair(std::type_index(typeid(T)), id)];
+        if (!buffer) {
+            buffer = std::make_shared<T>(std::forward<Args>(args)...);
+        }
+        return *static_cast<T*>(buffer.get());
+    }
+
+    /// @brief Get persistent thread-local containers, each cleared but with its capacity retained.
+    /// @tparam Container Type of the thread-local containers (must provide clear()).
+    /// @param id Identifier to distinguish storages of the same type.
+    /// @param args Arguments used to construct the exemplar container on first use.
+    /// @return Reference to the persistent thread-local storage.
+    template <typename Container, typename... Args>
+    tbb::enumerable_thread_specific<Container>&
+    thread_local_storage(const int id = 0, Args&&... args)
+    {
+        auto& storage = get<tbb::enumerable_thread_specific<Container>>(
+            id, std::forward<Args>(args)...);
+        for (Container& container : storage) {
+            container.clear();
+        }
+        return storage;
+    }
+
+    /// @brief Number of persistent buffers.
+    size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_buffers.size();
+    }
+
+    /// @brief Release all buffers.
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_buffers.clear();
+    }
+
+private:
+    /// @brief Type-erased buffers keyed by their type and identifier.
+    std::map<std::pair<std::type_index, int>, std::shared_ptr<void>>
+        m_buffers;
+    mutable std::mutex m_mutex;
+};
+
+/// @brief Get thread-local containers from a workspace if given, otherwise use the fallback.
+/// @tparam Container Type of the thread-local containers (must provide clear()).
+/// @param workspace Workspace to get the storage from (may be null).
+/// @param fallback Storage to use when no workspace is given.
+/// @return Reference to the thread-local storage to use.
+template <typename Container>
+tbb::enumerable_thread_specific<Container>& thread_local_storage(
+    Workspace* workspace, tbb::enumerable_thread_specific<Container>& fallback)
+{
+    return workspace ? workspace->thread_local_storage<Container>()
+                     : fallback;
+}
+
+} // namespace ipc
@@ -73,4 +73,49 @@ TEST_CASE("Semi-implicit stiffness", "[stiffness]")
 
     REQUIRE(kappa.size() == 1);
     REQUIRE(kappa(0) == Catch::Approx(m / (d * d)));
-}
\ No newline at end of file
+}
+
+TEST_CASE("Semi-implicit stiffness from diagonal blocks", "[stiffness]")
+{
+    Eigen::MatrixXd vertices(4, 3);
+    Eigen::MatrixXi edges, faces(1, 3);
+
+    const double d = GENERATE(range(0.1, 1.0, 0.3));
+    vertices << 0, 0, 0, /**/ 1, 0, 0, /**/ 0, 1, 0, /**/ 0.333, 0.333, d;
+    faces << 0, 1, 2;
+    igl::edges(faces, edges);
+
+    const CollisionMesh mesh(vertices, edges, faces);
+
+    NormalCollisions collisions;
+    collisions.fv_collisions.emplace_back(0, 3);
+
+    const double m = 2.0;
+    const Eigen::VectorXd vertex_masses =
+        Eigen::VectorXd::Constant(vertices.rows(), m);
+
+    const double dmin = 0;
+
+    // A block-diagonal hessian (α I) gives the same result either way
+    const double alpha = GENERATE(0.0, 10.0);
+    Eigen::SparseMatrix<double> hess(vertices.size(), vertices.size());
+    hess.setIdentity();
+    hess *= alpha;
+
+    Eigen::MatrixXd hess_diagonal_blocks(vertices.size(), 3);
+    for (int i = 0; i < vertices.rows(); i++) {
+        hess_diagonal_blocks.middleRows(3 * i, 3) =
+            alpha * Eigen::Matrix3d::Identity();
+    }
+
+    const Eigen::VectorXd kappa = semi_implicit_stiffness(
+        mesh, vertices, collisions, vertex_masses, hess_diagonal_blocks,
+        dmin);
+
+    REQUIRE(kappa.size() == 1);
+    CHECK(kappa(0) == Catch::Approx(m / (d * d) + alpha));
+    CHECK(
+        kappa(0)
+        == Catch::Approx(semi_implicit_stiffness(
+            mesh, vertices, collisions, vertex_masses, hess, dmin)(0)));
+}
@@ -1,6 +1,10 @@
+#include <tests/utils.hpp>
+
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
 
 #include <ipc/candidates/candidates.hpp>
+#include <ipc/candidates/compact_candidates.hpp>
 #include <ipc/candidates/edge_face.hpp>
 #include <ipc/candidates/face_face.hpp>
 
@@ -139,3 +143,87 @@ TEST_CASE("Face-Face Candidate", "[candidates][face-face]")
     CHECK(FaceFaceCandidate(0, 1) < FaceFaceCandidate(2, 0));
     CHECK(!(FaceFaceCandidate(1, 1) < FaceFaceCandidate(0, 2)));
 }
+
+TEST_CASE("Compact candidates", "[candidates][compact]")
+{
+    Eigen::MatrixXd V0, V1;
+    Eigen::MatrixXi E, F;
+    {
+        Eigen::MatrixXi E1, F1;
+        REQUIRE(
+            (tests::load_mesh("two-cubes-close.ply", V0, E, F)
+             && tests::load_mesh("two-cubes-intersecting.ply", V1, E1, F1)));
+    }
+
+    const CollisionMesh mesh(V0, E, F);
+    Candidates candidates;
+    candidates.build(mesh, V0, V1);
+    REQUIRE(candidates.size() > 0);
+
+    const CompactCandidates compact(candidates, mesh);
+    REQUIRE(compact.size() == candidates.size());
+
+    // Step size from the per-candidate (virtual) narrow phase
+    double expected_stepsize = 1;
+    for (size_t i = 0; i < candidates.size(); i++) {
+        const CollisionStencil& candidate = candidates[i];
+
+        const std::array<long, 4> expected_ids =
+            candidate.vertex_ids(mesh.edges(), mesh.faces());
+        const CompactCandidates::VertexIds& ids = compact.vertex_ids(i);
+        for (int j = 0; j < 4; j++) {
+            CHECK(ids[j] == expected_ids[j]);
+        }
+
+        double expected_toi, toi;
+        const bool expected_collision = candidate.ccd(
+            candidate.dof(V0, mesh.edges(), mesh.faces()),
+            candidate.dof(V1, mesh.edges(), mesh.faces()), expected_toi);
+        const bool collision = compact.ccd(i, V0, V1, toi);
+        CHECK(collision == expected_collision);
+        if (collision && expected_collision) {
+            CHECK(toi == expected_toi);
+        }
+        if (expected_collision) {
+            expected_stepsize = std::min(expected_stepsize, expected_toi);
+        }
+    }
+
+    CHECK(
+        compact.type(candidates.size() - 1)
+        == CompactCandidates::Type::FACE_VERTEX);
+
+    // The step sizes are computed with a shrinking tmax, so they can differ
+    // from the per-candidate results by the solver tolerance.
+    CHECK(
+        compact.compute_collision_free_stepsize(V0, V1)
+        == Catch::Approx(expected_stepsize).margin(1e-4));
+    CHECK(
+        candidates.compute_collision_free_stepsize(mesh, V0, V1)
+        == Catch::Approx(expected_stepsize).margin(1e-4));
+}
+
+TEST_CASE("Compact candidates scheduling", "[candidates][compact]")
+{
+    Eigen::MatrixXd V0, V1;
+    Eigen::MatrixXi E, F;
+    {
+        Eigen::MatrixXi E1, F1;
+        REQUIRE(
+            (tests::load_mesh("two-cubes-close.ply", V0, E, F)
+             && tests::load_mesh("two-cubes-intersecting.ply", V1, E1, F1)));
+    }
+
+    const CollisionMesh mesh(V0, E, F);
+    Candidates candidates;
+    candidates.build(mesh, V0, V1);
+    const CompactCandidates compact(candidates, mesh);
+    REQUIRE(compact.size() > 0);
+
+    for (size_t i = 0; i < compact.size(); i++) {
+        const double cost = compact.estimate_ccd_cost(i, V0, V1);
+        CHECK(cost >= 1);
+        // Moving the vertices relative to each other only adds cost.
+        CHECK(compact.estimate_ccd_cost(i, V0, V0) <= cost);
+    }
+}
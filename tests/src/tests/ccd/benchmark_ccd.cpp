@@ -58,3 +58,55 @@ TEST_CASE("Benchmark earliest toi", "[!benchmark][ccd][earliest_toi]")
             mesh, V0, V1, /*min_distance=*/0, ccd);
     };
 }
+
+TEST_CASE("Benchmark per-candidate toi", "[!benchmark][ccd][per_candidate_toi]")
+{
+    Eigen::MatrixXd V0, V1;
+    Eigen::MatrixXi E, F;
+
+    std::string mesh_name_t0, mesh_name_t1;
+    SECTION("Data 0")
+    {
+        mesh_name_t0 = "private/slow-broadphase-ccd/0.ply";
+        mesh_name_t1 = "private/slow-broadphase-ccd/1.ply";
+    }
+    SECTION("Data 1")
+    {
+        mesh_name_t0 = "private/slow-broadphase-ccd/s0.ply";
+        mesh_name_t1 = "private/slow-broadphase-ccd/s1.ply";
+    }
+    SECTION("Cloth-ball")
+    {
+        mesh_name_t0 = "cloth_ball92.ply";
+        mesh_name_t1 = "cloth_ball93.ply";
+    }
+
+    if (!tests::load_mesh(mesh_name_t0, V0, E, F)
+        || !tests::load_mesh(mesh_name_t1, V1, E, F)) {
+        return; // Data is private
+    }
+
+    CollisionMesh mesh = CollisionMesh::build_from_full_mesh(V0, E, F);
+    // Discard codimensional/internal vertices
+    V0 = mesh.vertices(V0);
+    V1 = mesh.vertices(V1);
+
+    TightInclusionCCD ccd(/*tolerance=*/1e-6, /*max_iterations=*/1e7);
+
+    Candidates candidates;
+    candidates.build(mesh, V0, V1);
+
+    Eigen::VectorXd tois;
+    BENCHMARK("Per-Candidate ToI Narrow-Phase")
+    {
+        tois = candidates.compute_per_candidate_toi(
+            mesh, V0, V1, /*min_distance=*/0, ccd);
+    };
+
+    Eigen::VectorXd stepsizes;
+    BENCHMARK("Per-Vertex Stepsize Narrow-Phase")
+    {
+        stepsizes = candidates.compute_per_vertex_collision_free_stepsize(
+            mesh, V0, V1, /*min_distance=*/0, ccd);
+    };
+}
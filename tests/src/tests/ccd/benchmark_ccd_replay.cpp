@@ -0,0 +1,333 @@
+#include <tests/config.hpp>
+#include <tests/utils.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <ipc/ipc.hpp>
+#include <ipc/candidates/candidates.hpp>
+#include <ipc/utils/logger.hpp>
+
+#include <fmt/format.h>
+#include <igl/Timer.h>
+#include <nlohmann/json.hpp>
+#include <tbb/global_control.h>
+#include <tbb/info.h>
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <limits>
+#include <numeric>
+
+using namespace ipc;
+
+namespace {
+
+/// @brief Number of times each step is replayed (the fastest time is kept).
+constexpr int NUM_REPETITIONS = 3;
+
+/// @brief Relative slowdown w.r.t. the baseline reported as a regression.
+constexpr double REGRESSION_THRESHOLD = 1.2;
+
+/// @brief A recorded sequence of positions of a simulated mesh.
+struct Trace {
+    std::string name;
+    Eigen::MatrixXi edges;
+    Eigen::MatrixXi faces;
+    /// @brief Vertex positions of each frame. Consecutive frames are the start and end positions of a step.
+    std::vector<Eigen::MatrixXd> frames;
+};
+
+/// @brief Load the frames of a trace.
+/// @param name Name of the trace.
+/// @param mesh_names Names of the frames' meshes in order (relative to the test data directory or absolute).
+/// @param[out] trace The loaded trace.
+/// @return True if all the frames were loaded.
+bool load_trace(
+    const std::string& name,
+    const std::vector<std::string>& mesh_names,
+    Trace& trace)
+{
+    trace.name = name;
+    trace.frames.clear();
+    for (const std::string& mesh_name : mesh_names) {
+        Eigen::MatrixXd V;
+        Eigen::MatrixXi E, F;
+        if (!tests::load_mesh(mesh_name, V, E, F)) {
+            return false;
+        }
+        if (trace.frames.empty()) {
+            trace.edges = E;
+            trace.faces = F;
+        } else if (V.rows() != trace.frames[0].rows()) {
+            logger().error(
+                "Frame {} of trace {} has a different number of vertices!",
+                mesh_name, name);
+            return false;
+        }
+        trace.frames.push_back(V);
+    }
+    return trace.frames.size() >= 2;
+}
+
+/// @brief Load the traces to replay.
+///
+/// Each subdirectory of the replay directory is a trace whose frames are
+/// meshes named by their frame number (e.g., 0.ply, 1.ply, ...), sharing the
+/// connectivity of the first frame. Without a replay directory, the
+/// available recorded steps of the test data are replayed.
+std::vector<Trace> load_traces()
+{
+    namespace fs = std::filesystem;
+
+    std::vector<Trace> traces;
+    if (!tests::CCD_REPLAY_DIR.empty() && fs::exists(tests::CCD_REPLAY_DIR)) {
+        std::vector<fs::path> trace_dirs;
+        for (const auto& entry :
+             fs::directory_iterator(tests::CCD_REPLAY_DIR)) {
+            if (entry.is_directory()) {
+                trace_dirs.push_back(entry.path());
+            }
+        }
+        std::sort(trace_dirs.begin(), trace_dirs.end());
+
+        for (const fs::path& trace_dir : trace_dirs) {
+            std::vector<std::pair<long, std::string>> frames;
+            for (const auto& entry : fs::directory_iterator(trace_dir)) {
+                const std::string stem = entry.path().stem().string();
+                if (entry.is_regular_file() && !stem.empty()
+                    && std::all_of(stem.begin(), stem.end(), [](char c) {
+                           return std::isdigit(static_cast<unsigned char>(c));
+                       })) {
+                    frames.emplace_back(std::stol(stem), entry.path().string());
+                }
+            }
+            std::sort(frames.begin(), frames.end());
+
+            std::vector<std::string> mesh_names;
+            for (const auto& [frame, mesh_name] : frames) {
+                mesh_names.push_back(mesh_name);
+            }
+
+            Trace trace;
+            if (load_trace(
+                    trace_dir.filename().string(), mesh_names, trace)) {
+                traces.push_back(std::move(trace));
+            } else {
+                logger().warn("Skipping trace {}!", trace_dir.string());
+            }
+        }
+    } else {
+        const std::vector<std::pair<std::string, std::vector<std::string>>>
+            default_traces = {
+                { "cloth-ball", { "cloth_ball92.ply", "cloth_ball93.ply" } },
+                { "slow-broadphase-ccd",
+                  { "private/slow-broadphase-ccd/0.ply",
+                    "private/slow-broadphase-ccd/1.ply" } },
+            };
+        for (const auto& [name, mesh_names] : default_traces) {
+            Trace trace;
+            if (load_trace(name, mesh_names, trace)) { // Data may be private
+                traces.push_back(std::move(trace));
+            }
+        }
+    }
+    return traces;
+}
+
+/// @brief Thread counts to sweep: powers of two up to the current limit (inclusive).
+std::vector<int> thread_counts()
+{
+    const int max_num_threads = int(tbb::global_control::active_value(
+        tbb::global_control::max_allowed_parallelism));
+    std::vector<int> num_threads;
+    for (int n = 1; n < max_num_threads; n *= 2) {
+        num_threads.push_back(n);
+    }
+    num_threads.push_back(max_num_threads);
+    return num_threads;
+}
+
+/// @brief Find the results of a trace and thread count in a previous run.
+const nlohmann::json* find_run(
+    const nlohmann::json& results,
+    const std::string& trace_name,
+    const int num_threads)
+{
+    if (!results.contains("traces")) {
+        return nullptr;
+    }
+    for (const nlohmann::json& trace : results["traces"]) {
+        if (trace.value("name", "") != trace_name) {
+            continue;
+        }
+        for (const nlohmann::json& run : trace["runs"]) {
+            if (run.value("num_threads", 0) == num_threads) {
+                return &run;
+            }
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+TEST_CASE("Benchmark CCD replay", "[!benchmark][ccd][replay]")
+{
+    const std::vector<Trace> traces = load_traces();
+    if (traces.empty()) {
+        return; // No recorded traces available
+    }
+
+    nlohmann::json baseline;
+    if (!tests::CCD_REPLAY_BASELINE.empty()
+        && std::filesystem::exists(tests::CCD_REPLAY_BASELINE)) {
+        std::ifstream file(tests::CCD_REPLAY_BASELINE);
+        file >> baseline;
+    }
+
+    constexpr double min_distance = 0;
+    const auto broad_phase = make_default_broad_phase();
+    const NarrowPhaseCCD& narrow_phase_ccd = DEFAULT_NARROW_PHASE_CCD;
+
+    nlohmann::json results;
+    results["version"] = IPC_TOOLKIT_VER;
+#ifdef NDEBUG
+    results["build_type"] = "release";
+#else
+    results["build_type"] = "debug";
+#endif
+    results["broad_phase"] = broad_phase->name();
+    results["num_repetitions"] = NUM_REPETITIONS;
+    results["default_concurrency"] = tbb::info::default_concurrency();
+    results["traces"] = nlohmann::json::array();
+
+    for (const Trace& trace : traces) {
+        const CollisionMesh mesh = CollisionMesh::build_from_full_mesh(
+            trace.frames[0], trace.edges, trace.faces);
+        // Discard codimensional/internal vertices
+        std::vector<Eigen::MatrixXd> frames;
+        for (const Eigen::MatrixXd& frame : trace.frames) {
+            frames.push_back(mesh.vertices(frame));
+        }
+        const size_t num_steps = frames.size() - 1;
+
+        nlohmann::json trace_results;
+        trace_results["name"] = trace.name;
+        trace_results["num_vertices"] = mesh.num_vertices();
+        trace_results["num_edges"] = mesh.num_edges();
+        trace_results["num_faces"] = mesh.num_faces();
+        trace_results["num_steps"] = num_steps;
+        trace_results["runs"] = nlohmann::json::array();
+
+        for (const int num_threads : thread_counts()) {
+            tbb::global_control thread_limiter(
+                tbb::global_control::max_allowed_parallelism, num_threads);
+
+            // Per step timings (in ms) and results
+            std::vector<double> broad_phase_ms(num_steps),
+                narrow_phase_ms(num_steps), total_ms(num_steps),
+                stepsizes(num_steps);
+            std::vector<size_t> num_candidates(num_steps);
+
+            igl::Timer timer;
+            for (size_t i = 0; i < num_steps; i++) {
+                const Eigen::MatrixXd& V0 = frames[i];
+                const Eigen::MatrixXd& V1 = frames[i + 1];
+
+                broad_phase_ms[i] = narrow_phase_ms[i] = total_ms[i] =
+                    std::numeric_limits<double>::infinity();
+                for (int r = 0; r < NUM_REPETITIONS; r++) {
+                    Candidates candidates;
+                    timer.start();
+                    candidates.build(
+                        mesh, V0, V1,
+                        /*inflation_radius=*/0.5 * min_distance, broad_phase);
+                    timer.stop();
+                    broad_phase_ms[i] = std::min(
+                        broad_phase_ms[i], timer.getElapsedTimeInMilliSec());
+                    num_candidates[i] = candidates.size();
+
+                    timer.start();
+                    stepsizes[i] = candidates.compute_collision_free_stepsize(
+                        mesh, V0, V1, min_distance, narrow_phase_ccd);
+                    timer.stop();
+                    narrow_phase_ms[i] = std::min(
+                        narrow_phase_ms[i], timer.getElapsedTimeInMilliSec());
+
+                    timer.start();
+                    compute_collision_free_stepsize(
+                        mesh, V0, V1, min_distance, broad_phase,
+                        narrow_phase_ccd);
+                    timer.stop();
+                    total_ms[i] = std::min(
+                        total_ms[i], timer.getElapsedTimeInMilliSec());
+                }
+            }
+
+            const auto sum = [](const std::vector<double>& x) {
+                return std::accumulate(x.begin(), x.end(), 0.0);
+            };
+
+            nlohmann::json run;
+            run["num_threads"] = num_threads;
+            run["broad_phase_ms"] = sum(broad_phase_ms);
+            run["narrow_phase_ms"] = sum(narrow_phase_ms);
+            run["total_ms"] = sum(total_ms);
+            run["steps"] = {
+                { "broad_phase_ms", broad_phase_ms },
+                { "narrow_phase_ms", narrow_phase_ms },
+                { "total_ms", total_ms },
+                { "num_candidates", num_candidates },
+                { "stepsize", stepsizes },
+            };
+
+            fmt::print(
+                "{} ({:d} steps, {:d} threads): broad phase {:.3f} ms, "
+                "narrow phase {:.3f} ms, total {:.3f} ms\n",
+                trace.name, num_steps, num_threads, sum(broad_phase_ms),
+                sum(narrow_phase_ms), sum(total_ms));
+
+            // Compare against the baseline
+            const nlohmann::json* baseline_run =
+                find_run(baseline, trace.name, num_threads);
+            if (baseline_run != nullptr) {
+                const double baseline_total_ms =
+                    baseline_run->value("total_ms", 0.0);
+                run["speedup"] = baseline_total_ms / sum(total_ms);
+                if (sum(total_ms) > REGRESSION_THRESHOLD * baseline_total_ms) {
+                    WARN(fmt::format(
+                        "Performance regression on {} with {:d} threads: "
+                        "{:.3f} ms (baseline {:.3f} ms)",
+                        trace.name, num_threads, sum(total_ms),
+                        baseline_total_ms));
+                }
+                // The step sizes should not change (up to the solver
+                // tolerance).
+                const std::vector<double> baseline_stepsizes =
+                    baseline_run->at("steps")
+                        .at("stepsize")
+                        .get<std::vector<double>>();
+                REQUIRE(baseline_stepsizes.size() == stepsizes.size());
+                for (size_t i = 0; i < stepsizes.size(); i++) {
+                    CHECK(
+                        stepsizes[i]
+                        == Catch::Approx(baseline_stepsizes[i]).margin(1e-6));
+                }
+            }
+
+            trace_results["runs"].push_back(run);
+        }
+
+        results["traces"].push_back(trace_results);
+    }
+
+    if (!tests::CCD_REPLAY_OUTPUT.empty()) {
+        std::ofstream file(tests::CCD_REPLAY_OUTPUT);
+        file << results.dump(2);
+        fmt::print(
+            "CCD replay results written to {}\n",
+            tests::CCD_REPLAY_OUTPUT.string());
+    }
+}
@@ -2,6 +2,7 @@
 #include <tests/utils.hpp>
 
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
 #include <catch2/generators/catch_generators_adapters.hpp>
 #include <catch2/generators/catch_generators_random.hpp>
 #include <catch2/benchmark/catch_benchmark.hpp>
@@ -10,6 +11,10 @@
 #include <ipc/ccd/tight_inclusion_ccd.hpp>
 #include <ipc/ccd/additive_ccd.hpp>
 #include <ipc/ccd/point_static_plane.hpp>
+#include <ipc/ccd/point_static_sdf.hpp>
+#include <ipc/distance/point_plane.hpp>
+#include <ipc/implicits/plane.hpp>
+#include <ipc/implicits/sdf.hpp>
 #include <ipc/broad_phase/hash_grid.hpp>
 #include <ipc/broad_phase/sweep_and_prune.hpp>
 
@@ -156,6 +161,135 @@ TEST_CASE("Point-Plane CCD", "[ccd][point-plane]")
     CHECK(toi <= t);
 }
 
+TEST_CASE("Point-Planes batched", "[ccd][point-plane]")
+{
+    // Many points against a few planes, compared against all pairs
+    const int n_points = 1000, n_planes = 8;
+    srand(0);
+    const Eigen::MatrixXd points_t0 = Eigen::MatrixXd::Random(n_points, 3);
+    const Eigen::MatrixXd points_t1 =
+        points_t0 + 0.3 * Eigen::MatrixXd::Random(n_points, 3);
+    Eigen::MatrixXd plane_origins = 0.9 * Eigen::MatrixXd::Random(n_planes, 3);
+    Eigen::MatrixXd plane_normals = 3 * Eigen::MatrixXd::Random(n_planes, 3);
+    plane_origins.row(0) << 100, 0, 0; // far away plane (culled)
+    plane_normals.row(0) << 1, 0, 0;
+
+    const auto can_collide = [](size_t vi, size_t pi) {
+        return (vi + pi) % 5 != 0;
+    };
+
+    const double dhat = GENERATE(1e-3, 5e-2);
+
+    size_t expected_num_collisions = 0;
+    double expected_toi = 1;
+    bool expected_collision_free = true;
+    for (size_t vi = 0; vi < n_points; vi++) {
+        for (size_t pi = 0; pi < n_planes; pi++) {
+            if (!can_collide(vi, pi)) {
+                continue;
+            }
+            if (point_plane_distance(
+                    points_t0.row(vi), plane_origins.row(pi),
+                    plane_normals.row(pi))
+                < dhat * dhat) {
+                expected_num_collisions++;
+            }
+            double toi;
+            if (point_static_plane_ccd(
+                    points_t0.row(vi), points_t1.row(vi),
+                    plane_origins.row(pi), plane_normals.row(pi), toi)) {
+                expected_toi = std::min(expected_toi, toi);
+                expected_collision_free = false;
+            }
+        }
+    }
+
+    std::vector<PlaneVertexNormalCollision> pv_collisions;
+    construct_point_plane_collisions(
+        points_t0, plane_origins, plane_normals, dhat, pv_collisions,
+        /*dmin=*/0, can_collide);
+    CHECK(pv_collisions.size() == expected_num_collisions);
+    for (size_t i = 1; i < pv_collisions.size(); i++) {
+        CHECK(pv_collisions[i - 1].vertex_id <= pv_collisions[i].vertex_id);
+    }
+
+    CHECK(
+        compute_point_plane_collision_free_stepsize(
+            points_t0, points_t1, plane_origins, plane_normals, can_collide)
+        == expected_toi);
+    CHECK(
+        is_step_point_plane_collision_free(
+            points_t0, points_t1, plane_origins, plane_normals, can_collide)
+        == expected_collision_free);
+}
+
+TEST_CASE("Point-SDF CCD", "[ccd][point-sdf]")
+{
+    // Sphere of radius 0.5 sampled on a grid enclosing it
+    const GridSDF sdf(
+        Eigen::Vector3d::Constant(-0.6), 0.02, Eigen::Vector3i::Constant(61),
+        [](Eigen::ConstRef<VectorMax3d> x) { return x.norm() - 0.5; });
+
+    SECTION("Head-on")
+    {
+        const Eigen::Vector3d p_t0(1, 0, 0), p_t1(-1, 0, 0);
+        double toi;
+        CHECK(point_static_sdf_ccd(p_t0, p_t1, sdf, toi));
+        CHECK(toi < 0.25); // exact time of impact
+        CHECK(toi > 0.1);
+        CHECK(!point_static_sdf_ccd(
+            p_t0, p_t1, sdf, toi, /*min_distance=*/0, /*tmax=*/0.2));
+    }
+
+    SECTION("Random")
+    {
+        srand(0);
+        const int n_points = 200;
+        Eigen::MatrixXd points_t0 = Eigen::MatrixXd::Random(n_points, 3);
+        for (int i = 0; i < n_points; i++) {
+            // Keep the points away from the surface at the start
+            if (std::abs(sdf.value(points_t0.row(i))) < 0.05) {
+                points_t0.row(i) *= 1.5;
+            }
+        }
+        const Eigen::MatrixXd points_t1 =
+            points_t0 + 1.5 * Eigen::MatrixXd::Random(n_points, 3);
+
+        // No point crosses the surface before its time of impact
+        double expected_toi = 1;
+        bool expected_collision_free = true;
+        for (int i = 0; i < n_points; i++) {
+            double toi;
+            const bool is_colliding = point_static_sdf_ccd(
+                points_t0.row(i), points_t1.row(i), sdf, toi);
+            const double t_end = is_colliding ? toi : 1.0;
+            CHECK((0 <= t_end && t_end <= 1));
+
+            const double sign = sdf.value(points_t0.row(i));
+            for (int k = 1; k <= 100; k++) {
+                const double t = t_end * k / 100.0;
+                CHECK(
+                    sign
+                        * sdf.value(
+                            (1 - t) * points_t0.row(i) + t * points_t1.row(i))
+                    > 0);
+            }
+
+            if (is_colliding) {
+                expected_toi = std::min(expected_toi, toi);
+                expected_collision_free = false;
+            }
+        }
+
+        CHECK(
+            compute_point_sdf_collision_free_stepsize(points_t0, points_t1, sdf)
+            == expected_toi);
+        CHECK(
+            is_step_point_sdf_collision_free(points_t0, points_t1, sdf)
+            == expected_collision_free);
+    }
+}
+
 TEST_CASE("Squash Tet", "[ccd]")
 {
     const double dhat = 1e-3;
@@ -247,4 +381,50 @@ TEST_CASE("Slow CCD", "[CCD]")
             mesh, V0, V1, min_distance, tight_inclusion),
         candidates.compute_collision_free_stepsize(
             mesh, V0, V1, min_distance, AdditiveCCD()));
-}
\ No newline at end of file
+}
+
+TEST_CASE("Tiered Tight Inclusion CCD", "[ccd][tight_inclusion]")
+{
+    Eigen::MatrixXd V0, V1;
+    Eigen::MatrixXi E, F;
+    REQUIRE(tests::load_mesh("two-cubes-close.ply", V0, E, F));
+    REQUIRE(tests::load_mesh("two-cubes-intersecting.ply", V1, E, F));
+
+    CollisionMesh mesh(V0, E, F);
+
+    Candidates candidates;
+    candidates.build(mesh, V0, V1);
+
+    TightInclusionCCD ccd;
+    CHECK(ccd.first_tier() == nullptr);
+
+    const double expected_toi =
+        candidates.compute_collision_free_stepsize(mesh, V0, V1, 0, ccd);
+    CHECK(ccd.statistics().num_queries > 0);
+    CHECK(ccd.statistics().num_first_tier_queries == 0);
+
+    ccd.reset_statistics();
+    CHECK(ccd.statistics().num_queries == 0);
+
+    // Copies count their own work.
+    const TightInclusionCCD copy = ccd;
+    CHECK(copy.statistics().num_queries == 0);
+    candidates.compute_collision_free_stepsize(mesh, V0, V1, 0, copy);
+    CHECK(copy.statistics().num_queries > 0);
+    CHECK(ccd.statistics().num_queries == 0);
+
+    ccd.initial_max_iterations = GENERATE(1, 10, 1000);
+    CAPTURE(ccd.initial_max_iterations);
+    REQUIRE(ccd.first_tier() != nullptr);
+
+    const double toi =
+        candidates.compute_collision_free_stepsize(mesh, V0, V1, 0, ccd);
+    CHECK(toi == Catch::Approx(expected_toi).margin(1e-4));
+
+    const TightInclusionCCD::Statistics& statistics = ccd.statistics();
+    CHECK(statistics.num_first_tier_queries > 0);
+    CHECK(statistics.num_queries >= statistics.num_first_tier_queries);
+    CHECK(
+        statistics.total_exhausted_budget
+        >= statistics.num_exhausted * ccd.initial_max_iterations);
+}
@@ -6,6 +6,7 @@
 #include <ipc/ccd/tight_inclusion_ccd.hpp>
 #include <ipc/ccd/additive_ccd.hpp>
 #include <ipc/ccd/inexact_ccd.hpp>
+#include <ipc/ccd/float_ccd_prefilter.hpp>
 
 #include <fmt/format.h>
 #include <igl/Timer.h>
@@ -166,6 +167,16 @@ void run_benchmark(const std::shared_ptr<NarrowPhaseCCD> ccd)
                     fmt::print("\n");
                 }
                 CHECK((result || !expected_result)); // false positive is ok
+
+                // The float prefilter must never discard a collision.
+                const bool may_collide = is_edge_edge
+                    ? edge_edge_ccd_prefilter(
+                          V.row(0), V.row(1), V.row(2), V.row(3), V.row(4),
+                          V.row(5), V.row(6), V.row(7))
+                    : point_triangle_ccd_prefilter(
+                          V.row(0), V.row(1), V.row(2), V.row(3), V.row(4),
+                          V.row(5), V.row(6), V.row(7));
+                CHECK((may_collide || !expected_result));
             }
         }
     }
@@ -201,6 +212,13 @@ TEST_CASE("Run CCD Benchmark", BENCHMARK_TAGS)
         fmt::print("Tight Inclusion CCD:\n\n");
         ccd = std::make_shared<TightInclusionCCD>();
     }
+    SECTION("Tight Inclusion CCD with float prefilter")
+    {
+        fmt::print("Tight Inclusion CCD with float prefilter:\n\n");
+        auto tight_inclusion_ccd = std::make_shared<TightInclusionCCD>();
+        tight_inclusion_ccd->use_float_prefilter = true;
+        ccd = tight_inclusion_ccd;
+    }
     SECTION("Additive CCD")
     {
         fmt::print("Additive CCD:\n\n");
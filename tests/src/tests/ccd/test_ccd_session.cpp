@@ -0,0 +1,58 @@
+#include <tests/utils.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <ipc/ipc.hpp>
+#include <ipc/ccd/ccd_session.hpp>
+
+using namespace ipc;
+
+TEST_CASE("CCD session line search", "[ccd][ccd_session]")
+{
+    Eigen::MatrixXd V0, V1;
+    Eigen::MatrixXi E, F;
+    REQUIRE(tests::load_mesh("two-cubes-close.ply", V0, E, F));
+    REQUIRE(tests::load_mesh("two-cubes-intersecting.ply", V1, E, F));
+
+    CollisionMesh mesh(V0, E, F);
+
+    CCDSession session(mesh);
+
+    const double toi = session.compute_collision_free_stepsize(V0, V1);
+    CHECK(session.num_builds() == 1);
+    CHECK(toi < 1.0);
+    CHECK(
+        toi
+        == Catch::Approx(compute_collision_free_stepsize(mesh, V0, V1))
+               .margin(1e-4));
+    CHECK(!session.is_step_collision_free(V0, V1));
+    CHECK(session.candidate_tois().size() == session.candidates().size());
+    CHECK(
+        session.candidate_tois().minCoeff()
+        == Catch::Approx(toi).margin(1e-4));
+
+    // Backtracking along the same direction reuses the cached TOIs
+    const double alpha = GENERATE(0.9, 0.5, 0.25, 0.1, 0.0);
+    CAPTURE(alpha);
+
+    const Eigen::MatrixXd V_alpha = V0 + alpha * (V1 - V0);
+    const double toi_alpha =
+        session.compute_collision_free_stepsize(V0, V_alpha);
+    CHECK(session.num_builds() == 1);
+    CHECK(
+        toi_alpha
+        == Catch::Approx(compute_collision_free_stepsize(mesh, V0, V_alpha))
+               .margin(1e-4));
+    CHECK(
+        session.is_step_collision_free(V0, V_alpha)
+        == session.is_step_collision_free(alpha));
+    CHECK(session.num_builds() == 1);
+
+    // A new direction requires a new CCD
+    Eigen::MatrixXd V2 = V1;
+    V2.row(0).array() += 0.1;
+    session.compute_collision_free_stepsize(V0, V2);
+    CHECK(session.num_builds() == 2);
+}
@@ -4,6 +4,7 @@
 #include <ipc/config.hpp>
 #include <ipc/ccd/tight_inclusion_ccd.hpp>
 #include <ipc/ccd/additive_ccd.hpp>
+#include <ipc/ccd/float_ccd_prefilter.hpp>
 
 using namespace ipc;
 
@@ -154,6 +155,12 @@ TEST_CASE("Edge-Edge CCD", "[ccd][3D][edge-edge]")
         CHECK(is_colliding == is_collision_expected);
     }
 
+    // The float prefilter must never discard a collision.
+    CHECK(
+        (edge_edge_ccd_prefilter(
+             ea0_t0, ea1_t0, eb0_t0, eb1_t0, ea0_t1, ea1_t1, eb0_t1, eb1_t1)
+         || !is_collision_expected));
+
     const AdditiveCCD additive_ccd;
     is_colliding = additive_ccd.edge_edge_ccd(
         ea0_t0, ea1_t0, eb0_t0, eb1_t0, ea0_t1, ea1_t1, eb0_t1, eb1_t1, toi,
@@ -0,0 +1,89 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <ipc/ccd/float_ccd_prefilter.hpp>
+#include <ipc/ccd/tight_inclusion_ccd.hpp>
+
+using namespace ipc;
+
+TEST_CASE("Float CCD prefilter", "[ccd][prefilter]")
+{
+    // Large offsets make the coordinates inexact in single precision.
+    const double offset = GENERATE(0.0, 1.0 / 3.0, 1e3 + 1e-7);
+    const double min_distance = GENERATE(0.0, 1e-4);
+    CAPTURE(offset, min_distance);
+
+    for (int i = 0; i < 100; i++) {
+        // Construct queries that touch at a random time t* by moving every
+        // vertex with a random velocity away from a configuration in contact.
+        const double toi = (Eigen::Vector2d::Random()[0] + 1) / 2;
+        const auto trajectory = [&](const Eigen::Vector3d& x) {
+            const Eigen::Vector3d v = Eigen::Vector3d::Random();
+            const Eigen::Vector3d x_t0 = (x - toi * v).array() + offset;
+            const Eigen::Vector3d x_t1 = (x + (1 - toi) * v).array() + offset;
+            return std::make_pair(x_t0, x_t1);
+        };
+
+        // Two edges crossing at the origin
+        const Eigen::Vector3d da = Eigen::Vector3d::Random();
+        const Eigen::Vector3d db = Eigen::Vector3d::Random();
+        const auto [ea0_t0, ea0_t1] = trajectory(-0.5 * da);
+        const auto [ea1_t0, ea1_t1] = trajectory(0.5 * da);
+        const auto [eb0_t0, eb0_t1] = trajectory(-0.5 * db);
+        const auto [eb1_t0, eb1_t1] = trajectory(0.5 * db);
+
+        CHECK(edge_edge_ccd_prefilter(
+            ea0_t0, ea1_t0, eb0_t0, eb1_t0, ea0_t1, ea1_t1, eb0_t1, eb1_t1,
+            min_distance));
+
+        // A point inside a triangle
+        const Eigen::Vector3d bc = Eigen::Vector3d::Random().cwiseAbs();
+        const Eigen::Vector3d t0 = Eigen::Vector3d::Random();
+        const Eigen::Vector3d t1 = Eigen::Vector3d::Random();
+        const Eigen::Vector3d t2 = Eigen::Vector3d::Random();
+        const auto [p_t0, p_t1] =
+            trajectory((bc[0] * t0 + bc[1] * t1 + bc[2] * t2) / bc.sum());
+        const auto [t0_t0, t0_t1] = trajectory(t0);
+        const auto [t1_t0, t1_t1] = trajectory(t1);
+        const auto [t2_t0, t2_t1] = trajectory(t2);
+
+        CHECK(point_triangle_ccd_prefilter(
+            p_t0, t0_t0, t1_t0, t2_t0, p_t1, t0_t1, t1_t1, t2_t1,
+            min_distance));
+    }
+}
+
+TEST_CASE("Float CCD prefilter discards separated queries", "[ccd][prefilter]")
+{
+    // The edges swap sides along the y-axis but are separated along z.
+    const Eigen::Vector3d ea0_t0(0, 0, 0), ea1_t0(1, 0, 0);
+    const Eigen::Vector3d ea0_t1(0, 1, 0), ea1_t1(1, 1, 0);
+    const Eigen::Vector3d eb0_t0(0, 1, 1), eb1_t0(0, 1, 2);
+    const Eigen::Vector3d eb0_t1(0, 0, 1), eb1_t1(0, 0, 2);
+
+    CHECK(!edge_edge_ccd_prefilter(
+        ea0_t0, ea1_t0, eb0_t0, eb1_t0, ea0_t1, ea1_t1, eb0_t1, eb1_t1));
+    CHECK(edge_edge_ccd_prefilter(
+        ea0_t0, ea1_t0, eb0_t0, eb1_t0, ea0_t1, ea1_t1, eb0_t1, eb1_t1,
+        /*min_distance=*/1.0));
+
+    TightInclusionCCD ccd;
+    ccd.use_float_prefilter = true;
+
+    double toi;
+    CHECK(!ccd.edge_edge_ccd(
+        ea0_t0, ea1_t0, eb0_t0, eb1_t0, ea0_t1, ea1_t1, eb0_t1, eb1_t1, toi));
+    CHECK(ccd.statistics().num_prefiltered == 1);
+
+    // Separated only in time: the point passes the triangle's plane after the
+    // triangle has moved away.
+    const Eigen::Vector3d p_t0(0.25, 0.25, 1), p_t1(0.25, 0.25, -1);
+    const Eigen::Vector3d t0_t0(0, 0, 0), t1_t0(1, 0, 0), t2_t0(0, 1, 0);
+    const Eigen::Vector3d t0_t1(10, 0, 0), t1_t1(11, 0, 0), t2_t1(10, 1, 0);
+
+    CHECK(!point_triangle_ccd_prefilter(
+        p_t0, t0_t0, t1_t0, t2_t0, p_t1, t0_t1, t1_t1, t2_t1));
+    CHECK(!ccd.point_triangle_ccd(
+        p_t0, t0_t0, t1_t0, t2_t0, p_t1, t0_t1, t1_t1, t2_t1, toi));
+    CHECK(ccd.statistics().num_prefiltered == 2);
+}
@@ -4,6 +4,7 @@
 #include <ipc/config.hpp>
 #include <ipc/ccd/tight_inclusion_ccd.hpp>
 #include <ipc/ccd/additive_ccd.hpp>
+#include <ipc/ccd/float_ccd_prefilter.hpp>
 
 using namespace ipc;
 
@@ -105,6 +106,12 @@ TEST_CASE("Point-Triangle CCD", "[ccd][3D][point-triangle]")
         CHECK(is_colliding == is_collision_expected);
     }
 
+    // The float prefilter must never discard a collision.
+    CHECK(
+        (point_triangle_ccd_prefilter(
+             p_t0, t0_t0, t1_t0, t2_t0, p_t1, t0_t1, t1_t1, t2_t1)
+         || !is_collision_expected));
+
     const AdditiveCCD additive_ccd;
     is_colliding = additive_ccd.point_triangle_ccd(
         p_t0, t0_t0, t1_t0, t2_t0, p_t1, t0_t1, t1_t1, t2_t1, toi);
@@ -0,0 +1,197 @@
+#include <tests/utils.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <ipc/ipc.hpp>
+#include <ipc/ccd/rigid_trajectory.hpp>
+
+#include <igl/PI.h>
+
+using namespace ipc;
+
+namespace {
+/// @brief Sample the maximum distance from the linearized trajectory.
+double sampled_distance_from_linear(
+    const NonlinearTrajectory& trajectory, const double t0, const double t1)
+{
+    const VectorMax3d p_t0 = trajectory(t0), p_t1 = trajectory(t1);
+    double max_d = 0;
+    for (int i = 0; i <= 100; i++) {
+        const double s = i / 100.0;
+        max_d = std::max(
+            max_d,
+            (trajectory((1 - s) * t0 + s * t1) - ((1 - s) * p_t0 + s * p_t1))
+                .norm());
+    }
+    return max_d;
+}
+} // namespace
+
+TEST_CASE("Rigid trajectory bound", "[ccd][nonlinear][rigid]")
+{
+    const int dim = GENERATE(2, 3);
+    CAPTURE(dim);
+
+    const Eigen::MatrixXd R0 = Eigen::MatrixXd::Identity(dim, dim);
+    const int angular_dim = dim == 2 ? 1 : 3;
+
+    const VectorMax3d joint = Eigen::VectorXd::Random(dim);
+    auto root = std::make_shared<RigidBodyMotion>(
+        Eigen::VectorXd::Random(dim), Eigen::VectorXd::Random(dim), R0,
+        igl::PI * Eigen::VectorXd::Random(angular_dim));
+    auto link = std::make_shared<RigidBodyMotion>(
+        root, joint, R0, igl::PI * Eigen::VectorXd::Random(angular_dim));
+
+    // Articulated bodies follow their parent
+    const VectorMax3d x = Eigen::VectorXd::Random(dim);
+    for (const double t : { 0.0, 0.3, 1.0 }) {
+        CHECK(
+            ((*link)(x, t) - (*root)(joint + link->rotation(t) * x, t)).norm()
+            < 1e-12);
+    }
+
+    for (const auto& body : { root, link }) {
+        const RigidTrajectory trajectory(body, Eigen::VectorXd::Random(dim));
+
+        for (const auto& [t0, t1] : std::vector<std::pair<double, double>> {
+                 { 0, 1 }, { 0, 0.5 }, { 0.25, 0.3 } }) {
+            CAPTURE(t0, t1);
+            CHECK(
+                sampled_distance_from_linear(trajectory, t0, t1)
+                <= trajectory.max_distance_from_linear(t0, t1));
+        }
+    }
+
+    // Pure translation is linear
+    const RigidTrajectory translating(
+        std::make_shared<RigidBodyMotion>(
+            Eigen::VectorXd::Zero(dim), Eigen::VectorXd::Ones(dim), R0,
+            Eigen::VectorXd::Zero(angular_dim)),
+        Eigen::VectorXd::Random(dim));
+    CHECK(translating.max_distance_from_linear(0, 1) == 0);
+    CHECK(
+        (translating(0.5) - translating.point()
+         - 0.5 * Eigen::VectorXd::Ones(dim))
+            .norm()
+        < 1e-12);
+}
+
+TEST_CASE("Batched nonlinear CCD", "[ccd][nonlinear][rigid][candidates]")
+{
+    // A static edge on the x-axis and an edge above it
+    Eigen::MatrixXd points(4, 2);
+    points << -1, 0, 1, 0, -1, 0, 1, 0;
+    Eigen::VectorXi body_ids(4);
+    body_ids << 0, 0, 1, 1;
+    Eigen::MatrixXi edges(2, 2);
+    edges << 0, 1, 2, 3;
+
+    const double omega = GENERATE(0.0, igl::PI);
+    CAPTURE(omega);
+
+    // The upper edge falls by one unit and spins about its center.
+    const std::vector<std::shared_ptr<const RigidBodyMotion>> bodies {
+        std::make_shared<RigidBodyMotion>(
+            Eigen::Vector2d::Zero(), Eigen::Vector2d::Zero(),
+            Eigen::Matrix2d::Identity(), Eigen::VectorXd::Zero(1)),
+        std::make_shared<RigidBodyMotion>(
+            Eigen::Vector2d(0, 0.5), Eigen::Vector2d(0, -0.5),
+            Eigen::Matrix2d::Identity(), Eigen::VectorXd::Constant(1, omega)),
+    };
+
+    const std::vector<RigidTrajectory> trajectories =
+        build_rigid_trajectories(bodies, body_ids, points);
+    std::vector<const NonlinearTrajectory*> trajectory_ptrs;
+    double inflation_radius = 0;
+    for (const RigidTrajectory& trajectory : trajectories) {
+        trajectory_ptrs.push_back(&trajectory);
+        inflation_radius = std::max(
+            inflation_radius, trajectory.max_distance_from_linear(0, 1));
+    }
+
+    Eigen::MatrixXd V0(4, 2), V1(4, 2);
+    for (int i = 0; i < 4; i++) {
+        V0.row(i) = trajectories[i](0).transpose();
+        V1.row(i) = trajectories[i](1).transpose();
+    }
+
+    const CollisionMesh mesh(V0, edges);
+    Candidates candidates;
+    candidates.build(mesh, V0, V1, inflation_radius);
+    REQUIRE(!candidates.empty());
+
+    const double toi =
+        candidates.compute_nonlinear_collision_free_stepsize(
+            mesh, trajectory_ptrs);
+
+    if (omega == 0) {
+        // The motion is linear, so the result matches the linear CCD.
+        CHECK(toi <= 0.5);
+        CHECK(
+            toi
+            == Catch::Approx(
+                   candidates.compute_collision_free_stepsize(mesh, V0, V1))
+                   .margin(1e-2));
+    } else {
+        // The lower tip of the spinning edge reaches the x-axis when
+        // t + sin(πt) = 1/2 (i.e., t ≈ 0.1229).
+        CHECK(toi <= 0.1229);
+        CHECK(toi > 0.05);
+    }
+
+    CHECK_THROWS_AS(
+        build_rigid_trajectories(
+            bodies, Eigen::VectorXi::Constant(4, 2), points),
+        std::out_of_range);
+}
+
+TEST_CASE(
+    "Nonlinear collision-free stepsize", "[ccd][nonlinear][rigid][ipc]")
+{
+    // A static edge on the x-axis and an edge above it
+    Eigen::MatrixXd points(4, 2);
+    points << -1, 0, 1, 0, -1, 0, 1, 0;
+    Eigen::VectorXi body_ids(4);
+    body_ids << 0, 0, 1, 1;
+    Eigen::MatrixXi edges(2, 2);
+    edges << 0, 1, 2, 3;
+
+    // The upper edge makes a full turn about its center, so its start and end
+    // positions coincide and a linear CCD sees no motion at all.
+    const std::vector<std::shared_ptr<const RigidBodyMotion>> bodies {
+        std::make_shared<RigidBodyMotion>(
+            Eigen::Vector2d::Zero(), Eigen::Vector2d::Zero(),
+            Eigen::Matrix2d::Identity(), Eigen::VectorXd::Zero(1)),
+        std::make_shared<RigidBodyMotion>(
+            Eigen::Vector2d(0, 0.5), Eigen::Vector2d(0, 0.5),
+            Eigen::Matrix2d::Identity(),
+            Eigen::VectorXd::Constant(1, 2 * igl::PI)),
+    };
+
+    const std::vector<RigidTrajectory> trajectories =
+        build_rigid_trajectories(bodies, body_ids, points);
+    std::vector<const NonlinearTrajectory*> trajectory_ptrs;
+    Eigen::MatrixXd V0(4, 2), V1(4, 2);
+    for (int i = 0; i < 4; i++) {
+        trajectory_ptrs.push_back(&trajectories[i]);
+        V0.row(i) = trajectories[i](0).transpose();
+        V1.row(i) = trajectories[i](1).transpose();
+    }
+    CHECK((V0 - V1).norm() < 1e-12);
+
+    const CollisionMesh mesh(V0, edges);
+    CHECK(compute_collision_free_stepsize(mesh, V0, V1) == 1.0);
+
+    // The tips of the spinning edge reach the x-axis at t = 1/12.
+    const double toi =
+        compute_collision_free_stepsize(mesh, trajectory_ptrs);
+    CHECK(toi <= 1.0 / 12.0);
+    CHECK(toi > 0.05);
+
+    // The sampled swept bounds enclose the whole trajectory.
+    Candidates candidates;
+    candidates.build(mesh, trajectory_ptrs);
+    CHECK(candidates.size() == 4);
+}
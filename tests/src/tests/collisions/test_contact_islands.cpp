@@ -0,0 +1,100 @@
+#include <tests/utils.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <ipc/candidates/candidates.hpp>
+#include <ipc/collisions/contact_islands.hpp>
+#include <ipc/collisions/normal/normal_collisions.hpp>
+#include <ipc/potentials/barrier_potential.hpp>
+
+#include <igl/edges.h>
+
+using namespace ipc;
+
+TEST_CASE("Contact islands from candidates", "[collisions][islands]")
+{
+    // Three disjoint triangles
+    Eigen::MatrixXd vertices(9, 3);
+    vertices << 0, 0, 0, 1, 0, 0, 0, 1, 0, //
+        0, 0, 1, 1, 0, 1, 0, 1, 1,         //
+        5, 0, 0, 6, 0, 0, 5, 1, 0;
+    Eigen::MatrixXi faces(3, 3);
+    faces << 0, 1, 2, 3, 4, 5, 6, 7, 8;
+    Eigen::MatrixXi edges;
+    igl::edges(faces, edges);
+
+    CollisionMesh mesh(vertices, edges, faces);
+
+    ContactIslands islands;
+
+    SECTION("No contacts")
+    {
+        islands.build(mesh, Candidates());
+        CHECK(islands.num_islands() == 3);
+        CHECK(islands.stencil_island_ids().size() == 0);
+    }
+
+    SECTION("Triangle 0 touches triangle 1")
+    {
+        Candidates candidates;
+        candidates.fv_candidates.emplace_back(0, 3);
+        islands.build(mesh, candidates);
+
+        Eigen::VectorXi expected_vertex_ids(9);
+        expected_vertex_ids << 0, 0, 0, 0, 0, 0, 1, 1, 1;
+
+        CHECK(islands.num_islands() == 2);
+        CHECK(islands.vertex_island_ids() == expected_vertex_ids);
+        REQUIRE(islands.stencil_island_ids().size() == 1);
+        CHECK(islands.stencil_island_ids()[0] == 0);
+        CHECK(islands.stencil_ids(0) == std::vector<size_t> { { 0 } });
+        CHECK(islands.stencil_ids(1).empty());
+        CHECK_THROWS_AS(islands.stencil_ids(2), std::out_of_range);
+    }
+
+    islands.clear();
+    CHECK(islands.num_islands() == 0);
+}
+
+TEST_CASE("Island-restricted potential", "[collisions][islands][potential]")
+{
+    constexpr double dhat = 1e-1;
+
+    Eigen::MatrixXd vertices;
+    Eigen::MatrixXi edges, faces;
+    REQUIRE(tests::load_mesh("two-cubes-close.ply", vertices, edges, faces));
+
+    CollisionMesh mesh =
+        CollisionMesh::build_from_full_mesh(vertices, edges, faces);
+    vertices = mesh.vertices(vertices);
+
+    NormalCollisions collisions;
+    collisions.build(mesh, vertices, dhat);
+    REQUIRE(collisions.size() > 0);
+
+    ContactIslands islands;
+    islands.build(mesh, collisions);
+    REQUIRE(islands.num_islands() >= 1);
+
+    const BarrierPotential potential(dhat);
+
+    double energy = 0;
+    Eigen::VectorXd grad = Eigen::VectorXd::Zero(vertices.size());
+    Eigen::SparseMatrix<double> hess(vertices.size(), vertices.size());
+    for (int i = 0; i < islands.num_islands(); i++) {
+        const std::vector<size_t> ids = islands.stencil_ids(i);
+        for (const size_t ci : ids) {
+            CHECK(islands.stencil_island_ids()[ci] == i);
+        }
+        energy += potential(collisions, mesh, vertices, ids);
+        grad += potential.gradient(collisions, mesh, vertices, ids);
+        hess += potential.hessian(collisions, mesh, vertices, ids);
+    }
+
+    CHECK(energy == Catch::Approx(potential(collisions, mesh, vertices)));
+    CHECK(grad.isApprox(potential.gradient(collisions, mesh, vertices)));
+    CHECK(
+        Eigen::MatrixXd(hess).isApprox(
+            Eigen::MatrixXd(potential.hessian(collisions, mesh, vertices))));
+}
@@ -4,9 +4,12 @@
 #include <catch2/catch_approx.hpp>
 
 #include <ipc/collisions/normal/normal_collisions.hpp>
+#include <ipc/implicits/sdf.hpp>
 #include <ipc/potentials/barrier_potential.hpp>
 
+#include <finitediff.hpp>
 #include <igl/edges.h>
+#include <tbb/global_control.h>
 
 using namespace ipc;
 
@@ -294,6 +297,65 @@ TEST_CASE("Plane-Vertex NormalCollision", "[collision][plane-vertex]")
         == 2 * n * n.transpose());
 }
 
+TEST_CASE("SDF-Vertex NormalCollision", "[collision][sdf-vertex]")
+{
+    // Sphere of radius 0.5 sampled on a grid enclosing it
+    const auto sphere = [](Eigen::ConstRef<VectorMax3d> x) {
+        return x.norm() - 0.5;
+    };
+    const auto sdf = std::make_shared<GridSDF>(
+        Eigen::Vector3d::Constant(-0.6), 0.02, Eigen::Vector3i::Constant(61),
+        sphere);
+    CHECK(sdf->lipschitz_constant() >= 1);
+
+    Eigen::MatrixXi edges, faces;
+    const SDFVertexNormalCollision c(sdf, 0);
+    CHECK(c.num_vertices() == 1);
+    CHECK(
+        c.vertex_ids(edges, faces)
+        == std::array<long, 4> { { 0, -1, -1, -1 } });
+    CHECK(c.vertex_id == 0);
+
+    // Inside and outside of the grid
+    const Eigen::Vector3d point = GENERATE(
+        Eigen::Vector3d(0.31, 0.42, -0.13), Eigen::Vector3d(0.9, -0.23, 0.1),
+        Eigen::Vector3d(-0.75, 0.8, 0.43));
+    CAPTURE(point.transpose());
+
+    const double d = sdf->value(point);
+    if (sdf->contains(point)) {
+        CHECK(d == Catch::Approx(sphere(point)).margin(1e-3));
+    }
+    CHECK(c.compute_distance(point) == Catch::Approx(d * d));
+
+    Eigen::VectorXd fgrad;
+    fd::finite_gradient(
+        point, [&](const Eigen::VectorXd& x) { return c.compute_distance(x); },
+        fgrad);
+    CHECK(fd::compare_gradient(c.compute_distance_gradient(point), fgrad));
+
+    Eigen::MatrixXd fhess;
+    fd::finite_jacobian(
+        point,
+        [&](const Eigen::VectorXd& x) -> Eigen::VectorXd {
+            return c.compute_distance_gradient(x);
+        },
+        fhess);
+    CHECK(fd::compare_hessian(c.compute_distance_hessian(point), fhess, 1e-3));
+
+    // Batched queries match the single queries
+    std::vector<SDFVertexNormalCollision> sv_collisions;
+    const Eigen::MatrixXd points = Eigen::MatrixXd::Random(100, 3);
+    const Eigen::VectorXd values = sdf->values(points);
+    size_t expected_num_collisions = 0;
+    for (int i = 0; i < points.rows(); i++) {
+        CHECK(values[i] == sdf->value(points.row(i)));
+        expected_num_collisions += std::abs(values[i]) < 0.1;
+    }
+    construct_point_sdf_collisions(points, sdf, 0.1, sv_collisions);
+    CHECK(sv_collisions.size() == expected_num_collisions);
+}
+
 TEST_CASE("NormalCollisions::is_*", "[collisions]")
 {
     NormalCollisions collisions;
@@ -303,6 +365,11 @@ TEST_CASE("NormalCollisions::is_*", "[collisions]")
     collisions.fv_collisions.emplace_back(0, 1);
     collisions.pv_collisions.emplace_back(
         Eigen::Vector3d(0, 0, 0), Eigen::Vector3d(0, 1, 0), 0);
+    collisions.sv_collisions.emplace_back(
+        std::make_shared<GridSDF>(
+            Eigen::Vector3d::Zero(), 1.0, Eigen::Vector3i::Constant(2),
+            Eigen::VectorXd::Zero(8)),
+        0);
 
     for (int i = 0; i < collisions.size(); i++) {
         CHECK(collisions.is_vertex_vertex(i) == (i == 0));
@@ -310,6 +377,7 @@ TEST_CASE("NormalCollisions::is_*", "[collisions]")
         CHECK(collisions.is_edge_edge(i) == (i == 2));
         CHECK(collisions.is_face_vertex(i) == (i == 3));
         CHECK(collisions.is_plane_vertex(i) == (i == 4));
+        CHECK(collisions.is_sdf_vertex(i) == (i == 5));
     }
 }
 
@@ -361,4 +429,194 @@ ee: 14=(24, 46) 456=(161, 205), w: -0.00297853, dtype: 0, d: 0.00538125
 ee: 346=(76, 128) 718=(236, 261), w: -0.00328539, dtype: 5, d: 0.00717647
 fv: 17=(46, 24, 72) 205, w: 0.0137957, d: 0.00500269
 fv: 471=(155, 238, 259) 64, w: 0.0160469, d: 0.00639199)ipc_Qu8mg5v7");
-}
\ No newline at end of file
+}
+
+TEST_CASE("NormalCollisions merge", "[collisions][merge]")
+{
+    const double dhat = 1e-1;
+
+    Eigen::MatrixXd vertices;
+    Eigen::MatrixXi edges, faces;
+    const bool success =
+        tests::load_mesh("two-cubes-close.ply", vertices, edges, faces);
+    REQUIRE(success);
+
+    CollisionMesh mesh(vertices, edges, faces);
+    mesh.init_area_jacobians();
+
+    const auto build = [&](const int num_threads) {
+        tbb::global_control thread_limiter(
+            tbb::global_control::max_allowed_parallelism, num_threads);
+        NormalCollisions collisions;
+        collisions.set_use_area_weighting(true);
+        collisions.set_use_improved_max_approximator(true);
+        collisions.set_enable_shape_derivatives(true);
+        collisions.build(mesh, vertices, dhat);
+        return collisions;
+    };
+
+    const NormalCollisions serial_collisions = build(1);
+    const NormalCollisions parallel_collisions = build(
+        int(tbb::global_control::active_value(
+            tbb::global_control::max_allowed_parallelism)));
+
+    // The merged collisions are sorted, unique, and have non-zero weights.
+    const auto check_merged = [](const auto& collisions) {
+        for (size_t i = 0; i < collisions.size(); i++) {
+            CHECK(collisions[i].weight != 0);
+            if (i > 0) {
+                CHECK(collisions[i - 1] < collisions[i]);
+            }
+        }
+    };
+    check_merged(parallel_collisions.vv_collisions);
+    check_merged(parallel_collisions.ev_collisions);
+    check_merged(parallel_collisions.ee_collisions);
+
+    // The result does not depend on how the collisions are split among
+    // threads.
+    const auto check_equal = [](const auto& expected, const auto& actual) {
+        REQUIRE(expected.size() == actual.size());
+        for (size_t i = 0; i < expected.size(); i++) {
+            CHECK(expected[i] == actual[i]);
+            CHECK(expected[i].weight == Catch::Approx(actual[i].weight));
+        }
+    };
+    check_equal(
+        serial_collisions.vv_collisions, parallel_collisions.vv_collisions);
+    check_equal(
+        serial_collisions.ev_collisions, parallel_collisions.ev_collisions);
+    check_equal(
+        serial_collisions.ee_collisions, parallel_collisions.ee_collisions);
+    CHECK(
+        serial_collisions.fv_collisions.size()
+        == parallel_collisions.fv_collisions.size());
+
+    // The weight gradients are merged along with the collisions.
+    REQUIRE(
+        serial_collisions.weight_gradients.size() == serial_collisions.size());
+    REQUIRE(
+        parallel_collisions.weight_gradients.size()
+        == parallel_collisions.size());
+    const size_t num_reduced = serial_collisions.vv_collisions.size()
+        + serial_collisions.ev_collisions.size()
+        + serial_collisions.ee_collisions.size();
+    for (size_t i = 0; i < num_reduced; i++) {
+        const Eigen::VectorXd expected =
+            Eigen::VectorXd(serial_collisions.weight_gradients[i]);
+        const Eigen::VectorXd actual =
+            Eigen::VectorXd(parallel_collisions.weight_gradients[i]);
+        CHECK((expected - actual).norm() <= 1e-12 * (1 + expected.norm()));
+    }
+}
+
+TEST_CASE("WeightGradients", "[collisions][shape_derivative]")
+{
+    constexpr int ndof = 12;
+
+    Eigen::SparseVector<double> a(ndof), b(ndof);
+    a.insert(1) = 2.0;
+    a.insert(7) = -1.0;
+    b.insert(3) = 4.0;
+
+    WeightGradients weight_gradients;
+    weight_gradients.reset(ndof);
+    CHECK(weight_gradients.empty());
+
+    weight_gradients.push_back(a);
+    weight_gradients.append_zeros(1);
+    weight_gradients.append({ b, a });
+
+    REQUIRE(weight_gradients.size() == 4);
+    CHECK(weight_gradients.ndof() == ndof);
+    CHECK(weight_gradients.nonZeros() == 5);
+
+    const auto check_row = [&](const WeightGradients& table, size_t i,
+                               const Eigen::SparseVector<double>& expected) {
+        const Eigen::SparseVector<double> row = table[i];
+        CHECK(row.size() == ndof);
+        CHECK(row.nonZeros() == expected.nonZeros());
+        CHECK(Eigen::VectorXd(row) == Eigen::VectorXd(expected));
+        CHECK(table.indices(i).size() == expected.nonZeros());
+        CHECK(table.values(i).size() == expected.nonZeros());
+    };
+    check_row(weight_gradients, 0, a);
+    check_row(weight_gradients, 1, Eigen::SparseVector<double>(ndof));
+    check_row(weight_gradients, 2, b);
+    check_row(weight_gradients, 3, a);
+
+    WeightGradients copy;
+    copy.reset(ndof);
+    copy.push_back(weight_gradients, 2);
+    copy.push_back(weight_gradients, 1);
+    REQUIRE(copy.size() == 2);
+    check_row(copy, 0, b);
+    check_row(copy, 1, Eigen::SparseVector<double>(ndof));
+
+    weight_gradients.clear();
+    CHECK(weight_gradients.empty());
+    CHECK(weight_gradients.nonZeros() == 0);
+    CHECK(weight_gradients.ndof() == ndof);
+}
+
+TEST_CASE("NormalCollisions::update", "[collisions][update]")
+{
+    const double dhat = 1e-1;
+    const double dmin = GENERATE(0.0, 1e-2);
+    const bool use_improved_max_approximator = GENERATE(false, true);
+
+    Eigen::MatrixXd vertices;
+    Eigen::MatrixXi edges, faces;
+    const bool success =
+        tests::load_mesh("two-cubes-close.ply", vertices, edges, faces);
+    REQUIRE(success);
+
+    CollisionMesh mesh(vertices, edges, faces);
+
+    // Inflate the candidates so they still contain all close pairs.
+    Candidates candidates;
+    candidates.build(mesh, vertices, 0.5 * (dhat + dmin) + 0.05);
+
+    NormalCollisions collisions;
+    collisions.set_use_area_weighting(true);
+    collisions.set_use_improved_max_approximator(use_improved_max_approximator);
+    collisions.set_enable_updates(true);
+    collisions.build(candidates, mesh, vertices, dhat, dmin);
+
+    // Squeeze the cubes together with decreasing steps.
+    const double z_mid = vertices.col(2).mean();
+    for (const double step : { 1e-2, 1e-2, 1e-4, 0.0 }) {
+        for (int i = 0; i < vertices.rows(); i++) {
+            vertices(i, 2) += vertices(i, 2) > z_mid ? -step : step;
+        }
+
+        collisions.update(mesh, vertices);
+
+        NormalCollisions rebuilt_collisions;
+        rebuilt_collisions.set_use_area_weighting(true);
+        rebuilt_collisions.set_use_improved_max_approximator(
+            use_improved_max_approximator);
+        rebuilt_collisions.build(candidates, mesh, vertices, dhat, dmin);
+
+        const auto check_equal = [](auto actual, auto expected) {
+            std::sort(actual.begin(), actual.end());
+            std::sort(expected.begin(), expected.end());
+            REQUIRE(expected.size() == actual.size());
+            for (size_t i = 0; i < expected.size(); i++) {
+                CHECK(expected[i] == actual[i]);
+                CHECK(expected[i].weight == Catch::Approx(actual[i].weight));
+                CHECK(expected[i].dmin == actual[i].dmin);
+            }
+        };
+        check_equal(collisions.vv_collisions, rebuilt_collisions.vv_collisions);
+        check_equal(collisions.ev_collisions, rebuilt_collisions.ev_collisions);
+        check_equal(collisions.ee_collisions, rebuilt_collisions.ee_collisions);
+        check_equal(collisions.fv_collisions, rebuilt_collisions.fv_collisions);
+    }
+
+    // Enabling updates after the build leaves nothing to update from.
+    NormalCollisions late_collisions;
+    late_collisions.build(candidates, mesh, vertices, dhat, dmin);
+    late_collisions.set_enable_updates(true);
+    CHECK_THROWS_AS(late_collisions.update(mesh, vertices), std::runtime_error);
+}
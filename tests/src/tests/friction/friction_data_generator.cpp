@@ -56,7 +56,6 @@ FrictionData friction_data_generator()
         REQUIRE(E.rows() == 3);
 
         collisions.fv_collisions.emplace_back(0, 0);
-        collisions.fv_collisions.back().weight_gradient.resize(V0.size());
     }
     SECTION("edge-edge")
     {
@@ -76,7 +75,6 @@ FrictionData friction_data_generator()
         E.row(1) << 2, 3;
 
         collisions.ee_collisions.emplace_back(0, 1, 0.0);
-        collisions.ee_collisions.back().weight_gradient.resize(V0.size());
     }
     SECTION("point-edge")
     {
@@ -93,7 +91,6 @@ FrictionData friction_data_generator()
         E.row(0) << 1, 2;
 
         collisions.ev_collisions.emplace_back(0, 1);
-        collisions.ev_collisions.back().weight_gradient.resize(V0.size());
     }
     SECTION("point-point")
     {
@@ -107,7 +104,6 @@ FrictionData friction_data_generator()
         V1.row(1) << -0.5, d, 0; // edge a vertex 1 at t=1
 
         collisions.vv_collisions.emplace_back(0, 1);
-        collisions.vv_collisions.back().weight_gradient.resize(V0.size());
     }
     SECTION("point-edge 2D")
     {
@@ -124,7 +120,6 @@ FrictionData friction_data_generator()
         E.row(0) << 1, 2;
 
         collisions.ev_collisions.emplace_back(0, 1);
-        collisions.ev_collisions.back().weight_gradient.resize(V0.size());
     }
     SECTION("point-point 2D")
     {
@@ -138,8 +133,11 @@ FrictionData friction_data_generator()
         V1.row(1) << -0.5, d; // edge a vertex 1 at t=1
 
         collisions.vv_collisions.emplace_back(0, 1);
-        collisions.vv_collisions.back().weight_gradient.resize(V0.size());
     }
 
+    // Zero weight gradients so the shape derivatives can be computed.
+    collisions.weight_gradients.reset(V0.size());
+    collisions.weight_gradients.append_zeros(collisions.size());
+
     return data;
 }
\ No newline at end of file
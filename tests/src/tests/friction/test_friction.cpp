@@ -247,3 +247,47 @@ TEST_CASE(
 
     CHECK(hess.isApprox(expected_hess));
 }
+
+TEST_CASE(
+    "Tangential collision cached distance type", "[friction][distance_type]")
+{
+    // Vertex 0 is above the edge (1, 2) and the face (1, 2, 3).
+    Eigen::MatrixXd V(4, 3);
+    V << 0.25, 0.1, 0.25, //
+        0, 0, 0,          //
+        1, 0, 0,          //
+        0, 0, 1;
+    Eigen::MatrixXi E(1, 2), F(1, 3);
+    E << 1, 2;
+    F << 1, 2, 3;
+
+    SECTION("Edge-vertex")
+    {
+        const EdgeVertexNormalCollision normal_collision(0, 0);
+        const EdgeVertexTangentialCollision collision(normal_collision);
+        CHECK(collision.dtype == PointEdgeDistanceType::P_E);
+        CHECK(collision.known_dtype() == normal_collision.known_dtype());
+        CHECK(
+            collision.compute_distance(V, E, F)
+            == normal_collision.compute_distance(V, E, F));
+
+        CHECK(
+            EdgeVertexTangentialCollision(0, 0).known_dtype()
+            == PointEdgeDistanceType::AUTO);
+    }
+
+    SECTION("Face-vertex")
+    {
+        const FaceVertexNormalCollision normal_collision(0, 0);
+        const FaceVertexTangentialCollision collision(normal_collision);
+        CHECK(collision.dtype == PointTriangleDistanceType::P_T);
+        CHECK(collision.known_dtype() == normal_collision.known_dtype());
+        CHECK(
+            collision.compute_distance(V, E, F)
+            == normal_collision.compute_distance(V, E, F));
+
+        CHECK(
+            FaceVertexTangentialCollision(0, 0).known_dtype()
+            == PointTriangleDistanceType::AUTO);
+    }
+}
@@ -299,7 +299,8 @@ TEST_CASE(
     for (int i = 0; i < collisions.size(); i++) {
         std::vector<Eigen::Triplet<double>> triplets;
         barrier_potential.shape_derivative(
-            collisions[i], collisions[i].vertex_ids(edges, faces),
+            collisions[i], collisions.weight_gradients[i],
+            collisions[i].vertex_ids(edges, faces),
             collisions[i].dof(rest_positions, edges, faces),
             collisions[i].dof(vertices, edges, faces), triplets);
         Eigen::SparseMatrix<double> JF_wrt_X_sparse(ndof, ndof);
@@ -359,7 +360,8 @@ TEST_CASE(
     for (int i = 0; i < collisions.size(); i++) {
         std::vector<Eigen::Triplet<double>> triplets;
         barrier_potential.shape_derivative(
-            collisions[i], collisions[i].vertex_ids(edges, faces),
+            collisions[i], collisions.weight_gradients[i],
+            collisions[i].vertex_ids(edges, faces),
             collisions[i].dof(rest_positions, edges, faces),
             collisions[i].dof(vertices, edges, faces), triplets);
         Eigen::SparseMatrix<double> JF_wrt_X_sparse(ndof, ndof);
@@ -568,3 +570,189 @@ TEST_CASE(
             barrier_potential.shape_derivative(collisions, mesh, vertices);
     };
 }
+
+TEST_CASE(
+    "Barrier potential cumulative evaluations",
+    "[potential][barrier_potential][evaluate][gradient][hessian]")
+{
+    const bool use_area_weighting = GENERATE(true, false);
+
+    Eigen::MatrixXd vertices;
+    Eigen::MatrixXi edges, faces;
+    REQUIRE(tests::load_mesh("two-cubes-close.ply", vertices, edges, faces));
+
+    const CollisionMesh mesh =
+        CollisionMesh::build_from_full_mesh(vertices, edges, faces);
+    vertices = mesh.vertices(vertices);
+
+    const double dhat = 1e-1;
+    NormalCollisions collisions;
+    collisions.set_use_area_weighting(use_area_weighting);
+    collisions.set_enable_shape_derivatives(true);
+    collisions.build(mesh, vertices, dhat);
+    REQUIRE(collisions.size() > 0);
+
+    const BarrierPotential barrier_potential(dhat);
+    const PSDProjectionMethod psd_method = GENERATE(
+        PSDProjectionMethod::NONE, PSDProjectionMethod::CLAMP,
+        PSDProjectionMethod::ABS);
+
+    const Eigen::VectorXd expected_grad =
+        barrier_potential.gradient(collisions, mesh, vertices);
+    const Eigen::SparseMatrix<double> expected_hess =
+        barrier_potential.hessian(collisions, mesh, vertices, psd_method);
+
+    // Same collisions at different positions
+    const Eigen::MatrixXd perturbed_vertices =
+        vertices + 1e-4 * Eigen::MatrixXd::Random(vertices.rows(), 3);
+
+    // A different active set
+    NormalCollisions new_collisions;
+    new_collisions.build(mesh, vertices, dhat / 2);
+
+    SECTION("Fused evaluation")
+    {
+        const double expected_energy =
+            barrier_potential(collisions, mesh, vertices);
+
+        PotentialEvaluation result = barrier_potential.evaluate(
+            collisions, mesh, vertices, EvaluationFlags::ALL, psd_method);
+        CHECK(result.energy == Catch::Approx(expected_energy));
+        CHECK(result.gradient.isApprox(expected_grad));
+        CHECK(result.hessian.isApprox(expected_hess));
+
+        result = barrier_potential.evaluate(
+            collisions, mesh, vertices, EvaluationFlags::GRADIENT);
+        CHECK(result.energy == 0);
+        CHECK(result.gradient.isApprox(expected_grad));
+        CHECK(result.hessian.nonZeros() == 0);
+
+        result = barrier_potential.evaluate(
+            collisions, mesh, vertices,
+            EvaluationFlags::ENERGY | EvaluationFlags::HESSIAN, psd_method);
+        CHECK(result.energy == Catch::Approx(expected_energy));
+        CHECK(result.gradient.size() == 0);
+        CHECK(result.hessian.isApprox(expected_hess));
+
+        // Restricted to a subset of the collisions
+        std::vector<size_t> collision_ids;
+        for (size_t i = 0; i < collisions.size(); i += 2) {
+            collision_ids.push_back(i);
+        }
+        result = barrier_potential.evaluate(
+            collisions, mesh, vertices, collision_ids, EvaluationFlags::ALL,
+            psd_method);
+        CHECK(
+            result.energy
+            == Catch::Approx(
+                barrier_potential(collisions, mesh, vertices, collision_ids)));
+        CHECK(result.gradient.isApprox(barrier_potential.gradient(
+            collisions, mesh, vertices, collision_ids)));
+        CHECK(result.hessian.isApprox(barrier_potential.hessian(
+            collisions, mesh, vertices, collision_ids, psd_method)));
+    }
+
+    SECTION("Hessian with reused pattern")
+    {
+        HessianPattern pattern;
+        CHECK(barrier_potential
+                  .hessian(collisions, mesh, vertices, pattern, psd_method)
+                  .isApprox(expected_hess));
+        CHECK(pattern.num_stencils() == collisions.size());
+
+        // Only the values are refreshed.
+        const Eigen::SparseMatrix<double>& hess = barrier_potential.hessian(
+            collisions, mesh, perturbed_vertices, pattern, psd_method);
+        CHECK(&hess == &pattern.matrix());
+        CHECK(hess.isApprox(barrier_potential.hessian(
+            collisions, mesh, perturbed_vertices, psd_method)));
+
+        // The pattern is rebuilt.
+        CHECK(barrier_potential.hessian(new_collisions, mesh, vertices, pattern)
+                  .isApprox(barrier_potential.hessian(
+                      new_collisions, mesh, vertices)));
+        CHECK(pattern.num_stencils() == new_collisions.size());
+    }
+
+    SECTION("Hessian in BSR format")
+    {
+        const BlockSparseMatrix bsr_hess = barrier_potential.hessian_bsr(
+            collisions, mesh, vertices, psd_method);
+        CHECK(bsr_hess.rows() == expected_hess.rows());
+        CHECK(bsr_hess.block_size() == vertices.cols());
+        CHECK(Eigen::SparseMatrix<double>(bsr_hess.to_csr())
+                  .isApprox(expected_hess));
+
+        const Eigen::VectorXd x =
+            Eigen::VectorXd::Random(expected_hess.cols());
+        CHECK((bsr_hess * x).isApprox(expected_hess * x));
+
+        const BlockSparseMatrix bsr_shape_derivative =
+            barrier_potential.shape_derivative_bsr(collisions, mesh, vertices);
+        CHECK(Eigen::SparseMatrix<double>(bsr_shape_derivative.to_csr())
+                  .isApprox(barrier_potential.shape_derivative(
+                      collisions, mesh, vertices)));
+    }
+
+    SECTION("Hessian-vector product")
+    {
+        const Eigen::VectorXd p =
+            Eigen::VectorXd::Random(expected_hess.cols());
+        const Eigen::VectorXd expected = expected_hess * p;
+
+        CHECK(barrier_potential
+                  .hessian_vector_product(
+                      collisions, mesh, vertices, p, psd_method)
+                  .isApprox(expected));
+
+        const HessianOperator hess_op = barrier_potential.hessian_operator(
+            collisions, mesh, vertices, psd_method);
+        CHECK(hess_op.rows() == expected_hess.rows());
+        CHECK(hess_op.num_stencils() == collisions.size());
+        CHECK((hess_op * p).isApprox(expected));
+    }
+
+    SECTION("Hessian diagonal")
+    {
+        const Eigen::MatrixXd hess = Eigen::MatrixXd(expected_hess);
+
+        const Eigen::VectorXd diag = barrier_potential.hessian_diagonal(
+            collisions, mesh, vertices, psd_method);
+        CHECK(diag.isApprox(hess.diagonal()));
+
+        const int dim = vertices.cols();
+        const Eigen::MatrixXd blocks = barrier_potential.hessian_block_diagonal(
+            collisions, mesh, vertices, psd_method);
+        REQUIRE(blocks.rows() == hess.rows());
+        REQUIRE(blocks.cols() == dim);
+        for (int i = 0; i < vertices.rows(); i++) {
+            CHECK(
+                (blocks.middleRows(dim * i, dim)
+                 - hess.block(dim * i, dim * i, dim, dim))
+                    .norm()
+                <= 1e-12 * hess.norm());
+        }
+    }
+
+    SECTION("Gradient with gradient scatter")
+    {
+        GradientScatter scatter;
+        CHECK(barrier_potential.gradient(collisions, mesh, vertices, scatter)
+                  .isApprox(expected_grad));
+        CHECK(scatter.num_stencils() == collisions.size());
+
+        // The scatter is reused.
+        const Eigen::VectorXd& grad = barrier_potential.gradient(
+            collisions, mesh, perturbed_vertices, scatter);
+        CHECK(&grad == &scatter.vector());
+        CHECK(grad.isApprox(
+            barrier_potential.gradient(collisions, mesh, perturbed_vertices)));
+
+        // The scatter is rebuilt.
+        CHECK(
+            barrier_potential.gradient(new_collisions, mesh, vertices, scatter)
+                .isApprox(barrier_potential.gradient(
+                    new_collisions, mesh, vertices)));
+        CHECK(scatter.num_stencils() == new_collisions.size());
+    }
+}
@@ -3,6 +3,7 @@
 #include <tests/utils.hpp>
 
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
 
 #include <ipc/collisions/tangential/tangential_collisions.hpp>
 #include <ipc/potentials/friction_potential.hpp>
@@ -43,4 +44,59 @@ TEST_CASE("Friction gradient and hessian", "[friction][gradient][hessian]")
     Eigen::MatrixXd fhess;
     fd::finite_hessian(fd::flatten(V1), f, fhess);
     CHECK(fd::compare_hessian(hess, fhess, 1e-3));
-}
\ No newline at end of file
+}
+
+TEST_CASE("Friction fused evaluation", "[friction][evaluate]")
+{
+    FrictionData data = friction_data_generator();
+    const auto& [V0, V1, E, F, collisions, mu, epsv_times_h, dhat, barrier_stiffness] =
+        data;
+
+    const Eigen::MatrixXd U = V1 - V0;
+
+    const CollisionMesh mesh(V0, E, F);
+
+    TangentialCollisions tangential_collisions;
+    tangential_collisions.build(
+        mesh, V0, collisions, BarrierPotential(dhat), barrier_stiffness, mu);
+
+    const FrictionPotential D(epsv_times_h);
+    const PSDProjectionMethod psd_method =
+        GENERATE(PSDProjectionMethod::NONE, PSDProjectionMethod::CLAMP);
+
+    const PotentialEvaluation result = D.evaluate(
+        tangential_collisions, mesh, U, EvaluationFlags::ALL, psd_method);
+
+    CHECK(result.energy == Catch::Approx(D(tangential_collisions, mesh, U)));
+    CHECK(result.gradient.isApprox(D.gradient(tangential_collisions, mesh, U)));
+    CHECK(result.hessian.isApprox(
+        D.hessian(tangential_collisions, mesh, U, psd_method)));
+}
+
+TEST_CASE("Friction force with gradient scatter", "[friction][force][scatter]")
+{
+    FrictionData data = friction_data_generator();
+    const auto& [V0, V1, E, F, collisions, mu, epsv_times_h, dhat, barrier_stiffness] =
+        data;
+
+    const Eigen::MatrixXd U = V1 - V0;
+
+    const CollisionMesh mesh(V0, E, F);
+
+    const BarrierPotential B(dhat);
+    TangentialCollisions tangential_collisions;
+    tangential_collisions.build(mesh, V0, collisions, B, barrier_stiffness, mu);
+
+    const FrictionPotential D(epsv_times_h);
+
+    const Eigen::VectorXd force = D.force(
+        tangential_collisions, mesh, V0, U, U, B, barrier_stiffness);
+
+    GradientScatter scatter;
+    CHECK(D.force(
+               tangential_collisions, mesh, V0, U, U, B, barrier_stiffness,
+               scatter)
+              .isApprox(force));
+    CHECK(D.gradient(tangential_collisions, mesh, U, scatter)
+              .isApprox(D.gradient(tangential_collisions, mesh, U)));
+}
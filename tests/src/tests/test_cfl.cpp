@@ -1,5 +1,6 @@
 #include <tests/utils.hpp>
 
+#include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
 
 #include <ipc/ipc.hpp>
@@ -40,4 +41,58 @@ TEST_CASE("Compute CFL stepsize", "[ccd][cfl]")
         ipc::compute_collision_free_stepsize(mesh, V0, V1);
 
     CHECK(cfl_step_size <= ccd_step_size);
+
+    // The incremental mode extends the candidates with every pair that can
+    // collide before the step size, so it agrees with the full CCD.
+    const size_t num_candidates = candidates.size();
+    const double incremental_step_size =
+        candidates.compute_incremental_cfl_stepsize(mesh, V0, V1, dhat);
+    CHECK(incremental_step_size <= Catch::Approx(ccd_step_size));
+    CHECK(candidates.size() >= num_candidates);
+    CHECK(
+        candidates.compute_collision_free_stepsize(mesh, V0, V1)
+        == Catch::Approx(incremental_step_size));
+}
+
+TEST_CASE("Incremental CFL stepsize with can_collide", "[ccd][cfl]")
+{
+    // Edge a = (0, 1) rotates about its slow vertex 1 through edge b = (2, 3).
+    Eigen::MatrixXd V0(4, 3), V1;
+    V0 << 0, 1, 0, //
+        1, 0.5, 0, //
+        0.5, 0, -1, //
+        0.5, 0, 1;
+    V1 = V0;
+    V1.row(0) << 0, -1, 0;
+    Eigen::MatrixXi E(2, 2);
+    E << 0, 1, //
+        2, 3;
+    const Eigen::MatrixXi F;
+
+    // The fast vertex cannot collide with anything, but the edges can collide
+    // through the slow vertex 1.
+    CollisionMesh mesh(V0, E, F);
+    mesh.can_collide = [](size_t vi, size_t vj) { return vi != 0 && vj != 0; };
+
+    const double dhat = 1e-3;
+
+    Candidates candidates;
+    candidates.build(mesh, V0, dhat / 2);
+    CHECK(candidates.empty());
+
+    const double ccd_step_size =
+        ipc::compute_collision_free_stepsize(mesh, V0, V1);
+    CHECK(ccd_step_size < 1);
+
+    CHECK(
+        candidates.compute_incremental_cfl_stepsize(mesh, V0, V1, dhat)
+        == Catch::Approx(ccd_step_size));
+    CHECK(candidates.ee_candidates.size() == 1);
+
+    // The vertex filter of the broad phase is restored afterwards.
+    const auto broad_phase = make_default_broad_phase();
+    broad_phase->can_vertices_collide = [](size_t, size_t) { return false; };
+    candidates.compute_incremental_cfl_stepsize(
+        mesh, V0, V1, dhat, /*min_distance=*/0, broad_phase);
+    CHECK(!broad_phase->can_vertices_collide(2, 3));
 }
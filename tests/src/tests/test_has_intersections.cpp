@@ -96,3 +96,76 @@ TEST_CASE("Has intersections", "[intersection]")
     CAPTURE(broad_phase->name());
     CHECK(has_intersections(CollisionMesh(V, E, F), V, broad_phase));
 }
+
+TEST_CASE("Has intersections incremental", "[intersection]")
+{
+    Eigen::MatrixXd V_cube;
+    Eigen::MatrixXi E_cube, F_cube;
+    REQUIRE(tests::load_mesh("cube.ply", V_cube, E_cube, F_cube));
+    const double width = V_cube.col(0).maxCoeff() - V_cube.col(0).minCoeff();
+    const int n = V_cube.rows();
+
+    // Two cubes side by side (offset to avoid degenerate contacts)
+    Eigen::MatrixXd V0(2 * n, 3);
+    V0.topRows(n) = V_cube;
+    V0.bottomRows(n) = V_cube;
+    V0.bottomRows(n).rowwise() +=
+        width * Eigen::RowVector3d(1.5, 0.3, 0.2);
+    Eigen::MatrixXi F(2 * F_cube.rows(), 3);
+    F.topRows(F_cube.rows()) = F_cube;
+    F.bottomRows(F_cube.rows()) = F_cube.array() + n;
+    Eigen::MatrixXi E;
+    igl::edges(F, E);
+
+    const CollisionMesh mesh(V0, E, F);
+    const auto broad_phase = GENERATE(tests::BroadPhaseGenerator::create());
+    CAPTURE(broad_phase->name());
+
+    REQUIRE(!has_intersections(mesh, V0, broad_phase));
+
+    // Nothing moved
+    CHECK(!has_intersections(mesh, V0, V0, broad_phase));
+
+    // Move the second cube into the first one
+    Eigen::MatrixXd V1 = V0;
+    V1.bottomRows(n).col(0).array() -= width;
+    CHECK(has_intersections(mesh, V1, broad_phase));
+    CHECK(has_intersections(mesh, V1, V0, broad_phase));
+
+    // Move the first cube away from the second one
+    Eigen::MatrixXd V2 = V0;
+    V2.topRows(n).col(0).array() -= width;
+    CHECK(!has_intersections(mesh, V2, V0, broad_phase));
+}
+
+TEST_CASE("Has intersections incremental with can_collide", "[intersection]")
+{
+    // Edge (3, 4) moves through face (0, 1, 2), but only its fixed vertex 4 can
+    // collide with the face.
+    Eigen::MatrixXd V0(5, 3);
+    V0 << 0, 0, 0,     //
+        1, 0, 0,       //
+        0, 1, 0,       //
+        0.25, 0.25, 1, //
+        0.25, 0.25, 2;
+    Eigen::MatrixXi E(4, 2);
+    E << 0, 1, //
+        1, 2,  //
+        2, 0,  //
+        3, 4;
+    Eigen::MatrixXi F(1, 3);
+    F << 0, 1, 2;
+
+    CollisionMesh mesh(V0, E, F);
+    mesh.can_collide = [](size_t vi, size_t vj) { return vi != 3 && vj != 3; };
+
+    const auto broad_phase = GENERATE(tests::BroadPhaseGenerator::create());
+    CAPTURE(broad_phase->name());
+
+    REQUIRE(!has_intersections(mesh, V0, broad_phase));
+
+    Eigen::MatrixXd V1 = V0;
+    V1(3, 2) = -1;
+    CHECK(has_intersections(mesh, V1, broad_phase));
+    CHECK(has_intersections(mesh, V1, V0, broad_phase));
+}
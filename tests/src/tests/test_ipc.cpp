@@ -1,8 +1,10 @@
 #include <tests/utils.hpp>
 
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
 
 #include <ipc/ipc.hpp>
+#include <ipc/candidates/candidates.hpp>
 
 using namespace ipc;
 
@@ -17,4 +19,35 @@ TEST_CASE("Is step collision free", "[is_step_collision_free]")
 
     CHECK(is_step_collision_free(mesh, V0, V0));
     CHECK(!is_step_collision_free(mesh, V0, V1));
-}
\ No newline at end of file
+}
+
+TEST_CASE("Per-vertex collision free stepsize", "[per_vertex_stepsize]")
+{
+    Eigen::MatrixXd V0, V1;
+    Eigen::MatrixXi E, F;
+    REQUIRE(tests::load_mesh("two-cubes-close.ply", V0, E, F));
+    REQUIRE(tests::load_mesh("two-cubes-intersecting.ply", V1, E, F));
+
+    CollisionMesh mesh(V0, E, F);
+
+    Eigen::VectorXd stepsizes =
+        compute_per_vertex_collision_free_stepsize(mesh, V0, V0);
+    CHECK(stepsizes.size() == mesh.num_vertices());
+    CHECK((stepsizes.array() == 1.0).all());
+
+    stepsizes = compute_per_vertex_collision_free_stepsize(mesh, V0, V1);
+    CHECK(stepsizes.size() == mesh.num_vertices());
+    CHECK((stepsizes.array() >= 0.0).all());
+    CHECK((stepsizes.array() <= 1.0).all());
+
+    const double toi = compute_collision_free_stepsize(mesh, V0, V1);
+    CHECK(toi < 1.0);
+    CHECK(stepsizes.minCoeff() == Catch::Approx(toi).margin(1e-4));
+
+    Candidates candidates;
+    candidates.build(mesh, V0, V1);
+    const Eigen::VectorXd tois =
+        candidates.compute_per_candidate_toi(mesh, V0, V1);
+    CHECK(tois.size() == candidates.size());
+    CHECK(tois.minCoeff() == Catch::Approx(toi).margin(1e-4));
+}
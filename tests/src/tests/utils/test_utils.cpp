@@ -1,4 +1,7 @@
+#include <tests/utils.hpp>
+
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
 
 #include <ipc/candidates/vertex_vertex.hpp>
 #include <ipc/candidates/edge_vertex.hpp>
@@ -7,7 +10,10 @@
 #include <ipc/candidates/edge_face.hpp>
 #include <ipc/utils/logger.hpp>
 #include <ipc/utils/eigen_ext.hpp>
+#include <ipc/utils/block_sparse_matrix.hpp>
+#include <ipc/potentials/barrier_potential.hpp>
 #include <ipc/utils/save_obj.hpp>
+#include <ipc/utils/workspace.hpp>
 
 #include <spdlog/sinks/stdout_color_sinks.h>
 
@@ -118,4 +124,103 @@ TEST_CASE("Save OBJ of candidates", "[utils][save_obj]")
             ss.str()
             == "o EF\nv 1 0 0\nv 0 1 0\nv 1 0 0\nv 0 1 0\nv 0 0 1\nl 1 2\nf 3 4 5\n");
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Workspace", "[utils][workspace]")
+{
+    ipc::Workspace workspace;
+
+    // Buffers persist and are distinguished by type and id
+    std::vector<int>& buffer = workspace.get<std::vector<int>>();
+    buffer.resize(100);
+    CHECK(&workspace.get<std::vector<int>>() == &buffer);
+    CHECK(&workspace.get<std::vector<int>>(1) != &buffer);
+    CHECK(workspace.get<std::vector<int>>().size() == 100);
+    CHECK(workspace.size() == 2);
+
+    // Thread-local containers are cleared but keep their capacity
+    auto& storage = workspace.thread_local_storage<std::vector<int>>();
+    storage.local().resize(100);
+    auto& reused_storage = workspace.thread_local_storage<std::vector<int>>();
+    CHECK(&reused_storage == &storage);
+    CHECK(reused_storage.local().empty());
+    CHECK(reused_storage.local().capacity() >= 100);
+
+    workspace.clear();
+    CHECK(workspace.size() == 0);
+}
+
+TEST_CASE("Workspace reuse", "[utils][workspace]")
+{
+    Eigen::MatrixXd V;
+    Eigen::MatrixXi E, F;
+    REQUIRE(tests::load_mesh("two-cubes-close.ply", V, E, F));
+    const ipc::CollisionMesh mesh(V, E, F);
+
+    const double dhat = 1e-1;
+    const ipc::BarrierPotential barrier_potential(dhat);
+    const auto broad_phase = GENERATE(tests::BroadPhaseGenerator::create());
+    CAPTURE(broad_phase->name());
+
+    ipc::NormalCollisions collisions;
+    collisions.build(mesh, V, dhat, /*dmin=*/0, broad_phase);
+    REQUIRE(!collisions.empty());
+    const double expected_energy = barrier_potential(collisions, mesh, V);
+    const Eigen::VectorXd expected_grad =
+        barrier_potential.gradient(collisions, mesh, V);
+    const Eigen::SparseMatrix<double> expected_hess =
+        barrier_potential.hessian(collisions, mesh, V);
+
+    const auto workspace = std::make_shared<ipc::Workspace>();
+    broad_phase->workspace = workspace;
+    ipc::NormalCollisions reused_collisions;
+    reused_collisions.set_workspace(workspace);
+    ipc::BarrierPotential reused_barrier_potential(dhat);
+    reused_barrier_potential.set_workspace(workspace);
+
+    // Repeated steps reuse the same buffers and give the same results
+    for (int step = 0; step < 3; step++) {
+        reused_collisions.build(mesh, V, dhat, /*dmin=*/0, broad_phase);
+        CHECK(reused_collisions.size() == collisions.size());
+        CHECK(
+            reused_barrier_potential(reused_collisions, mesh, V)
+            == Catch::Approx(expected_energy));
+        CHECK(reused_barrier_potential.gradient(reused_collisions, mesh, V)
+                  .isApprox(expected_grad));
+        CHECK(reused_barrier_potential.hessian(reused_collisions, mesh, V)
+                  .isApprox(expected_hess));
+    }
+    CHECK(workspace->size() > 0);
+}
+
+TEST_CASE("Block sparse matrix", "[utils][bsr]")
+{
+    // 3×2 blocks of size 2 with a duplicate entry and an empty block row
+    std::vector<Eigen::Triplet<double>> triplets = {
+        { 0, 2, 1 }, { 1, 3, 2 }, { 0, 0, 3 }, { 0, 2, 4 }, { 5, 1, 5 },
+    };
+
+    ipc::BlockSparseMatrix A(6, 4, 2);
+    CHECK(A.num_blocks() == 0);
+    A.set_from_triplets(triplets);
+
+    CHECK(A.rows() == 6);
+    CHECK(A.cols() == 4);
+    CHECK(A.block_rows() == 3);
+    CHECK(A.block_cols() == 2);
+    CHECK(A.num_blocks() == 3);
+    CHECK(A.row_offsets() == std::vector<int> { 0, 2, 2, 3 });
+    CHECK(A.col_indices() == std::vector<int> { 0, 1, 0 });
+    CHECK(A.block(1)(0, 0) == 5); // Duplicates are summed
+    CHECK(A.block(1)(1, 1) == 2);
+
+    Eigen::SparseMatrix<double> expected(6, 4);
+    expected.setFromTriplets(triplets.begin(), triplets.end());
+
+    const Eigen::SparseMatrix<double, Eigen::RowMajor> csr = A.to_csr();
+    CHECK(csr.nonZeros() == 3 * 4); // Zeros inside blocks are kept
+    CHECK(Eigen::MatrixXd(csr) == Eigen::MatrixXd(expected));
+
+    const Eigen::VectorXd x = Eigen::VectorXd::Random(4);
+    CHECK((A * x).isApprox(expected * x));
+}